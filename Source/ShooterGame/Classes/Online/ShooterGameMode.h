@@ -98,6 +98,12 @@ protected:
 
 	bool bAllowBots;		
 
+	/** name of the demo this match is recorded to, empty if not recording */
+	FString DemoRecName;
+
+	/** weapons of dead pawns, reused on respawn */
+	TSharedPtr<class FShooterWeaponPool> WeaponPool;
+
 	/** spawning all bots for this game */
 	void StartBots();
 
@@ -132,6 +138,9 @@ public:
 	/** get the name of the bots count option used in server travel URL */
 	static FString GetBotsCountOptionName();
 
+	/** get weapon pool of this world */
+	class FShooterWeaponPool* GetWeaponPool() const { return WeaponPool.Get(); }
+
 	UPROPERTY()
 	TArray<class AShooterPickup*> LevelPickups;
 
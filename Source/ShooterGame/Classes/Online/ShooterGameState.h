@@ -2,8 +2,47 @@
 
 #include "ShooterGameState.generated.h"
 
-/** ranked PlayerState map, created from the GameState */
-typedef TMap<int32, TWeakObjectPtr<AShooterPlayerState> > RankedPlayerMap; 
+/** position of a player in the ranking */
+struct FShooterPlayerRank
+{
+	/** team the player is ranked in, INDEX_NONE if not on a team */
+	int32 TeamIndex;
+
+	/** index in the team's ranking, 0 is the highest score */
+	int32 Rank;
+
+	FShooterPlayerRank()
+		: TeamIndex(INDEX_NONE)
+		, Rank(INDEX_NONE)
+	{}
+
+	FShooterPlayerRank(int32 InTeamIndex, int32 InRank)
+		: TeamIndex(InTeamIndex)
+		, Rank(InRank)
+	{}
+};
+
+/** team colored instance of a character material */
+USTRUCT()
+struct FShooterTeamMaterial
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	UMaterialInterface* Parent;
+
+	UPROPERTY()
+	int32 TeamNum;
+
+	UPROPERTY()
+	UMaterialInstanceDynamic* MaterialInstance;
+
+	FShooterTeamMaterial()
+		: Parent(NULL)
+		, TeamNum(0)
+		, MaterialInstance(NULL)
+	{}
+};
 
 UCLASS()
 class AShooterGameState : public AGameState
@@ -28,8 +67,64 @@ public:
 	UPROPERTY(Transient, Replicated)
 	bool bTimerPaused;
 
-	/** gets ranked PlayerState map for specific team */
-	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
+	/** characters spawned before the game state got their default colors, fix them up */
+	virtual void PostInitializeComponents() override;
+
+	// Begin AGameState interface
+	virtual void AddPlayerState(class APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(class APlayerState* PlayerState) override;
+	// End AGameState interface
+
+	/** gets players of specific team ordered by score, highest first */
+	const TArray<AShooterPlayerState*>& GetRankedPlayers(int32 TeamIndex) const;
+
+	/** gets rank of player within their team (0 is the highest score), INDEX_NONE if not ranked */
+	int32 GetPlayerRank(const AShooterPlayerState* PlayerState) const;
+
+	/** gets number of teams with at least one player */
+	int32 GetNumRankedTeams() const { return NumRankedTeams; }
+
+	/** gets ranking version, changes every time any player's rank or team changes */
+	int32 GetRankingVersion() const { return RankingVersion; }
+
+	/** move player to their new position after score or team changed */
+	void UpdatePlayerRanking(AShooterPlayerState* PlayerState);
 
 	void RequestFinishAndExitToMainMenu();
+
+	/**
+	 * Gets material instance of Parent with team color set, shared by all characters of the team.
+	 * Created on first use.
+	 */
+	UMaterialInstanceDynamic* GetTeamMaterial(UMaterialInterface* Parent, int32 TeamNum);
+
+protected:
+
+	/** team colored material instances, one per material and team */
+	UPROPERTY(Transient)
+	TArray<FShooterTeamMaterial> TeamMaterials;
+
+	/** players of each team ordered by score */
+	TArray<TArray<AShooterPlayerState*> > TeamRankings;
+
+	/** team and rank of every player in PlayerArray */
+	TMap<const AShooterPlayerState*, FShooterPlayerRank> PlayerRanks;
+
+	/** cached number of teams with at least one player */
+	int32 NumRankedTeams;
+
+	/** incremented on every ranking change */
+	int32 RankingVersion;
+
+	/** remove player from their team's ranking, entry in PlayerRanks is kept */
+	void RemoveFromTeamRanking(const AShooterPlayerState* PlayerState);
+
+	/** insert player into their current team's ranking */
+	void InsertIntoTeamRanking(AShooterPlayerState* PlayerState);
+
+	/** refresh PlayerRanks of team starting at rank */
+	void ReindexTeamRanking(int32 TeamIndex, int32 FirstRank);
+
+	/** update cached counts and version after a ranking change */
+	void OnRankingChanged();
 };
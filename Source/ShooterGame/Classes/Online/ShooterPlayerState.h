@@ -21,6 +21,15 @@ class AShooterPlayerState : public APlayerState
 
 	virtual void UnregisterPlayerWithSession() override;
 
+	/** [client] keep ranking up to date */
+	virtual void OnRep_Score() override;
+
+	/** [profiling] tracks replicated property bandwidth */
+	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+
+	/** [profiling] measures bandwidth of RPCs sent by this actor */
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, FFrame* Stack) override;
+
 	// End APlayerState interface
 
 	/**
@@ -111,4 +120,7 @@ protected:
 
 	/** helper for scoring points */
 	void ScorePoints(int32 Points);
+
+	/** let game state know our score or team changed */
+	void UpdateRanking();
 };
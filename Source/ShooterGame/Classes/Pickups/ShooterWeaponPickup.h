@@ -20,6 +20,9 @@ public:
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+
+	/** returns the weapon to the pool if nobody took it */
+	virtual void Destroyed() override;
 	
 	// Called every frame
 	virtual void Tick( float DeltaSeconds ) override;
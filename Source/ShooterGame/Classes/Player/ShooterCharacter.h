@@ -1,6 +1,7 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterTypes.h"
+#include "ShooterInventory.h"
 #include "ShooterCharacter.generated.h"
 
 
@@ -9,6 +10,9 @@ class AShooterCharacter : public ACharacter
 {
 	GENERATED_UCLASS_BODY()
 
+	/** move weapon classes saved as hard references to their soft replacements */
+	virtual void PostLoad() override;
+
 	/** spawn inventory, setup initial variables */
 	virtual void PostInitializeComponents() override;
 
@@ -98,11 +102,10 @@ class AShooterCharacter : public ACharacter
 	 * ...or nothing, if nothing is there
 	 */
 
-	/**	Check if the player is pointing at an interactable object
+	/**	Check if the player is focused on an interactable object
 	 *	OutObject is an optional out parameter, which the function
-	 *	sets as the object the player is pointing at
-	 *	OutInteraction is also an out parameter, which contains
-	 *	the data for the hit result
+	 *	sets as the focused object. Reads the interaction component's
+	 *	cached focus, no trace is done here.
 	 */
 	bool CanInteract(AActor** OutObject = NULL) const;
 
@@ -296,6 +299,9 @@ class AShooterCharacter : public ACharacter
 	 */
 	class AShooterWeapon* GetInventoryWeapon(int32 index) const;
 
+	/** get inventory slot of weapon, slots stay stable while the weapon is held */
+	int32 GetInventorySlot(const class AShooterWeapon* Weapon) const;
+
 	/** get weapon taget modifier speed	*/
 	UFUNCTION(BlueprintCallable, Category="Game|Weapon")
 	float GetTargetingSpeedModifier() const;
@@ -336,8 +342,14 @@ class AShooterCharacter : public ACharacter
 	 */
 	USkeletalMeshComponent* GetSpecifcPawnMesh( bool WantFirstPerson ) const;
 
-	/** Update the team color of all player meshes. */
-	void UpdateTeamColorsAllMIDs();
+	/** Switch all player meshes to the shared material instances of the player's team. */
+	void UpdateTeamMaterials();
+
+	/** true if Actor skips cosmetic setup: it's on a dedicated server with shooter.ServerLean set */
+	static bool IsServerLean(const AActor* Actor);
+
+	/** add soft references of default inventory and extra weapons, for the preload manifest */
+	void GetWeaponAssets(TArray<FStringAssetReference>& OutAssets) const;
 
 
 	/** Get maximum inventory slots*/
@@ -361,12 +373,25 @@ class AShooterCharacter : public ACharacter
 
 	//bool bQuickFiring;
 
+	/** Get the aim of the camera */
+	FVector GetCameraAim() const;
+
+	/** get the originating location for camera damage */
+	FVector GetCameraStartLocation(const FVector& AimDir) const;
+
+	/** get range of interaction trace */
+	float GetInteractRange() const { return InteractRange; }
+
 private:
 
 	/** pawn mesh: 1st person view */
 	UPROPERTY(VisibleDefaultsOnly, Category=Mesh)
 	USkeletalMeshComponent* Mesh1P;
 
+	/** tracks the interactable object the player is focused on */
+	UPROPERTY(VisibleDefaultsOnly, Category=Interaction)
+	class UShooterInteractionComponent* InteractionComp;
+
 protected:
 
 	//John
@@ -392,15 +417,6 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
 	int32 DropWeaponVelocity;
 
-	/** Get the aim of the camera */
-	FVector GetCameraAim() const;
-
-	/** get the originating location for camera damage */
-	FVector GetCameraStartLocation(const FVector& AimDir) const;
-
-	/** get the interact hit */
-	FHitResult InteractTrace(const FVector& TraceFrom, const FVector& TraceTo) const;
-
 	/** socket or bone name for attaching weapon mesh */
 	UPROPERTY(EditDefaultsOnly, Category=Inventory)
 	FName WeaponAttachPoint;
@@ -409,26 +425,40 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Inventory)
 		FName WeaponHolsterPoint;
 
-	/** default inventory list */
+	/** default inventory list, soft references so weapons load with the map's preload manifest instead of with the pawn */
 	UPROPERTY(EditDefaultsOnly, Category=Inventory)
-	TArray<TSubclassOf<class AShooterWeapon> > DefaultInventoryClasses;
+	TArray<TAssetSubclassOf<class AShooterWeapon> > DefaultInventoryAssets;
+
+	/** default inventory saved before it became soft references, moved to DefaultInventoryAssets on load */
+	UPROPERTY()
+	TArray<TSubclassOf<class AShooterWeapon> > DefaultInventoryClasses_DEPRECATED;
 
 	/** weapons in inventory */
 	UPROPERTY(Transient, Replicated)
-	TArray<class AShooterWeapon*> Inventory;
+	FShooterInventory Inventory;
 
 	//John
 	/** Melee weapon*/
 	UPROPERTY(EditDefaultsOnly, Category=Inventory)
-		TSubclassOf<class AShooterWeapon> Melee;
+		TAssetSubclassOf<class AShooterWeapon> MeleeAsset;
 
 	/** Frag Grenade*/
 	UPROPERTY(EditDefaultsOnly, Category=Inventory)
-		TSubclassOf<class AShooterWeapon> FragGrenade;
+		TAssetSubclassOf<class AShooterWeapon> FragGrenadeAsset;
 
 	/** Sticky Grenade*/
 	UPROPERTY(EditDefaultsOnly, Category = Inventory)
-		TSubclassOf<class AShooterWeapon> StickyGrenade;
+		TAssetSubclassOf<class AShooterWeapon> StickyGrenadeAsset;
+
+	/** extra weapons saved before they became soft references, moved to the Asset properties on load */
+	UPROPERTY()
+	TSubclassOf<class AShooterWeapon> Melee_DEPRECATED;
+
+	UPROPERTY()
+	TSubclassOf<class AShooterWeapon> FragGrenade_DEPRECATED;
+
+	UPROPERTY()
+	TSubclassOf<class AShooterWeapon> StickyGrenade_DEPRECATED;
 
 	UPROPERTY(EditDefaultsOnly, Category = Inventory)
 	int32 MaxInventory;
@@ -457,6 +487,16 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
 	float InteractRange;
 
+	/** hit zones of the 3rd person mesh, built in defaults are used when not set */
+	UPROPERTY(EditDefaultsOnly, Category = Pawn)
+	class UShooterHitZones* HitZones;
+
+	/** hit zone entry for each physics body of the 3rd person mesh, resolved from HitZones on spawn */
+	TArray<uint8> HitZoneBodyTable;
+
+	/** get hit zones asset in use */
+	const class UShooterHitZones* GetHitZones() const;
+
 	/** modifier for max movement speed */
 	UPROPERTY(EditDefaultsOnly, Category=Pawn)
 	float RunningSpeedModifier;
@@ -486,9 +526,16 @@ protected:
 	/** Base lookup rate, in deg/sec. Other scaling may affect final lookup rate. */
 	float BaseLookUpRate;
 
-	/** material instances for setting team color in mesh (3rd person view) */
+	/** materials of the mesh before team colors were applied, one per slot (3rd person view) */
 	UPROPERTY(Transient)
-	TArray<UMaterialInstanceDynamic*> MeshMIDs;
+	TArray<UMaterialInterface*> MeshBaseMaterials;
+
+	/** material of the 1st person mesh before team colors were applied */
+	UPROPERTY(Transient)
+	UMaterialInterface* Mesh1PBaseMaterial;
+
+	/** cosmetic setup was skipped on spawn, see IsServerLean */
+	bool bServerLean;
 
 	/** animation played on death */
 	UPROPERTY(EditDefaultsOnly, Category=Animation)
@@ -541,9 +588,6 @@ protected:
 	/** handle mesh visibility and updates */
 	void UpdatePawnMeshes();
 
-	/** handle mesh colors on specified material instance */
-	void UpdateTeamColors(UMaterialInstanceDynamic* UseMID);
-
 	/** Responsible for cleaning up bodies on clients. */
 	virtual void TornOff();
 
@@ -624,6 +668,15 @@ public:
 	UFUNCTION(BluePrintCallable, Category=Pawn)
 		bool ShieldsDown();
 
+	/**
+	 * Classify hit on the character
+	 *
+	 * @param Hit					Hit to classify, only hits on the 3rd person mesh have a zone.
+	 * @param OutDamageMultiplier	Optional, set to damage scale of the hit body.
+	 * @returns hit zone, EShooterHitZone::None if the body isn't in the hit zone table
+	 */
+	EShooterHitZone::Type GetHitZone(const FHitResult& Hit, float* OutDamageMultiplier = NULL) const;
+
 	/** Set shields up*/
 	void SetShields(bool bShieldsUp);
 
@@ -661,6 +714,15 @@ public:
 	/** Called on the actor right before replication occurs */
 	virtual void PreReplication( IRepChangedPropertyTracker & ChangedPropertyTracker ) override;
 
+	/** [profiling] measures bandwidth of RPCs sent by this actor */
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, FFrame* Stack) override;
+
+	/** [server] raise priority for active characters, lower it for distant ones, per viewing connection */
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, class APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+	/** cleanup adaptive replication stats */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/*John*/
 	/*Health Regen*/
 
@@ -782,9 +844,72 @@ protected:
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerSetRunning(bool bNewRunning, bool bToggle);
 
+	//////////////////////////////////////////////////////////////////////////
+	// Adaptive replication
+
+	/** adjust NetUpdateFrequency to activity and distance from viewers */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	bool bAdaptiveNetUpdateFrequency;
+
+	/** update rate while firing, lunging, taking damage or close to a viewer, 0 uses NetUpdateFrequency */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, meta=(EditCondition="bAdaptiveNetUpdateFrequency"))
+	float MaxNetUpdateFrequency;
+
+	/** update rate when far away from every viewer */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, meta=(EditCondition="bAdaptiveNetUpdateFrequency"))
+	float MinNetUpdateFrequency;
+
+	/** update rate cap for characters that are standing still and not active */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, meta=(EditCondition="bAdaptiveNetUpdateFrequency"))
+	float IdleNetUpdateFrequency;
+
+	/** viewer distance below which the character uses MaxNetUpdateFrequency */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, meta=(EditCondition="bAdaptiveNetUpdateFrequency"))
+	float NearNetViewerDistance;
+
+	/** viewer distance above which the character uses MinNetUpdateFrequency, also lowers per connection priority */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, meta=(EditCondition="bAdaptiveNetUpdateFrequency"))
+	float FarNetViewerDistance;
+
+	/** how long firing, lunging or being hit keeps the character at full rate */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, meta=(EditCondition="bAdaptiveNetUpdateFrequency"))
+	float NetActivityHoldTime;
+
+	/** priority multiplier for active characters */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, meta=(EditCondition="bAdaptiveNetUpdateFrequency"))
+	float ActiveNetPriorityScale;
+
+	/** interval between update rate evaluations */
+	UPROPERTY(EditDefaultsOnly, Category=Replication, meta=(EditCondition="bAdaptiveNetUpdateFrequency"))
+	float NetUpdateFrequencyInterval;
+
+	/** last time the character fired, lunged or was hit */
+	float LastNetActivityTime;
+
+	/** last time NetUpdateFrequency was evaluated */
+	float LastNetUpdateFrequencyTime;
+
+	/** updates per second saved compared to MaxNetUpdateFrequency, as reported to stats */
+	float ReportedNetUpdatesSaved;
+
+	/** [server] mark the character as active for replication purposes */
+	void NotifyNetActivity();
+
+	/** [server] check if the character fired, lunged or was hit recently */
+	bool IsNetActive() const;
+
+	/** [server] pick NetUpdateFrequency from activity and closest viewer */
+	void UpdateNetUpdateFrequency();
+
+	/** [server] update average saved updates stat */
+	void ReportNetUpdatesSaved(float NewSaved);
+
 protected:
 	/** Returns Mesh1P subobject **/
 	FORCEINLINE USkeletalMeshComponent* GetMesh1P() const { return Mesh1P; }
+
+	/** Returns InteractionComp subobject **/
+	FORCEINLINE class UShooterInteractionComponent* GetInteractionComp() const { return InteractionComp; }
 };
 
 
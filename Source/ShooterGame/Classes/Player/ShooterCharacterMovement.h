@@ -13,5 +13,38 @@ class UShooterCharacterMovement : public UCharacterMovementComponent
 	GENERATED_UCLASS_BODY()
 
 	virtual float GetMaxSpeed() const override;
+
+	/**
+	 * Teleport character at the end of the current move.
+	 * Called from the same movement on the server and the owning client, so the client predicts
+	 * the teleport in its own frame and the server reaches the same position without a correction.
+	 *
+	 * @param Destination		Location to teleport to.
+	 * @param bKeepHeight		Use the character's height at the time of the teleport instead of Destination.Z.
+	 */
+	void QueueTeleport(const FVector& Destination, bool bKeepHeight);
+
+	/** get timestamp of the last applied teleport, in move time of the owning client */
+	float GetLastTeleportTimeStamp() const { return LastTeleportTimeStamp; }
+
+protected:
+
+	/** apply queued teleport */
+	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
+
+	/** get timestamp of the move being simulated, shared between server and owning client */
+	float GetCurrentMoveTimeStamp() const;
+
+	/** is teleport waiting for the end of the move? */
+	uint32 bPendingTeleport : 1;
+
+	/** keep character height for pending teleport */
+	uint32 bPendingTeleportKeepHeight : 1;
+
+	/** destination of pending teleport */
+	FVector PendingTeleportLocation;
+
+	/** move timestamp of the last teleport, only one teleport is applied per move */
+	float LastTeleportTimeStamp;
 };
 
@@ -13,12 +13,56 @@ public:
 
 	virtual void SetupInputComponent() override;
 	virtual void SetPlayer( UPlayer* Player ) override;
+	virtual void Tick( float DeltaSeconds ) override;
 
 	void OnToggleInGameMenu();
 	void OnIncreasePlaybackSpeed();
 	void OnDecreasePlaybackSpeed();
 	void OnPausePlayback();
 
+	/** seek to percentage of the demo */
+	UFUNCTION(exec)
+	void DemoSeek(float Percent);
+
+	/** measure time needed to seek to 25%, 50% and 90% of the demo, results are logged */
+	UFUNCTION(exec)
+	void DemoSeekBenchmark();
+
+	/** seek to demo time (seconds) */
+	void SeekToTime(float Time);
+
+	/** is seek in progress? */
+	bool IsSeeking() const { return bSeeking; }
+
+	/** get demo time seek is going to */
+	float GetSeekTargetTime() const { return SeekTargetTime; }
+
 	int32 PlaybackSpeed;
+
+protected:
+
+	/** demo time seek is going to */
+	float SeekTargetTime;
+
+	/** real time seek was requested */
+	double SeekStartTime;
+
+	/** is seek in progress? */
+	bool bSeeking;
+
+	/** demo fractions the benchmark seeks to, empty when not running */
+	TArray<float> BenchmarkFractions;
+
+	/** seek times of the benchmark so far (milliseconds) */
+	TArray<double> BenchmarkTimes;
+
+	/** called by demo driver when seek is done */
+	void OnSeekFinished();
+
+	/** give up on a seek the demo driver never finished, it doesn't report failed seeks */
+	void OnSeekTimedOut();
+
+	/** start next seek of the benchmark, or log results when done */
+	void NextBenchmarkSeek();
 };
 
@@ -0,0 +1,75 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "ShooterHitZones.generated.h"
+
+/** hit zone of a single physics body */
+USTRUCT()
+struct FShooterHitZoneBody
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** bone the physics body is attached to */
+	UPROPERTY(EditDefaultsOnly, Category=HitZone)
+	FName BoneName;
+
+	/** zone the body belongs to */
+	UPROPERTY(EditDefaultsOnly, Category=HitZone)
+	TEnumAsByte<EShooterHitZone::Type> Zone;
+
+	/** scale for point damage taken on this body */
+	UPROPERTY(EditDefaultsOnly, Category=HitZone)
+	float DamageMultiplier;
+
+	FShooterHitZoneBody()
+		: BoneName(NAME_None)
+		, Zone(EShooterHitZone::None)
+		, DamageMultiplier(1.0f)
+	{
+	}
+
+	FShooterHitZoneBody(FName InBoneName, EShooterHitZone::Type InZone)
+		: BoneName(InBoneName)
+		, Zone(InZone)
+		, DamageMultiplier(1.0f)
+	{
+	}
+};
+
+/**
+ * Maps physics bodies of a character to hit zones.
+ * Bone names are resolved once per physics asset into a table indexed by body index, the Item of
+ * a hit on a skeletal mesh, so classifying a hit doesn't touch any names.
+ */
+UCLASS(BlueprintType)
+class UShooterHitZones : public UDataAsset
+{
+	GENERATED_UCLASS_BODY()
+
+	/** zones of physics bodies, bodies that aren't listed have no zone */
+	UPROPERTY(EditDefaultsOnly, Category=HitZone)
+	TArray<FShooterHitZoneBody> Bodies;
+
+	/**
+	 * Get lookup table for physics asset, built on first use
+	 *
+	 * @param PhysicsAsset	Physics asset to resolve bone names on.
+	 * @returns for every body index of the asset, index into Bodies + 1 (0 when body has no zone)
+	 */
+	const TArray<uint8>& GetBodyTable(const class UPhysicsAsset* PhysicsAsset) const;
+
+	/** get zone entry from bone table value, NULL for bones without a zone */
+	const FShooterHitZoneBody* GetBody(uint8 TableValue) const
+	{
+		return (TableValue > 0 && Bodies.IsValidIndex(TableValue - 1)) ? &Bodies[TableValue - 1] : NULL;
+	}
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+
+	/** body tables of physics assets resolved so far */
+	mutable TMap<TWeakObjectPtr<class UPhysicsAsset>, TArray<uint8> > BodyTables;
+};
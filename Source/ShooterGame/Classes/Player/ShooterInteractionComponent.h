@@ -0,0 +1,82 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "ShooterInteractionComponent.generated.h"
+
+/**
+ * Keeps track of the interactable object the owning character is focused on.
+ *
+ * The aim trace is refreshed at RefreshInterval, or right away when the camera moved or turned past
+ * a threshold. Interactables the character stands on are collected from overlap events instead of
+ * being queried. Focus is only tracked for locally controlled characters; the server refreshes it
+ * once per interaction request of a remote player.
+ */
+UCLASS()
+class UShooterInteractionComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+	virtual void InitializeComponent() override;
+	virtual void UninitializeComponent() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+	/** get focused interactable, NULL if there is none */
+	AActor* GetFocusedActor() const { return FocusedActor.Get(); }
+
+	/** get hit of the aim trace that found the focused interactable, empty when it was found by overlap */
+	const FHitResult& GetFocusHit() const { return FocusHit; }
+
+	/** refresh focus if it's out of date: interval passed, camera moved or overlapping interactables changed */
+	void ConditionalRefreshFocus();
+
+	/** refresh focus right away */
+	void RefreshFocus();
+
+	/** tag of actors that can be interacted with */
+	static const FName InteractTag;
+
+protected:
+
+	/** how often focus is refreshed when the camera doesn't move (seconds) */
+	UPROPERTY(EditDefaultsOnly, Category=Interaction)
+	float RefreshInterval;
+
+	/** camera distance that triggers a refresh before RefreshInterval */
+	UPROPERTY(EditDefaultsOnly, Category=Interaction)
+	float CameraMoveThreshold;
+
+	/** camera rotation (degrees) that triggers a refresh before RefreshInterval */
+	UPROPERTY(EditDefaultsOnly, Category=Interaction)
+	float CameraTurnThreshold;
+
+	/** currently focused interactable */
+	TWeakObjectPtr<AActor> FocusedActor;
+
+	/** aim trace hit for the focused interactable */
+	FHitResult FocusHit;
+
+	/** interactables overlapping the owner, in order of arrival */
+	TArray<TWeakObjectPtr<AActor> > OverlapCandidates;
+
+	/** camera location of the last refresh */
+	FVector LastViewLocation;
+
+	/** camera direction of the last refresh */
+	FVector LastViewDirection;
+
+	/** world time of the last refresh */
+	float LastRefreshTime;
+
+	/** overlapping interactables changed since the last refresh */
+	uint32 bCandidatesDirty : 1;
+
+	/** [local + server] can focus be tracked for owner? Only player controlled pawns interact. */
+	bool CanTrackFocus() const;
+
+	/** overlap event handlers of the owner */
+	UFUNCTION()
+	void OnOwnerBeginOverlap(AActor* OtherActor);
+
+	UFUNCTION()
+	void OnOwnerEndOverlap(AActor* OtherActor);
+};
@@ -0,0 +1,151 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ShooterInventory.generated.h"
+
+/** single replicated inventory entry */
+USTRUCT()
+struct FShooterInventoryItem : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** weapon held in this entry */
+	UPROPERTY()
+	class AShooterWeapon* Weapon;
+
+	/** slot assigned when the weapon entered the inventory, stable until it leaves */
+	UPROPERTY()
+	uint8 SlotIndex;
+
+	/** cached AShooterWeapon::IsExtraWeapon, so counts don't depend on the weapon reference being resolved */
+	UPROPERTY()
+	uint8 bExtraWeapon : 1;
+
+	/** weapon this entry is currently indexed under (local only, tracks late resolving references on clients) */
+	TWeakObjectPtr<class AShooterWeapon> IndexedWeapon;
+
+	FShooterInventoryItem()
+		: Weapon(NULL)
+		, SlotIndex(0)
+		, bExtraWeapon(false)
+	{}
+
+	/** [client] fast array callbacks */
+	void PreReplicatedRemove(const struct FShooterInventory& InArraySerializer);
+	void PostReplicatedAdd(const struct FShooterInventory& InArraySerializer);
+	void PostReplicatedChange(const struct FShooterInventory& InArraySerializer);
+};
+
+/**
+ * Delta replicated weapon inventory.
+ * Only added/removed/changed entries are sent, and the local lookup tables (slots, per class, counts)
+ * are maintained from the per item callbacks instead of being recomputed on every query.
+ * The lookups are not seen by GC, so they hold weak pointers: a weapon destroyed while still in the
+ * inventory (client side destroy, level change) reads as an empty slot instead of a dangling one.
+ */
+USTRUCT()
+struct FShooterInventory : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	FShooterInventory()
+		: NumPrimaryWeapons(0)
+		, NumExtraWeapons(0)
+	{}
+
+	/**
+	 * [server] add weapon to inventory
+	 *
+	 * @param Weapon	Weapon to add.
+	 * @returns slot assigned to the weapon, or INDEX_NONE if it was already in the inventory
+	 */
+	int32 Add(class AShooterWeapon* Weapon);
+
+	/**
+	 * [server] remove weapon from inventory
+	 *
+	 * @param Weapon	Weapon to remove.
+	 * @returns true if the weapon was in the inventory
+	 */
+	bool Remove(class AShooterWeapon* Weapon);
+
+	/** find weapon of given class (or subclass of it) */
+	class AShooterWeapon* Find(UClass* WeaponClass) const;
+
+	/** check if weapon is in the inventory */
+	bool Contains(const class AShooterWeapon* Weapon) const;
+
+	/** get number of entries */
+	int32 Num() const { return Items.Num(); }
+
+	/** get weapon at entry index. Index validity is not checked, entry order is not stable across the network. */
+	class AShooterWeapon* GetWeapon(int32 Index) const { return Items[Index].Weapon; }
+
+	/** get number of slots, including empty ones */
+	int32 GetNumSlots() const { return SlotWeapons.Num(); }
+
+	/** get weapon in slot, NULL if slot is empty */
+	class AShooterWeapon* GetWeaponInSlot(int32 Slot) const;
+
+	/** get slot of weapon, INDEX_NONE if not in inventory */
+	int32 GetSlotIndex(const class AShooterWeapon* Weapon) const;
+
+	/** get number of weapons that are not extra weapons */
+	int32 GetNumPrimaryWeapons() const { return NumPrimaryWeapons; }
+
+	/** get number of extra weapons (grenades, melee) */
+	int32 GetNumExtraWeapons() const { return NumExtraWeapons; }
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FShooterInventoryItem>(Items, DeltaParms);
+	}
+
+private:
+
+	friend struct FShooterInventoryItem;
+
+	/** replicated entries */
+	UPROPERTY()
+	TArray<FShooterInventoryItem> Items;
+
+	/** weapons by slot index, empty slots are NULL */
+	TArray<TWeakObjectPtr<class AShooterWeapon> > SlotWeapons;
+
+	/** weapons by class, registered under every class from the weapon's own up to AShooterWeapon */
+	TMap<UClass*, TWeakObjectPtr<class AShooterWeapon> > WeaponsByClass;
+
+	/** cached count of non extra weapons */
+	int32 NumPrimaryWeapons;
+
+	/** cached count of extra weapons */
+	int32 NumExtraWeapons;
+
+	/** update lookups for new entry */
+	void OnItemAdded(FShooterInventoryItem& Item);
+
+	/** update lookups for entry about to be removed */
+	void OnItemRemoved(FShooterInventoryItem& Item);
+
+	/** update lookups for entry that changed (weapon reference resolved on client) */
+	void OnItemChanged(FShooterInventoryItem& Item);
+
+	/** add weapon to slot and class lookups */
+	void IndexWeapon(FShooterInventoryItem& Item);
+
+	/** remove weapon from slot and class lookups */
+	void UnindexWeapon(FShooterInventoryItem& Item);
+
+	/** find lowest unused slot */
+	int32 FindFreeSlot() const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterInventory> : public TStructOpsTypeTraitsBase
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -12,9 +12,16 @@ public:
 	/** Loads user persistence data if it exists, creates an empty record otherwise. */
 	static UShooterPersistentUser* LoadPersistentUser(FString SlotName, const int32 UserIndex);
 
-	/** Saves data if anything has changed. */
+	/** Saves data if anything has changed. Saves are coalesced, and written on a background thread on desktop platforms. */
 	void SaveIfDirty();
 
+	/** Writes saves that are still queued and waits for them, called on shutdown. */
+	static void FlushPendingSaves();
+
+	// Begin UObject interface
+	virtual void BeginDestroy() override;
+	// End UObject interface
+
 	/** Records the result of a match. */
 	void AddMatchResult(int32 MatchKills, int32 MatchDeaths, int32 MatchBulletsFired, int32 MatchRocketsFired, bool bIsMatchWinner);
 
@@ -106,9 +113,15 @@ protected:
 	/** Checks if the Inverted Mouse user setting is different from current */
 	bool IsInvertedYAxisDirty() const;
 
-	/** Triggers a save of this data. */
+	/** Triggers a save of this data, written at most once per shooter.PersistentUserSaveInterval. */
 	void SavePersistentUser();
 
+	/** [ticker] the save interval has passed */
+	bool HandleSaveTicker(float DeltaTime);
+
+	/** serialize data and hand it to the writer thread, which passes it to the platform save game system */
+	void WriteSnapshot();
+
 	/** Lifetime count of kills */
 	UPROPERTY()
 	int32 Kills;
@@ -160,4 +173,7 @@ private:
 	/** The string identifier used to save/load this persistent user. */
 	FString SlotName;
 	int32 UserIndex;
+
+	/** Ticker writing the next snapshot, valid while a save is scheduled. */
+	FDelegateHandle SaveTickerHandle;
 };
\ No newline at end of file
@@ -36,6 +36,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Input")
 	void SimulateInputKey(FKey Key, bool bPressed = true);
 
+	/** [profiling] measures bandwidth of RPCs sent by this controller */
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, FFrame* Stack) override;
+
 	/** sends cheat message */
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerCheat(const FString& Msg);
@@ -191,6 +194,20 @@ protected:
 	UPROPERTY(Transient, Replicated)
 	uint8 bGodMode : 1;
 
+	/** [server] chat messages a player can send in a burst */
+	UPROPERTY(EditDefaultsOnly, Category=Chat)
+	float ChatBurstSize;
+
+	/** [server] chat messages regained per second after a burst */
+	UPROPERTY(EditDefaultsOnly, Category=Chat)
+	float ChatMessagesPerSecond;
+
+	/** [server] chat messages left before further ones are dropped */
+	float ChatAllowance;
+
+	/** [server] real time ChatAllowance was last updated */
+	float LastChatTime;
+
 	/** if set, gameplay related actions (movement, weapn usage, etc) are allowed */
 	uint8 bAllowGameActions : 1;
 
@@ -216,6 +233,9 @@ protected:
 
 	virtual void BeginPlay() override;
 
+	/** tells the game instance when the local player gets a pawn */
+	virtual void SetPawn(APawn* InPawn) override;
+
 	virtual void TickActor(float DeltaTime, enum ELevelTick TickType, FActorTickFunction& ThisTickFunction) override;
 	//End AActor interface
 
@@ -256,22 +276,13 @@ protected:
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerSuicide();
 
-	/** Updates achievements based on the PersistentUser stats at the end of a round */
-	void UpdateAchievementsOnGameEnd();
-
-	/** Updates leaderboard stats at the end of a round */
-	void UpdateLeaderboardsOnGameEnd();
-
-	/** Updates the save file at the end of a round */
-	void UpdateSaveFileOnGameEnd(bool bIsWinner);
+	/** Queues the results of a round for the save file, achievements and leaderboards */
+	void SubmitMatchResult(bool bIsWinner);
 
 	// End APlayerController interface
 
 	FName	ServerSayString;
 
-	// Timer used for updating friends in the player tick.
-	float ShooterFriendUpdateTimer;
-
 	// For tracking whether or not to send the end event
 	bool bHasSentStartEvents;
 
@@ -128,6 +128,18 @@ public:
 	/** Sets the online mode of the game */
 	void SetIsOnline(bool bInIsOnline);
 
+	/** Returns the end of match stats pipeline */
+	class FShooterMatchStats* GetMatchStats() const { return MatchStats.Get(); }
+
+	/** Returns the friends lists of local users, shared by the menus */
+	class FShooterFriendsCache* GetFriendsCache() const { return FriendsCache.Get(); }
+
+	/** Returns the timeline of states, map loads and session operations */
+	class FShooterTimeline* GetTimeline() const { return Timeline.Get(); }
+
+	/** Called when a local player controller gets a pawn, marks the first one of each map on the timeline */
+	void OnLocalPawnPossessed();
+
 	/** Adds the local (splitscreen) players to the party */
 	void AddPlayersToParty();
 
@@ -187,9 +199,36 @@ private:
 	/** If true, enable splitscreen when map starts loading */
 	bool bPendingEnableSplitscreen;
 
+	/** If true, hide the loading screen once the preload manifest of the map is loaded */
+	bool bPendingHideLoadingScreen;
+
+	/** Loads weapons of the map while the loading screen is up */
+	TSharedPtr<class FShooterPreloadManifest> PreloadManifest;
+
+	/** Hands end of match results to the save file, achievements and leaderboards */
+	TSharedPtr<class FShooterMatchStats> MatchStats;
+
+	/** Friends lists of local users */
+	TSharedPtr<class FShooterFriendsCache> FriendsCache;
+
 	/** Whether the user has an active license to play the game */
 	bool bIsLicensed;
 
+	/** Startup milestones, logged once the first state has been up for a frame */
+	double InitStartTime;
+	double InitEndTime;
+	double StartGameInstanceTime;
+	double FirstStateTime;
+
+	/** If true, the startup milestones haven't been logged yet */
+	bool bLogStartupTiming;
+
+	/** Records states, map loads and session operations */
+	TSharedPtr<class FShooterTimeline> Timeline;
+
+	/** If true, a local player controller got a pawn since the map was loaded */
+	bool bPawnPossessedSinceMapLoad;
+
 	/** Main menu UI */
 	TSharedPtr<class FShooterMainMenu> MainMenuUI;
 
@@ -341,6 +380,9 @@ private:
 	// Handle confirming the controller disconnected dialog.
 	FReply OnControllerReconnectConfirm();	
 
+	// Logs how long the startup milestones took.
+	void LogStartupTiming() const;
+
 protected:
 	bool HandleOpenCommand(const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld);
 };
@@ -14,9 +14,6 @@ public:
 	// Sets default values for this actor's properties
 	AShooterTeleporter(const FObjectInitializer& ObjectInitializer);
 
-	/** spawn inventory, setup initial variables */
-	virtual void PostInitializeComponents() override;
-
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 	
@@ -28,20 +25,12 @@ public:
 	UPROPERTY(EditInstanceOnly, Category = Teleporter)
 	AShooterTeleporter* TpTo;
 
-	void SendTeleport(AShooterCharacter* Pawn);
-
-	UFUNCTION(server, reliable, WithValidation)
-	void ServerSendTeleport(AShooterCharacter* Pawn);
-
-	void ReceiveTeleport(AShooterCharacter* Pawn, AShooterTeleporter* TpFrom);
-
-	UFUNCTION(server, reliable, WithValidation)
-	void ServerReceiveTeleport(AShooterCharacter* Pawn, AShooterTeleporter* TpFrom);
-
-	bool bTeleporting;
+	/** get world location characters arriving at this teleporter are moved to */
+	FVector GetExitLocation() const;
 
 protected:
 
+	/** exit location, relative to the teleporter */
 	UPROPERTY(EditInstanceOnly, Category = Teleporter)
 	FVector TpExitVector;
 
@@ -41,6 +41,20 @@ namespace EShooterHudPosition
 	};
 }
 
+/** character body areas with their own damage rules, see UShooterHitZones */
+UENUM()
+namespace EShooterHitZone
+{
+	enum Type
+	{
+		None,
+		Head,
+		Torso,
+		Back,
+		Limbs,
+	};
+}
+
 /** keep in sync with ShooterImpactEffect */
 UENUM()
 namespace EShooterPhysMaterialType
@@ -56,6 +56,108 @@ struct FDeathMessage
 	}
 };
 
+/** tile queued for drawing, same as UCanvas::DrawTile with explicit color */
+struct FShooterHUDTile
+{
+	/** Texture to draw, NULL for a solid tile. */
+	UTexture* Texture;
+
+	/** Screen position. */
+	FVector2D Position;
+
+	/** Screen size. */
+	FVector2D Size;
+
+	/** Texture coordinates. */
+	FVector2D UV0;
+	FVector2D UV1;
+
+	/** Tint. */
+	FLinearColor Color;
+};
+
+/** shadowed text queued for drawing */
+struct FShooterHUDText
+{
+	/** Text to draw. */
+	FText Text;
+
+	/** Font to draw with. */
+	UFont* Font;
+
+	/** Screen position. */
+	FVector2D Position;
+
+	/** Font scale. */
+	float Scale;
+
+	/** Text color. */
+	FLinearColor Color;
+};
+
+/**
+ * Tiles and texts of a HUD frame or element.
+ * All tiles are submitted before all texts, so consecutive tiles sharing a texture end up in one canvas batch.
+ */
+struct FShooterHUDDrawList
+{
+	TArray<FShooterHUDTile> Tiles;
+	TArray<FShooterHUDText> Texts;
+
+	void Reset()
+	{
+		Tiles.Reset();
+		Texts.Reset();
+	}
+
+	void Append(const FShooterHUDDrawList& Other)
+	{
+		Tiles.Append(Other.Tiles);
+		Texts.Append(Other.Texts);
+	}
+};
+
+/** retained HUD element, its draw list (and measured text) is rebuilt only when the values it displays change */
+struct FShooterHUDElement
+{
+	/** Cached draw list. */
+	FShooterHUDDrawList DrawList;
+
+	/** Layout version the draw list was built for. */
+	int32 LayoutVersion;
+
+	/** Displayed values the draw list was built for. */
+	int64 KeyA;
+	int64 KeyB;
+
+	FShooterHUDElement()
+		: LayoutVersion(INDEX_NONE)
+		, KeyA(0)
+		, KeyB(0)
+	{
+	}
+
+	/** 
+	 * Check if element has to be rebuilt, and if so reset its draw list and remember the new values.
+	 *
+	 * @param	InLayoutVersion		Current HUD layout (canvas size and scale) version.
+	 * @param	InKeyA, InKeyB		Values displayed by the element.
+	 */
+	bool NeedsRebuild(int32 InLayoutVersion, int64 InKeyA, int64 InKeyB = 0)
+	{
+		if (LayoutVersion == InLayoutVersion && KeyA == InKeyA && KeyB == InKeyB)
+		{
+			return false;
+		}
+
+		LayoutVersion = InLayoutVersion;
+		KeyA = InKeyA;
+		KeyB = InKeyB;
+		DrawList.Reset();
+		return true;
+	}
+};
+
 UCLASS()
 class AShooterHUD : public AHUD
 {
@@ -136,8 +238,9 @@ public:
 	 *
 	 * @param	ChatString	The string to add.
 	 * @param	bWantFocus	Should we set the chat window to focus
+	 * @param	SenderName	Name of the player that said it, if any
 	 */
-	void AddChatLine(const FString& ChatString, bool bWantFocus);
+	void AddChatLine(const FString& ChatString, bool bWantFocus, FName SenderName = NAME_None);
 
 	/* Is the match over (IE Is the state Won or Lost). */
 	bool IsMatchOver() const;
@@ -251,6 +354,43 @@ protected:
 	/** Offsets to display hit indicator parts. */
 	FVector2D Offsets[8];
 
+	/** Size of CenteredKillMessage, negative when it has to be measured again. */
+	FVector2D CenteredKillMessageSize;
+
+	/** Everything drawn this frame, submitted at the end of DrawHUD. */
+	FShooterHUDDrawList FrameDrawList;
+
+	/** Canvas clip size, origin and ScaleUI the retained elements were laid out for. */
+	FVector4 LastCanvasLayout;
+	float LastScaleUI;
+
+	/** Incremented whenever canvas layout changes, invalidates all retained elements. */
+	int32 LayoutVersion;
+
+	/** Incremented on every new death message. */
+	int32 DeathMessagesVersion;
+
+	/** Cached warmup countdown info text and its value. */
+	FText WarmupInfoText;
+	int32 WarmupInfoSeconds;
+
+	/** Object the interact prompt texts were measured for, its name and the measured sizes. */
+	TWeakObjectPtr<AActor> InteractTextObject;
+	FText InteractText;
+	FVector2D InteractTextSize;
+	FVector2D InteractAmmoTextSize;
+
+	/** Retained HUD elements. */
+	FShooterHUDElement NetModeElement;
+	FShooterHUDElement TimerElement;
+	FShooterHUDElement PlaceElement;
+	FShooterHUDElement KillsElement;
+	FShooterHUDElement HealthElement;
+	FShooterHUDElement PrimaryWeaponElement;
+	FShooterHUDElement SecondaryWeaponElement;
+	FShooterHUDElement InteractElement;
+	FShooterHUDElement DeathMessagesElement;
+
 	/** Texture for hit indicator. */
 	UPROPERTY()
 	UTexture2D* HitNotifyTexture;
@@ -351,12 +491,34 @@ protected:
 	 */
 	float DrawRecentlyKilledPlayer();
 
-	/** Temporary helper for drawing text-in-a-box. */
-	void DrawDebugInfoString(const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor);
+	/** Temporary helper for drawing text-in-a-box, queued into DrawList. */
+	void DrawDebugInfoString(FShooterHUDDrawList& DrawList, const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor);
 
 	/** helper for getting uv coords in normalized top,left, bottom, right format */
 	void MakeUV(FCanvasIcon& Icon, FVector2D& UV0, FVector2D& UV1, uint16 U, uint16 V, uint16 UL, uint16 VL);
 
+	/** bump layout version if canvas size or scale changed since last frame */
+	void UpdateLayoutVersion();
+
+	/** queue icon, same as UCanvas::DrawIcon / DrawScaledIcon */
+	void AddIcon(FShooterHUDDrawList& DrawList, const FCanvasIcon& Icon, float X, float Y, float Scale, const FLinearColor& Color) const;
+	void AddScaledIcon(FShooterHUDDrawList& DrawList, const FCanvasIcon& Icon, float X, float Y, const FVector2D& Scale, const FLinearColor& Color) const;
+
+	/** queue part of icon, stretched to given size */
+	void AddIconPart(FShooterHUDDrawList& DrawList, const FCanvasIcon& Icon, const FVector2D& Position, const FVector2D& Size, float U, float V, float UL, float VL, const FLinearColor& Color) const;
+
+	/** queue shadowed text */
+	void AddText(FShooterHUDDrawList& DrawList, UFont* Font, const FText& Text, float X, float Y, float Scale, const FLinearColor& Color) const;
+
+	/** get unscaled size of text */
+	FVector2D MeasureText(UFont* Font, const FText& Text) const;
+
+	/** queue element's cached draw list for this frame */
+	void AddElement(const FShooterHUDElement& Element);
+
+	/** draw and reset frame draw list */
+	void FlushFrameDrawList();
+
 	/*
 	 * Create the chat widget if it doesn't already exist.
 	 *
@@ -4,6 +4,53 @@
 
 #include "ShooterProjectile.generated.h"
 
+/** replicated attachment of a stuck projectile */
+USTRUCT()
+struct FShooterStuckInfo
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** actor the projectile is stuck to */
+	UPROPERTY()
+	AActor* AttachActor;
+
+	/** component of the actor the projectile is stuck to, NULL if it can't be referenced over the network */
+	UPROPERTY()
+	USceneComponent* AttachComponent;
+
+	/** bone of the actor's skeletal mesh, INDEX_NONE when stuck to the root component */
+	UPROPERTY()
+	int32 BoneIndex;
+
+	/** location relative to the bone or attach component */
+	UPROPERTY()
+	FVector RelativeLocation;
+
+	/** rotation relative to the bone or attach component */
+	UPROPERTY()
+	FRotator RelativeRotation;
+
+	FShooterStuckInfo()
+		: AttachActor(NULL)
+		, AttachComponent(NULL)
+		, BoneIndex(INDEX_NONE)
+		, RelativeLocation(ForceInit)
+		, RelativeRotation(ForceInit)
+	{}
+
+	/** packs bone index, quantized location and compressed rotation */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterStuckInfo> : public TStructOpsTypeTraitsBase
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
 // 
 UCLASS(Abstract, Blueprintable)
 class AShooterProjectile : public AActor
@@ -27,6 +74,12 @@ class AShooterProjectile : public AActor
 	/** Get whether or not this projectile is stuck */
 	bool IsStuck();
 
+	/** [profiling] tracks replicated property bandwidth */
+	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+
+	/** [profiling] measures bandwidth of RPCs sent by this actor */
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, FFrame* Stack) override;
+
 private:
 	/** movement component */
 	UPROPERTY(VisibleDefaultsOnly, Category=Projectile)
@@ -100,12 +153,26 @@ protected:
 	virtual void ReceiveHit(UPrimitiveComponent * MyComp, AActor * Other, UPrimitiveComponent * OtherComp,
 		bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult & Hit) override;
 
-	UFUNCTION(Client, Reliable)
-		void ClientStick(UPrimitiveComponent * MyComp, UPrimitiveComponent * OtherComp, bool bSelfMoved, FHitResult const & Hit);
-
-	/** Sticks this projectile to the target*/
+	/** Sticks this projectile to the target, server also replicates the attachment through StuckInfo */
 	void Stick(UPrimitiveComponent * MyComp, UPrimitiveComponent * OtherComp, bool bSelfMoved, FHitResult const & Hit);
 
+	/** stop movement and attach to component */
+	void AttachStuck(USceneComponent* Parent, FName BoneName, EAttachLocation::Type AttachType);
+
+	/**
+	 * get component a projectile stuck to actor attaches to: the hit component if it belongs to the actor,
+	 * otherwise the skeletal mesh when stuck to a bone and the root component when not
+	 */
+	USceneComponent* GetStuckParent(AActor* Actor, USceneComponent* HitComponent, int32 BoneIndex) const;
+
+	/** [client] stuck state replicated */
+	UFUNCTION()
+	void OnRep_StuckInfo();
+
+	/** where this projectile is stuck */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_StuckInfo)
+	FShooterStuckInfo StuckInfo;
+
 	/** The actor this projectile is stuck to */
 	AActor* StuckActor;
 	
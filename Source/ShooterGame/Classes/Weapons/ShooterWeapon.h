@@ -196,8 +196,17 @@ class AShooterWeapon : public AActor
 		/** perform initial setup */
 		virtual void PostInitializeComponents() override;
 
+	/** move a pickup class saved as hard reference to WeaponPickupAsset */
+	virtual void PostLoad() override;
+
 	virtual void Destroyed() override;
 
+	/** [profiling] tracks replicated property bandwidth */
+	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+
+	/** [profiling] measures bandwidth of RPCs sent by this actor */
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, FFrame* Stack) override;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Ammo
 
@@ -245,6 +254,12 @@ class AShooterWeapon : public AActor
 	/** [server] weapon was removed from pawn's inventory */
 	virtual void OnLeaveInventory();
 
+	/** [server] weapon was parked in the weapon pool, stop everything it's doing */
+	virtual void OnReturnedToPool();
+
+	/** [server] weapon was taken from the weapon pool, restore the state it was spawned with */
+	virtual void OnTakenFromPool();
+
 	/** check if it's currently equipped */
 	bool IsEquipped() const;
 
@@ -435,7 +450,14 @@ class AShooterWeapon : public AActor
 	*/
 
 	UPROPERTY(EditDefaultsOnly, Category = Pickup)
-	TSubclassOf<class AShooterWeaponPickup> WeaponPickup;
+	TAssetSubclassOf<class AShooterWeaponPickup> WeaponPickupAsset;
+
+	/** pickup class saved before it became a soft reference, moved to WeaponPickupAsset on load */
+	UPROPERTY()
+	TSubclassOf<class AShooterWeaponPickup> WeaponPickup_DEPRECATED;
+
+	/** get pickup class, loads it if the preload manifest didn't */
+	UClass* GetWeaponPickupClass() const;
 
 	/**	Given a shooter weapon pickup, set this weapon's properties to match the pickup*/
 	void SetWeaponProperties(AShooterWeaponPickup* WeaponPickup);
@@ -579,6 +601,9 @@ protected:
 	/** is equip animation playing? */
 	uint32 bPendingEquip : 1;
 
+	/** cosmetic setup, effects, sounds and animations are skipped, see AShooterCharacter::IsServerLean */
+	uint32 bServerLean : 1;
+
 	/** weapon is refiring */
 	uint32 bRefiring;
 
@@ -736,6 +761,9 @@ protected:
 	/** detaches weapon mesh from pawn */
 	void DetachMeshFromPawn();
 
+	/** fill clip and ammo to initial amounts */
+	void InitAmmo();
+
 	UFUNCTION(Reliable, Client)
 	void ClientDetachMeshFromPawn();
 
@@ -4,6 +4,7 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "ShooterStats.h"
 
 UBTDecorator_HasLoSTo::UBTDecorator_HasLoSTo(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -115,6 +116,7 @@ bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, cons
 			const FVector StartLocation = MyBot->GetActorLocation();
 			FHitResult Hit(ForceInit);
 			GetWorld()->LineTraceSingle(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
+			SHOOTER_INC_COUNTER(Traces);
 			if (Hit.bBlockingHit == true)
 			{
 				// We hit something. If we have an actor supplied, just check if the hit actor is an enemy. If it is consider that 'has LOS'
@@ -6,6 +6,7 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "ShooterStats.h"
 
 AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -55,6 +56,8 @@ void AShooterAIController::Respawn()
 
 void AShooterAIController::FindClosestEnemy()
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(AIFindEnemy);
+
 	APawn* MyBot = GetPawn();
 	if (MyBot == NULL)
 	{
@@ -87,6 +90,8 @@ void AShooterAIController::FindClosestEnemy()
 
 bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEnemy)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(AIFindEnemy);
+
 	bool bGotEnemy = false;
 	APawn* MyBot = GetPawn();
 	if (MyBot != NULL)
@@ -122,6 +127,8 @@ bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEne
 
 bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(AIWeaponLOS);
+
 	static FName LosTag = FName(TEXT("AIWeaponLosTrace"));
 	
 	AShooterBot* MyBot = Cast<AShooterBot>(GetPawn());
@@ -138,6 +145,7 @@ bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool
 	FHitResult Hit(ForceInit);
 	const FVector EndLocation = InEnemyActor->GetActorLocation();
 	GetWorld()->LineTraceSingle(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
+	SHOOTER_INC_COUNTER(Traces);
 	if (Hit.bBlockingHit == true)
 	{
 		// Theres a blocking hit - check if its our enemy actor
@@ -0,0 +1,261 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterFriendsCache.h"
+#include "Online.h"
+
+float GShooterFriendsCacheTTL = 300.0f;
+static FAutoConsoleVariableRef CVarShooterFriendsCacheTTL(
+	TEXT("shooter.FriendsCacheTTL"),
+	GShooterFriendsCacheTTL,
+	TEXT("Seconds after which a cached friends list is read again when a menu asks for it.\n")
+	TEXT("Changes reported by the online subsystem are applied as they happen.\n")
+	TEXT("Default is 300."),
+	ECVF_Default
+	);
+
+float GShooterFriendsCacheMinReadInterval = 4.0f;
+static FAutoConsoleVariableRef CVarShooterFriendsCacheMinReadInterval(
+	TEXT("shooter.FriendsCacheMinReadInterval"),
+	GShooterFriendsCacheMinReadInterval,
+	TEXT("Minimum seconds between reads of a friends list, reads requested earlier are delayed.\n")
+	TEXT("Keeps requests below the rate limit of platform web APIs (0x80552C81 on Xbox One).\n")
+	TEXT("Default is 4."),
+	ECVF_Default
+	);
+
+static const FString FriendsListName = EFriendsLists::ToString(EFriendsLists::OnlinePlayers);
+
+FShooterFriendsCache::FShooterFriendsCache()
+{
+}
+
+FShooterFriendsCache::~FShooterFriendsCache()
+{
+	IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInt = OnlineSub ? OnlineSub->GetFriendsInterface() : NULL;
+	IOnlinePresencePtr PresenceInt = OnlineSub ? OnlineSub->GetPresenceInterface() : NULL;
+
+	for (TMap<int32, FUserFriends>::TIterator It(Users); It; ++It)
+	{
+		if (FriendsInt.IsValid())
+		{
+			FriendsInt->ClearOnFriendsChangeDelegate_Handle(It.Key(), It.Value().FriendsChangeHandle);
+		}
+		if (It.Value().ReadTickerHandle.IsValid())
+		{
+			FTicker::GetCoreTicker().RemoveTicker(It.Value().ReadTickerHandle);
+		}
+	}
+
+	if (PresenceInt.IsValid())
+	{
+		PresenceInt->ClearOnPresenceReceivedDelegate_Handle(PresenceReceivedHandle);
+	}
+}
+
+void FShooterFriendsCache::Init()
+{
+	IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
+	IOnlinePresencePtr PresenceInt = OnlineSub ? OnlineSub->GetPresenceInterface() : NULL;
+	if (PresenceInt.IsValid())
+	{
+		PresenceReceivedHandle = PresenceInt->AddOnPresenceReceivedDelegate_Handle(FOnPresenceReceivedDelegate::CreateSP(this, &FShooterFriendsCache::OnPresenceReceived));
+	}
+}
+
+FShooterFriendsCache::FUserFriends& FShooterFriendsCache::GetUser(int32 LocalUserNum)
+{
+	FUserFriends* User = Users.Find(LocalUserNum);
+	if (User == NULL)
+	{
+		User = &Users.Add(LocalUserNum, FUserFriends());
+
+		IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
+		IOnlineFriendsPtr FriendsInt = OnlineSub ? OnlineSub->GetFriendsInterface() : NULL;
+		if (FriendsInt.IsValid())
+		{
+			User->FriendsChangeHandle = FriendsInt->AddOnFriendsChangeDelegate_Handle(LocalUserNum, FOnFriendsChangeDelegate::CreateSP(this, &FShooterFriendsCache::OnFriendsChange, LocalUserNum));
+		}
+	}
+	return *User;
+}
+
+void FShooterFriendsCache::RequestFriends(int32 LocalUserNum)
+{
+	if (LocalUserNum < 0)
+	{
+		return;
+	}
+
+	const FUserFriends& User = GetUser(LocalUserNum);
+	if (User.LastReadTime <= 0.0 || FPlatformTime::Seconds() - User.LastReadTime >= GShooterFriendsCacheTTL)
+	{
+		ReadFriendsList(LocalUserNum);
+	}
+}
+
+void FShooterFriendsCache::Refresh(int32 LocalUserNum)
+{
+	if (LocalUserNum >= 0)
+	{
+		ReadFriendsList(LocalUserNum);
+	}
+}
+
+const TArray< TSharedRef<FOnlineFriend> >& FShooterFriendsCache::GetFriends(int32 LocalUserNum) const
+{
+	const FUserFriends* User = Users.Find(LocalUserNum);
+	return User ? User->Friends : NoFriends;
+}
+
+bool FShooterFriendsCache::IsFriend(int32 LocalUserNum, const FUniqueNetId& UserId) const
+{
+	return FindFriend(GetFriends(LocalUserNum), UserId) != INDEX_NONE;
+}
+
+void FShooterFriendsCache::ReadFriendsList(int32 LocalUserNum)
+{
+	FUserFriends& User = GetUser(LocalUserNum);
+	if (User.bReadInProgress || User.ReadTickerHandle.IsValid())
+	{
+		User.bReadPending = true;
+		return;
+	}
+
+	const double TimeSinceLastRead = FPlatformTime::Seconds() - User.LastReadTime;
+	if (User.LastReadTime > 0.0 && TimeSinceLastRead < GShooterFriendsCacheMinReadInterval)
+	{
+		User.ReadTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FShooterFriendsCache::HandleReadTicker, LocalUserNum), GShooterFriendsCacheMinReadInterval - TimeSinceLastRead);
+		return;
+	}
+
+	IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInt = OnlineSub ? OnlineSub->GetFriendsInterface() : NULL;
+	if (FriendsInt.IsValid())
+	{
+		User.bReadInProgress = true;
+		User.bReadPending = false;
+		if (!FriendsInt->ReadFriendsList(LocalUserNum, FriendsListName, FOnReadFriendsListComplete::CreateSP(this, &FShooterFriendsCache::OnReadFriendsListComplete)))
+		{
+			User.bReadInProgress = false;
+		}
+	}
+}
+
+bool FShooterFriendsCache::HandleReadTicker(float DeltaTime, int32 LocalUserNum)
+{
+	// returning false removes the ticker
+	GetUser(LocalUserNum).ReadTickerHandle.Reset();
+	ReadFriendsList(LocalUserNum);
+	return false;
+}
+
+void FShooterFriendsCache::OnReadFriendsListComplete(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& ErrorStr)
+{
+	FUserFriends& User = GetUser(LocalUserNum);
+	User.bReadInProgress = false;
+	User.LastReadTime = FPlatformTime::Seconds();
+
+	IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInt = OnlineSub ? OnlineSub->GetFriendsInterface() : NULL;
+
+	TArray< TSharedRef<FOnlineFriend> > NewFriends;
+	if (!bWasSuccessful || !FriendsInt.IsValid() || !FriendsInt->GetFriendsList(LocalUserNum, FriendsListName, NewFriends))
+	{
+		UE_LOG(LogOnline, Warning, TEXT("Failed to read friends of user %d: %s"), LocalUserNum, *ErrorStr);
+	}
+	else
+	{
+		FShooterFriendsDiff Diff;
+		for (int32 i = 0; i < NewFriends.Num(); i++)
+		{
+			const int32 OldIndex = FindFriend(User.Friends, *NewFriends[i]->GetUserId());
+			if (OldIndex == INDEX_NONE)
+			{
+				Diff.Added.Add(NewFriends[i]);
+			}
+			else if (User.Friends[OldIndex]->GetDisplayName() != NewFriends[i]->GetDisplayName())
+			{
+				Diff.Updated.Add(NewFriends[i]);
+			}
+		}
+
+		for (int32 i = 0; i < User.Friends.Num(); i++)
+		{
+			if (FindFriend(NewFriends, *User.Friends[i]->GetUserId()) == INDEX_NONE)
+			{
+				Diff.Removed.Add(User.Friends[i]);
+			}
+		}
+
+		User.Friends = NewFriends;
+
+		UE_LOG(LogOnline, Verbose, TEXT("Read friends of user %d: %d friends, %d added, %d removed, %d updated"), LocalUserNum, NewFriends.Num(), Diff.Added.Num(), Diff.Removed.Num(), Diff.Updated.Num());
+
+		if (!Diff.IsEmpty())
+		{
+			FriendsChangedEvent.Broadcast(LocalUserNum, Diff);
+		}
+	}
+
+	if (User.bReadPending)
+	{
+		ReadFriendsList(LocalUserNum);
+	}
+}
+
+void FShooterFriendsCache::OnFriendsChange(int32 LocalUserNum)
+{
+	ReadFriendsList(LocalUserNum);
+}
+
+void FShooterFriendsCache::OnPresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence)
+{
+	TArray<int32> UsersToRead;
+	for (TMap<int32, FUserFriends>::TIterator It(Users); It; ++It)
+	{
+		FUserFriends& User = It.Value();
+		const int32 Index = FindFriend(User.Friends, UserId);
+		if (Index == INDEX_NONE)
+		{
+			// only online friends are listed, this may be a friend coming online
+			if (Presence->bIsOnline)
+			{
+				UsersToRead.Add(It.Key());
+			}
+			continue;
+		}
+
+		FShooterFriendsDiff Diff;
+		if (Presence->bIsOnline)
+		{
+			Diff.Updated.Add(User.Friends[Index]);
+		}
+		else
+		{
+			Diff.Removed.Add(User.Friends[Index]);
+			User.Friends.RemoveAt(Index);
+		}
+
+		FriendsChangedEvent.Broadcast(It.Key(), Diff);
+	}
+
+	// reads are rate limited and coalesced, a burst of presence updates results in a single read
+	for (int32 i = 0; i < UsersToRead.Num(); i++)
+	{
+		ReadFriendsList(UsersToRead[i]);
+	}
+}
+
+int32 FShooterFriendsCache::FindFriend(const TArray< TSharedRef<FOnlineFriend> >& Friends, const FUniqueNetId& UserId)
+{
+	for (int32 i = 0; i < Friends.Num(); i++)
+	{
+		if (*Friends[i]->GetUserId() == UserId)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
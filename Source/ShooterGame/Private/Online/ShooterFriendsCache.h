@@ -0,0 +1,113 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "OnlineFriendsInterface.h"
+#include "OnlinePresenceInterface.h"
+
+/** Changes to a friends list since it was last reported. */
+struct FShooterFriendsDiff
+{
+	TArray< TSharedRef<FOnlineFriend> > Added;
+	TArray< TSharedRef<FOnlineFriend> > Removed;
+
+	/** friends whose name or presence changed */
+	TArray< TSharedRef<FOnlineFriend> > Updated;
+
+	bool IsEmpty() const
+	{
+		return Added.Num() == 0 && Removed.Num() == 0 && Updated.Num() == 0;
+	}
+};
+
+/** delegate called when the cached friends list of a local user changes */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterFriendsChanged, int32 /*LocalUserNum*/, const FShooterFriendsDiff& /*Diff*/);
+
+/**
+ * Online friends of local users, shared by the menus.
+ *
+ * The list is read when it's first requested and then kept up to date from the online subsystem's friends and
+ * presence change events. It is read again only when it's explicitly refreshed, the online subsystem reports a
+ * change of the list, someone not on the list comes online, or it's older than shooter.FriendsCacheTTL. Reads of a user are at least
+ * shooter.FriendsCacheMinReadInterval apart, to stay below the rate limits of platform web APIs.
+ */
+class FShooterFriendsCache : public TSharedFromThis<FShooterFriendsCache>
+{
+public:
+
+	FShooterFriendsCache();
+	~FShooterFriendsCache();
+
+	/** subscribe to presence changes, needs to be called once the cache is owned by a shared pointer */
+	void Init();
+
+	/** read the list of user if it hasn't been read yet or is out of date */
+	void RequestFriends(int32 LocalUserNum);
+
+	/** read the list of user again */
+	void Refresh(int32 LocalUserNum);
+
+	/** get cached friends of user */
+	const TArray< TSharedRef<FOnlineFriend> >& GetFriends(int32 LocalUserNum) const;
+
+	/** is UserId in the cached list of user? */
+	bool IsFriend(int32 LocalUserNum, const FUniqueNetId& UserId) const;
+
+	/** called with the changes whenever the list of a user changes */
+	FOnShooterFriendsChanged& OnFriendsChanged() { return FriendsChangedEvent; }
+
+private:
+
+	struct FUserFriends
+	{
+		TArray< TSharedRef<FOnlineFriend> > Friends;
+
+		/** time the last read completed, 0 if never */
+		double LastReadTime;
+
+		bool bReadInProgress;
+
+		/** read again when the current read completes or the rate limit allows it */
+		bool bReadPending;
+
+		FDelegateHandle FriendsChangeHandle;
+		FDelegateHandle ReadTickerHandle;
+
+		FUserFriends()
+			: LastReadTime(0.0)
+			, bReadInProgress(false)
+			, bReadPending(false)
+		{
+		}
+	};
+
+	/** get entry of user, subscribes to list changes of new users */
+	FUserFriends& GetUser(int32 LocalUserNum);
+
+	/** start a read, or schedule it if the last one was too recent */
+	void ReadFriendsList(int32 LocalUserNum);
+
+	/** [ticker] scheduled read */
+	bool HandleReadTicker(float DeltaTime, int32 LocalUserNum);
+
+	/** [delegate] list read, diff it against the cached one */
+	void OnReadFriendsListComplete(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& ErrorStr);
+
+	/** [delegate] online subsystem reports a change of the list */
+	void OnFriendsChange(int32 LocalUserNum);
+
+	/** [delegate] presence of some user changed */
+	void OnPresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence);
+
+	/** index of friend in list, INDEX_NONE if not found */
+	static int32 FindFriend(const TArray< TSharedRef<FOnlineFriend> >& Friends, const FUniqueNetId& UserId);
+
+	TMap<int32, FUserFriends> Users;
+
+	FOnShooterFriendsChanged FriendsChangedEvent;
+
+	FDelegateHandle PresenceReceivedHandle;
+
+	/** returned for users without a list */
+	TArray< TSharedRef<FOnlineFriend> > NoFriends;
+};
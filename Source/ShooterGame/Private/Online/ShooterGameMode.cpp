@@ -2,6 +2,10 @@
 
 #include "ShooterGame.h"
 #include "ShooterSpectatorPawn.h"
+#include "Online/ShooterNetProfiler.h"
+#include "ShooterStats.h"
+#include "ShooterDemoCatalog.h"
+#include "Weapons/ShooterWeaponPool.h"
 
 AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -35,6 +39,14 @@ void AShooterGameMode::InitGame(const FString& MapName, const FString& Options,
 	SetAllowBots(BotsCountOptionValue > 0 ? true : false, BotsCountOptionValue);	
 	Super::InitGame(MapName, Options, ErrorMessage);
 
+	WeaponPool = MakeShareable(new FShooterWeaponPool());
+
+	DemoRecName = ParseOption(Options, TEXT("DemoRec"));
+	if (!DemoRecName.IsEmpty())
+	{
+		FShooterDemoCatalog::Get().NotifyRecordingStarted(DemoRecName);
+	}
+
 	const UGameInstance* GI = GetGameInstance();
 	if (GI && Cast<UShooterGameInstance>(GI)->GetIsOnline())
 	{
@@ -182,6 +194,21 @@ void AShooterGameMode::FinishMatch()
 
 		// set up to restart the match
 		MyGameState->RemainingTime = TimeBetweenMatches;
+
+		// remember what this demo is about, the demo browser can't get it from the file
+		if (!DemoRecName.IsEmpty() && GetWorld()->DemoNetDriver)
+		{
+			FString DemoMapName = GetWorld()->GetMapName();
+			DemoMapName.RemoveFromStart(GetWorld()->StreamingLevelsPrefix);
+			FShooterDemoCatalog::Get().NotifyRecordingFinished(DemoRecName, DemoMapName, MyGameState->ElapsedTime, MyGameState->PlayerArray.Num());
+		}
+
+		// write network profile for this match
+		if (FShooterNetProfiler::IsEnabled())
+		{
+			FShooterNetProfiler::Get().DumpToCSV(GetWorld());
+			FShooterNetProfiler::Get().Reset();
+		}
 	}
 }
 
@@ -339,6 +366,8 @@ UClass* AShooterGameMode::GetDefaultPawnClassForController(AController* InContro
 
 AActor* AShooterGameMode::ChoosePlayerStart(AController* Player)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(ChoosePlayerStart);
+
 	TArray<APlayerStart*> PreferredSpawns;
 	TArray<APlayerStart*> FallbackSpawns;
 
@@ -7,6 +7,8 @@ AShooterGameState::AShooterGameState(const FObjectInitializer& ObjectInitializer
 	NumTeams = 0;
 	RemainingTime = 0;
 	bTimerPaused = false;
+	NumRankedTeams = 0;
+	RankingVersion = 0;
 }
 
 void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
@@ -19,36 +21,145 @@ void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	DOREPLIFETIME( AShooterGameState, TeamScores );
 }
 
-void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
+void AShooterGameState::PostInitializeComponents()
 {
-	OutRankedMap.Empty();
+	Super::PostInitializeComponents();
 
-	//first, we need to go over all the PlayerStates, grab their score, and rank them
-	TMultiMap<int32, AShooterPlayerState*> SortedMap;
-	for(int32 i = 0; i < PlayerArray.Num(); ++i)
+	for (TActorIterator<AShooterCharacter> It(GetWorld()); It; ++It)
 	{
-		int32 Score = 0;
-		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
-		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+		It->UpdateTeamMaterials();
+	}
+}
+
+UMaterialInstanceDynamic* AShooterGameState::GetTeamMaterial(UMaterialInterface* Parent, int32 TeamNum)
+{
+	for (int32 i = 0; i < TeamMaterials.Num(); i++)
+	{
+		if (TeamMaterials[i].Parent == Parent && TeamMaterials[i].TeamNum == TeamNum)
 		{
-			SortedMap.Add(FMath::TruncToInt(CurPlayerState->Score), CurPlayerState);
+			return TeamMaterials[i].MaterialInstance;
 		}
 	}
 
-	//sort by the keys
-	SortedMap.KeySort(TGreater<int32>());
+	FShooterTeamMaterial& TeamMaterial = TeamMaterials[TeamMaterials.AddDefaulted()];
+	TeamMaterial.Parent = Parent;
+	TeamMaterial.TeamNum = TeamNum;
+	TeamMaterial.MaterialInstance = UMaterialInstanceDynamic::Create(Parent, this);
+	TeamMaterial.MaterialInstance->SetScalarParameterValue(TEXT("Team Color Index"), (float)TeamNum);
+	return TeamMaterial.MaterialInstance;
+}
+
+void AShooterGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+
+	AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
+	if (ShooterPlayerState && !PlayerRanks.Contains(ShooterPlayerState))
+	{
+		PlayerRanks.Add(ShooterPlayerState, FShooterPlayerRank());
+		InsertIntoTeamRanking(ShooterPlayerState);
+		OnRankingChanged();
+	}
+}
+
+void AShooterGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
+	if (ShooterPlayerState && PlayerRanks.Contains(ShooterPlayerState))
+	{
+		RemoveFromTeamRanking(ShooterPlayerState);
+		PlayerRanks.Remove(ShooterPlayerState);
+		OnRankingChanged();
+	}
+
+	Super::RemovePlayerState(PlayerState);
+}
+
+const TArray<AShooterPlayerState*>& AShooterGameState::GetRankedPlayers(int32 TeamIndex) const
+{
+	static const TArray<AShooterPlayerState*> NoPlayers;
+	return TeamRankings.IsValidIndex(TeamIndex) ? TeamRankings[TeamIndex] : NoPlayers;
+}
+
+int32 AShooterGameState::GetPlayerRank(const AShooterPlayerState* PlayerState) const
+{
+	const FShooterPlayerRank* PlayerRank = PlayerRanks.Find(PlayerState);
+	return PlayerRank ? PlayerRank->Rank : INDEX_NONE;
+}
+
+void AShooterGameState::UpdatePlayerRanking(AShooterPlayerState* PlayerState)
+{
+	// players not in PlayerArray (inactive or not added yet) aren't ranked
+	if (PlayerState && PlayerRanks.Contains(PlayerState))
+	{
+		RemoveFromTeamRanking(PlayerState);
+		InsertIntoTeamRanking(PlayerState);
+		OnRankingChanged();
+	}
+}
+
+void AShooterGameState::RemoveFromTeamRanking(const AShooterPlayerState* PlayerState)
+{
+	FShooterPlayerRank& PlayerRank = PlayerRanks.FindChecked(PlayerState);
+	if (PlayerRank.TeamIndex != INDEX_NONE)
+	{
+		const int32 TeamIndex = PlayerRank.TeamIndex;
+		const int32 Rank = PlayerRank.Rank;
+		PlayerRank = FShooterPlayerRank();
+
+		TeamRankings[TeamIndex].RemoveAt(Rank, 1, false);
+		ReindexTeamRanking(TeamIndex, Rank);
+	}
+}
+
+void AShooterGameState::InsertIntoTeamRanking(AShooterPlayerState* PlayerState)
+{
+	const int32 TeamIndex = PlayerState->GetTeamNum();
+	if (TeamIndex < 0)
+	{
+		return;
+	}
 
-	//now, add them back to the ranked map
-	OutRankedMap.Empty();
+	if (TeamRankings.Num() <= TeamIndex)
+	{
+		TeamRankings.SetNum(TeamIndex + 1);
+	}
 
+	// players are ranked by truncated score, a new score goes after everyone with the same score
+	TArray<AShooterPlayerState*>& Ranking = TeamRankings[TeamIndex];
+	const int32 Score = FMath::TruncToInt(PlayerState->Score);
 	int32 Rank = 0;
-	for(TMultiMap<int32, AShooterPlayerState*>::TIterator It(SortedMap); It; ++It)
+	while (Rank < Ranking.Num() && FMath::TruncToInt(Ranking[Rank]->Score) >= Score)
 	{
-		OutRankedMap.Add(Rank++, It.Value());
+		Rank++;
 	}
-	
+
+	Ranking.Insert(PlayerState, Rank);
+	ReindexTeamRanking(TeamIndex, Rank);
 }
 
+void AShooterGameState::ReindexTeamRanking(int32 TeamIndex, int32 FirstRank)
+{
+	const TArray<AShooterPlayerState*>& Ranking = TeamRankings[TeamIndex];
+	for (int32 Rank = FirstRank; Rank < Ranking.Num(); Rank++)
+	{
+		PlayerRanks.FindChecked(Ranking[Rank]) = FShooterPlayerRank(TeamIndex, Rank);
+	}
+}
+
+void AShooterGameState::OnRankingChanged()
+{
+	NumRankedTeams = 0;
+	for (int32 i = 0; i < TeamRankings.Num(); i++)
+	{
+		if (TeamRankings[i].Num() > 0)
+		{
+			NumRankedTeams++;
+		}
+	}
+
+	RankingVersion++;
+}
 
 void AShooterGameState::RequestFinishAndExitToMainMenu()
 {
@@ -0,0 +1,386 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterMatchStats.h"
+#include "Online.h"
+#include "OnlineEventsInterface.h"
+#include "OnlineIdentityInterface.h"
+
+#define  ACH_SOME_KILLS		TEXT("ACH_SOME_KILLS")
+#define  ACH_LOTS_KILLS		TEXT("ACH_LOTS_KILLS")
+#define  ACH_FINISH_MATCH	TEXT("ACH_FINISH_MATCH")
+#define  ACH_LOTS_MATCHES	TEXT("ACH_LOTS_MATCHES")
+#define  ACH_FIRST_WIN		TEXT("ACH_FIRST_WIN")
+#define  ACH_LOTS_WIN		TEXT("ACH_LOTS_WIN")
+#define  ACH_MANY_WIN		TEXT("ACH_MANY_WIN")
+#define  ACH_SHOOT_BULLETS	TEXT("ACH_SHOOT_BULLETS")
+#define  ACH_SHOOT_ROCKETS	TEXT("ACH_SHOOT_ROCKETS")
+#define  ACH_GOOD_SCORE		TEXT("ACH_GOOD_SCORE")
+#define  ACH_GREAT_SCORE	TEXT("ACH_GREAT_SCORE")
+#define  ACH_PLAY_SANCTUARY	TEXT("ACH_PLAY_SANCTUARY")
+#define  ACH_PLAY_HIGHRISE	TEXT("ACH_PLAY_HIGHRISE")
+
+static const int32 SomeKillsCount = 10;
+static const int32 LotsKillsCount = 20;
+static const int32 LotsMatchesCount = 5;
+static const int32 LotsWinsCount = 3;
+static const int32 ManyWinsCount = 5;
+static const int32 LotsBulletsCount = 100;
+static const int32 LotsRocketsCount = 10;
+static const int32 GoodScoreCount = 10;
+static const int32 GreatScoreCount = 15;
+
+float GShooterMatchStatsBudgetMs = 1.0f;
+static FAutoConsoleVariableRef CVarShooterMatchStatsBudgetMs(
+	TEXT("shooter.MatchStatsBudgetMs"),
+	GShooterMatchStatsBudgetMs,
+	TEXT("Milliseconds per frame spent on end of match stats (save file, achievements, leaderboards).\n")
+	TEXT("At least one step runs every frame.\n")
+	TEXT("Default is 1."),
+	ECVF_Default
+	);
+
+#if !UE_BUILD_SHIPPING
+static void SubmitTestMatchResult(UWorld* InWorld)
+{
+	UShooterGameInstance* const GameInstance = InWorld ? Cast<UShooterGameInstance>(InWorld->GetGameInstance()) : NULL;
+	AShooterPlayerController* const PC = GameInstance ? Cast<AShooterPlayerController>(GameInstance->GetFirstLocalPlayerController()) : NULL;
+
+	FShooterMatchResult Result;
+	if (PC && Result.Collect(PC, true))
+	{
+		UE_LOG(LogOnline, Log, TEXT("Submitting test match result: %d kills, %d deaths, %d bullets, %d rockets, score %d"), Result.Kills, Result.Deaths, Result.BulletsFired, Result.RocketsFired, Result.Score);
+		GameInstance->GetMatchStats()->Submit(Result);
+	}
+	else
+	{
+		UE_LOG(LogOnline, Warning, TEXT("No local player to submit a test match result for."));
+	}
+}
+
+static FAutoConsoleCommandWithWorld MatchStatsTestCmd(
+	TEXT("shooter.MatchStatsTest"),
+	TEXT("Runs the end of match stats pipeline for the first local player, as a won match with the current score.\n")
+	TEXT("The result is added to the player's profile."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(SubmitTestMatchResult)
+	);
+#endif
+
+bool FShooterMatchResult::Collect(AShooterPlayerController* PC, bool bInIsWinner)
+{
+	ULocalPlayer* const LocalPlayer = Cast<ULocalPlayer>(PC->Player);
+	const AShooterPlayerState* const ShooterPlayerState = Cast<AShooterPlayerState>(PC->PlayerState);
+	if (LocalPlayer == NULL || ShooterPlayerState == NULL)
+	{
+		return false;
+	}
+
+	PersistentUser = PC->GetPersistentUser();
+
+	const auto Identity = Online::GetIdentityInterface();
+	if (Identity.IsValid())
+	{
+		UserId = Identity->GetUniquePlayerId(LocalPlayer->GetControllerId());
+	}
+	if (!UserId.IsValid())
+	{
+		UserId = LocalPlayer->GetCachedUniqueNetId();
+	}
+
+	SessionName = ShooterPlayerState->SessionName;
+
+	UWorld* const World = PC->GetWorld();
+	if (World)
+	{
+		MapName = FPackageName::GetShortName(World->PersistentLevel->GetOutermost()->GetName());
+	}
+
+	Kills = ShooterPlayerState->GetKills();
+	Deaths = ShooterPlayerState->GetDeaths();
+	BulletsFired = ShooterPlayerState->GetNumBulletsFired();
+	RocketsFired = ShooterPlayerState->GetNumRocketsFired();
+	Score = (int32)ShooterPlayerState->GetScore();
+	bIsWinner = bInIsWinner;
+
+	return true;
+}
+
+void FShooterMatchStats::Submit(const FShooterMatchResult& Result)
+{
+	FPendingResult& NewResult = Pending[Pending.AddDefaulted()];
+	NewResult.Result = Result;
+	NewResult.Step = EShooterMatchStatsStep::SaveFile;
+}
+
+void FShooterMatchStats::Tick()
+{
+	CheckAchievementWrites();
+
+	const double StartTime = FPlatformTime::Seconds();
+	while (Pending.Num() > 0)
+	{
+		RunStep(Pending[0]);
+		if (Pending[0].Step == EShooterMatchStatsStep::Done)
+		{
+			Pending.RemoveAt(0);
+		}
+
+		if ((FPlatformTime::Seconds() - StartTime) * 1000.0 >= GShooterMatchStatsBudgetMs)
+		{
+			break;
+		}
+	}
+}
+
+void FShooterMatchStats::Flush()
+{
+	while (Pending.Num() > 0)
+	{
+		RunStep(Pending[0]);
+		if (Pending[0].Step == EShooterMatchStatsStep::Done)
+		{
+			Pending.RemoveAt(0);
+		}
+	}
+}
+
+void FShooterMatchStats::RunStep(FPendingResult& PendingResult)
+{
+	switch (PendingResult.Step)
+	{
+		case EShooterMatchStatsStep::SaveFile:
+			UpdateSaveFile(PendingResult.Result);
+			PendingResult.Step = EShooterMatchStatsStep::Achievements;
+			break;
+
+		case EShooterMatchStatsStep::Achievements:
+			WriteAchievements(PendingResult.Result);
+			PendingResult.Step = EShooterMatchStatsStep::Leaderboards;
+			break;
+
+		case EShooterMatchStatsStep::Leaderboards:
+			WriteLeaderboards(PendingResult.Result);
+			PendingResult.Step = EShooterMatchStatsStep::Done;
+			break;
+
+		default:
+			PendingResult.Step = EShooterMatchStatsStep::Done;
+			break;
+	}
+}
+
+void FShooterMatchStats::UpdateSaveFile(const FShooterMatchResult& Result)
+{
+	UShooterPersistentUser* const PersistentUser = Result.PersistentUser.Get();
+	if (PersistentUser)
+	{
+		PersistentUser->AddMatchResult(Result.Kills, Result.Deaths, Result.BulletsFired, Result.RocketsFired, Result.bIsWinner);
+		PersistentUser->SaveIfDirty();
+	}
+}
+
+void FShooterMatchStats::WriteAchievements(const FShooterMatchResult& Result)
+{
+	// progress is based on lifetime stats, which include this match after the save file step
+	const UShooterPersistentUser* const PersistentUser = Result.PersistentUser.Get();
+	if (PersistentUser == NULL || !Result.UserId.IsValid())
+	{
+		return;
+	}
+
+	const int32 Wins = PersistentUser->GetWins();
+	const int32 Losses = PersistentUser->GetLosses();
+	const int32 Matches = Wins + Losses;
+
+	const int32 TotalKills = PersistentUser->GetKills();
+	const int32 MatchScore = Result.Score;
+
+	const int32 TotalBulletsFired = PersistentUser->GetBulletsFired();
+	const int32 TotalRocketsFired = PersistentUser->GetRocketsFired();
+
+	FOnlineAchievementsWritePtr WriteObject = MakeShareable(new FOnlineAchievementsWrite());
+
+	float TotalGameAchievement = 0;
+	float CurrentGameAchievement = 0;
+
+	///////////////////////////////////////
+	// Kill achievements
+	if (TotalKills >= 1)
+	{
+		CurrentGameAchievement += 100.0f;
+	}
+	TotalGameAchievement += 100;
+
+	{
+		float fSomeKillPct = ((float)TotalKills / (float)SomeKillsCount) * 100.0f;
+		fSomeKillPct = FMath::RoundToFloat(fSomeKillPct);
+		WriteObject->SetFloatStat(ACH_SOME_KILLS, fSomeKillPct);
+
+		CurrentGameAchievement += FMath::Min(fSomeKillPct, 100.0f);
+		TotalGameAchievement += 100;
+	}
+
+	{
+		float fLotsKillPct = ((float)TotalKills / (float)LotsKillsCount) * 100.0f;
+		fLotsKillPct = FMath::RoundToFloat(fLotsKillPct);
+		WriteObject->SetFloatStat(ACH_LOTS_KILLS, fLotsKillPct);
+
+		CurrentGameAchievement += FMath::Min(fLotsKillPct, 100.0f);
+		TotalGameAchievement += 100;
+	}
+	///////////////////////////////////////
+
+	///////////////////////////////////////
+	// Match Achievements
+	{
+		WriteObject->SetFloatStat(ACH_FINISH_MATCH, 100.0f);
+
+		CurrentGameAchievement += 100;
+		TotalGameAchievement += 100;
+	}
+
+	{
+		float fLotsRoundsPct = ((float)Matches / (float)LotsMatchesCount) * 100.0f;
+		fLotsRoundsPct = FMath::RoundToFloat(fLotsRoundsPct);
+		WriteObject->SetFloatStat(ACH_LOTS_MATCHES, fLotsRoundsPct);
+
+		CurrentGameAchievement += FMath::Min(fLotsRoundsPct, 100.0f);
+		TotalGameAchievement += 100;
+	}
+	///////////////////////////////////////
+
+	///////////////////////////////////////
+	// Win Achievements
+	if (Wins >= 1)
+	{
+		WriteObject->SetFloatStat(ACH_FIRST_WIN, 100.0f);
+
+		CurrentGameAchievement += 100.0f;
+	}
+	TotalGameAchievement += 100;
+
+	{
+		float fLotsWinPct = ((float)Wins / (float)LotsWinsCount) * 100.0f;
+		fLotsWinPct = FMath::RoundToInt(fLotsWinPct);
+		WriteObject->SetFloatStat(ACH_LOTS_WIN, fLotsWinPct);
+
+		CurrentGameAchievement += FMath::Min(fLotsWinPct, 100.0f);
+		TotalGameAchievement += 100;
+	}
+
+	{
+		float fManyWinPct = ((float)Wins / (float)ManyWinsCount) * 100.0f;
+		fManyWinPct = FMath::RoundToInt(fManyWinPct);
+		WriteObject->SetFloatStat(ACH_MANY_WIN, fManyWinPct);
+
+		CurrentGameAchievement += FMath::Min(fManyWinPct, 100.0f);
+		TotalGameAchievement += 100;
+	}
+	///////////////////////////////////////
+
+	///////////////////////////////////////
+	// Ammo Achievements
+	{
+		float fLotsBulletsPct = ((float)TotalBulletsFired / (float)LotsBulletsCount) * 100.0f;
+		fLotsBulletsPct = FMath::RoundToFloat(fLotsBulletsPct);
+		WriteObject->SetFloatStat(ACH_SHOOT_BULLETS, fLotsBulletsPct);
+
+		CurrentGameAchievement += FMath::Min(fLotsBulletsPct, 100.0f);
+		TotalGameAchievement += 100;
+	}
+
+	{
+		float fLotsRocketsPct = ((float)TotalRocketsFired / (float)LotsRocketsCount) * 100.0f;
+		fLotsRocketsPct = FMath::RoundToFloat(fLotsRocketsPct);
+		WriteObject->SetFloatStat(ACH_SHOOT_ROCKETS, fLotsRocketsPct);
+
+		CurrentGameAchievement += FMath::Min(fLotsRocketsPct, 100.0f);
+		TotalGameAchievement += 100;
+	}
+	///////////////////////////////////////
+
+	///////////////////////////////////////
+	// Score Achievements
+	{
+		float fGoodScorePct = ((float)MatchScore / (float)GoodScoreCount) * 100.0f;
+		fGoodScorePct = FMath::RoundToFloat(fGoodScorePct);
+		WriteObject->SetFloatStat(ACH_GOOD_SCORE, fGoodScorePct);
+	}
+
+	{
+		float fGreatScorePct = ((float)MatchScore / (float)GreatScoreCount) * 100.0f;
+		fGreatScorePct = FMath::RoundToFloat(fGreatScorePct);
+		WriteObject->SetFloatStat(ACH_GREAT_SCORE, fGreatScorePct);
+	}
+	///////////////////////////////////////
+
+	///////////////////////////////////////
+	// Map Play Achievements
+	if (Result.MapName.Find(TEXT("Highrise")) != -1)
+	{
+		WriteObject->SetFloatStat(ACH_PLAY_HIGHRISE, 100.0f);
+	}
+	else if (Result.MapName.Find(TEXT("Sanctuary")) != -1)
+	{
+		WriteObject->SetFloatStat(ACH_PLAY_SANCTUARY, 100.0f);
+	}
+	///////////////////////////////////////
+
+	IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
+	IOnlineAchievementsPtr Achievements = OnlineSub ? OnlineSub->GetAchievementsInterface() : NULL;
+	if (Achievements.IsValid())
+	{
+		FAchievementWrite& Write = AchievementWrites[AchievementWrites.AddDefaulted()];
+		Write.UserId = Result.UserId;
+		Write.WriteObject = WriteObject;
+		Write.StartTime = FPlatformTime::Seconds();
+
+		FOnlineAchievementsWriteRef WriteObjectRef = WriteObject.ToSharedRef();
+		Achievements->WriteAchievements(*Result.UserId, WriteObjectRef);
+	}
+
+	const auto Events = Online::GetEventsInterface();
+	if (Events.IsValid())
+	{
+		FOnlineEventParms Params;
+
+		float fGamePct = (CurrentGameAchievement / TotalGameAchievement) * 100.0f;
+		fGamePct = FMath::RoundToFloat(fGamePct);
+		Params.Add( TEXT( "CompletionPercent" ), FVariantData( (float)fGamePct ) );
+		Events->TriggerEvent(*Result.UserId, TEXT("GameProgress"), Params);
+	}
+}
+
+void FShooterMatchStats::WriteLeaderboards(const FShooterMatchResult& Result)
+{
+	IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
+	IOnlineLeaderboardsPtr Leaderboards = OnlineSub ? OnlineSub->GetLeaderboardsInterface() : NULL;
+	if (Leaderboards.IsValid() && Result.UserId.IsValid())
+	{
+		FShooterAllTimeMatchResultsWrite WriteObject;
+
+		WriteObject.SetIntStat(LEADERBOARD_STAT_SCORE, Result.Kills);
+		WriteObject.SetIntStat(LEADERBOARD_STAT_KILLS, Result.Kills);
+		WriteObject.SetIntStat(LEADERBOARD_STAT_DEATHS, Result.Deaths);
+		WriteObject.SetIntStat(LEADERBOARD_STAT_MATCHESPLAYED, 1);
+
+		// the call will copy the user id and write object to its own memory
+		const bool bStarted = Leaderboards->WriteLeaderboards(Result.SessionName, *Result.UserId, WriteObject);
+		UE_LOG(LogOnline, Log, TEXT("Match stats: leaderboard write for %s %s"), *Result.UserId->ToString(), bStarted ? TEXT("started") : TEXT("failed"));
+	}
+}
+
+void FShooterMatchStats::CheckAchievementWrites()
+{
+	for (int32 i = AchievementWrites.Num() - 1; i >= 0; i--)
+	{
+		const FAchievementWrite& Write = AchievementWrites[i];
+		const EOnlineAsyncTaskState::Type WriteState = Write.WriteObject->WriteState;
+		if (WriteState == EOnlineAsyncTaskState::Done || WriteState == EOnlineAsyncTaskState::Failed)
+		{
+			UE_LOG(LogOnline, Log, TEXT("Match stats: achievement write for %s %s after %.1f ms"),
+				*Write.UserId->ToString(), EOnlineAsyncTaskState::ToString(WriteState), (FPlatformTime::Seconds() - Write.StartTime) * 1000.0);
+			AchievementWrites.RemoveAt(i);
+		}
+	}
+}
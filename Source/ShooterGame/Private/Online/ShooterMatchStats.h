@@ -0,0 +1,106 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "OnlineAchievementsInterface.h"
+
+/** Results of a local player's match, collected once when the match ends. */
+struct FShooterMatchResult
+{
+	/** profile the results are added to */
+	TWeakObjectPtr<class UShooterPersistentUser> PersistentUser;
+
+	/** online id for achievements, events and leaderboards, may be invalid */
+	TSharedPtr<FUniqueNetId> UserId;
+
+	FName SessionName;
+	FString MapName;
+
+	int32 Kills;
+	int32 Deaths;
+	int32 BulletsFired;
+	int32 RocketsFired;
+	int32 Score;
+	bool bIsWinner;
+
+	FShooterMatchResult()
+		: Kills(0)
+		, Deaths(0)
+		, BulletsFired(0)
+		, RocketsFired(0)
+		, Score(0)
+		, bIsWinner(false)
+	{
+	}
+
+	/** collect results of a local player's controller, returns false if it has no local player or player state */
+	bool Collect(class AShooterPlayerController* PC, bool bInIsWinner);
+};
+
+namespace EShooterMatchStatsStep
+{
+	enum Type
+	{
+		SaveFile,
+		Achievements,
+		Leaderboards,
+		Done,
+	};
+}
+
+/**
+ * End of match stats pipeline.
+ *
+ * Match results are queued once per local player and handed to the save file, achievements and leaderboards
+ * one step at a time, as many steps per frame as fit in shooter.MatchStatsBudgetMs. Achievements of a player are
+ * written with a single request. Writes to the online interfaces complete asynchronously; their results are logged,
+ * so the pipeline can be checked against the Null online subsystem with shooter.MatchStatsTest.
+ */
+class FShooterMatchStats
+{
+public:
+
+	/** queue results of a local player */
+	void Submit(const FShooterMatchResult& Result);
+
+	/** run queued steps within the frame budget */
+	void Tick();
+
+	/** run all queued steps now, called on shutdown */
+	void Flush();
+
+private:
+
+	struct FPendingResult
+	{
+		FShooterMatchResult Result;
+		EShooterMatchStatsStep::Type Step;
+	};
+
+	struct FAchievementWrite
+	{
+		TSharedPtr<FUniqueNetId> UserId;
+		FOnlineAchievementsWritePtr WriteObject;
+		double StartTime;
+	};
+
+	/** run next step of result */
+	void RunStep(FPendingResult& Pending);
+
+	/** add results to the profile and schedule a save */
+	void UpdateSaveFile(const FShooterMatchResult& Result);
+
+	/** write progress of all match end achievements in one request */
+	void WriteAchievements(const FShooterMatchResult& Result);
+
+	void WriteLeaderboards(const FShooterMatchResult& Result);
+
+	/** log achievement writes that finished */
+	void CheckAchievementWrites();
+
+	/** results in order of submission */
+	TArray<FPendingResult> Pending;
+
+	/** achievement writes in progress */
+	TArray<FAchievementWrite> AchievementWrites;
+};
@@ -0,0 +1,523 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterNetProfiler.h"
+
+DEFINE_STAT(STAT_ShooterNetRPCCalls);
+DEFINE_STAT(STAT_ShooterNetRPCBits);
+DEFINE_STAT(STAT_ShooterNetPropertyUpdates);
+DEFINE_STAT(STAT_ShooterNetPropertyBits);
+DEFINE_STAT(STAT_ShooterNetWindowRPCBitsPerSec);
+DEFINE_STAT(STAT_ShooterNetWindowPropertyBitsPerSec);
+
+int32 GShooterNetProfile = 0;
+static FAutoConsoleVariableRef CVarShooterNetProfile(
+	TEXT("shooter.NetProfile"),
+	GShooterNetProfile,
+	TEXT("Track bandwidth used by shooter RPCs and replicated properties, per connection.\n")
+	TEXT("Results are available through shooter.NetProfileDump and written to CSV when the match ends.\n")
+	TEXT("Default is 0."),
+	ECVF_Default
+	);
+
+int32 GShooterNetProfileWindow = 10;
+static FAutoConsoleVariableRef CVarShooterNetProfileWindow(
+	TEXT("shooter.NetProfileWindow"),
+	GShooterNetProfileWindow,
+	TEXT("Length of the sliding window used by shooter.NetProfileDump, in seconds.\n")
+	TEXT("Default is 10."),
+	ECVF_Default
+	);
+
+static void ShooterNetProfileDump(const TArray<FString>& Args)
+{
+	if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+	{
+		FShooterNetProfiler::Get().Reset();
+		return;
+	}
+
+	FShooterNetProfiler::Get().DumpSummary(*GLog);
+}
+
+static FAutoConsoleCommand CmdShooterNetProfileDump(
+	TEXT("shooter.NetProfileDump"),
+	TEXT("Log RPC and replicated property bandwidth per connection for the last shooter.NetProfileWindow seconds.\n")
+	TEXT("Pass 'reset' to clear collected data."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(ShooterNetProfileDump)
+	);
+
+/** packed NetGUID, as sent for object references */
+static const int64 NetGUIDBits = 32;
+
+/** all data the connection has written so far, including the packet that isn't flushed yet */
+static int64 GetConnectionSentBits(UNetConnection* Connection)
+{
+	return (int64)Connection->OutBytes * 8 + Connection->SendBuffer.GetNumBits();
+}
+
+static int64 GetCurrentSecond()
+{
+	return (int64)FPlatformTime::Seconds();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FRPCScope
+
+FShooterNetProfiler::FRPCScope::FRPCScope(AActor* InActor, UFunction* InFunction)
+	: bActive(false)
+	, Function(InFunction)
+{
+	if (!FShooterNetProfiler::IsEnabled() || InActor == NULL)
+	{
+		return;
+	}
+
+	UNetDriver* NetDriver = InActor->GetNetDriver();
+	if (NetDriver == NULL)
+	{
+		return;
+	}
+
+	bActive = true;
+	if (NetDriver->ServerConnection)
+	{
+		FConnectionSnapshot Snapshot = { NetDriver->ServerConnection, GetConnectionSentBits(NetDriver->ServerConnection) };
+		Snapshots.Add(Snapshot);
+	}
+
+	for (int32 i = 0; i < NetDriver->ClientConnections.Num(); i++)
+	{
+		UNetConnection* Connection = NetDriver->ClientConnections[i];
+		if (Connection)
+		{
+			FConnectionSnapshot Snapshot = { Connection, GetConnectionSentBits(Connection) };
+			Snapshots.Add(Snapshot);
+		}
+	}
+}
+
+FShooterNetProfiler::FRPCScope::~FRPCScope()
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	FShooterNetProfiler& Profiler = FShooterNetProfiler::Get();
+	for (int32 i = 0; i < Snapshots.Num(); i++)
+	{
+		// connection may have been closed by the call, only count live ones
+		UNetConnection* Connection = Snapshots[i].Connection;
+		if (Connection && !Connection->IsPendingKill())
+		{
+			const int64 SentBits = GetConnectionSentBits(Connection) - Snapshots[i].SentBits;
+			if (SentBits > 0)
+			{
+				Profiler.Record(Connection, Function, 1, SentBits);
+				INC_DWORD_STAT(STAT_ShooterNetRPCCalls);
+				INC_DWORD_STAT_BY(STAT_ShooterNetRPCBits, SentBits);
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FShooterNetProfiler
+
+FShooterNetProfiler& FShooterNetProfiler::Get()
+{
+	static FShooterNetProfiler Profiler;
+	return Profiler;
+}
+
+FShooterNetProfiler::~FShooterNetProfiler()
+{
+	Reset();
+}
+
+bool FShooterNetProfiler::IsEnabled()
+{
+	return GShooterNetProfile != 0;
+}
+
+void FShooterNetProfiler::TrackReplicatedProperties(AActor* Actor)
+{
+	if (!IsEnabled() || Actor == NULL || Actor->Role != ROLE_Authority)
+	{
+		return;
+	}
+
+	UNetDriver* NetDriver = Actor->GetNetDriver();
+	if (NetDriver == NULL || NetDriver->ClientConnections.Num() == 0)
+	{
+		return;
+	}
+
+	Prune();
+
+	const TArray<FReplicatedProperty>& Properties = GetReplicatedProperties(Actor);
+
+	FShadowState& Shadow = ShadowStates.FindOrAdd(Actor);
+	const bool bNewShadow = (Shadow.Data == NULL);
+	if (bNewShadow)
+	{
+		UClass* ActorClass = Actor->GetClass();
+		Shadow.Class = ActorClass;
+		Shadow.Data = (uint8*)FMemory::Malloc(ActorClass->GetPropertiesSize(), ActorClass->GetMinAlignment());
+		for (int32 i = 0; i < Properties.Num(); i++)
+		{
+			if (Properties[i].ArrayIndex == 0)
+			{
+				Properties[i].Property->InitializeValue_InContainer(Shadow.Data);
+			}
+		}
+	}
+
+	UNetConnection* OwnerConnection = Actor->GetNetConnection();
+
+	for (int32 i = 0; i < Properties.Num(); i++)
+	{
+		UProperty* Property = Properties[i].Property;
+		const int32 ArrayIndex = Properties[i].ArrayIndex;
+		const void* Current = Property->ContainerPtrToValuePtr<void>(Actor, ArrayIndex);
+		void* Last = Property->ContainerPtrToValuePtr<void>(Shadow.Data, ArrayIndex);
+
+		const bool bChanged = bNewShadow || !Property->Identical(Current, Last);
+		const int64 Bits = EstimatePropertyBits(Property, Current);
+
+		for (int32 ConnIdx = 0; ConnIdx < NetDriver->ClientConnections.Num(); ConnIdx++)
+		{
+			UNetConnection* Connection = NetDriver->ClientConnections[ConnIdx];
+			if (Connection == NULL || !Connection->ActorChannels.Contains(Actor))
+			{
+				continue;
+			}
+
+			// connection that just opened a channel gets the full initial state
+			const bool bInitial = !Shadow.InitializedConnections.Contains(Connection);
+			if ((bChanged || bInitial) && PassesCondition(Properties[i].Condition, bInitial, Connection == OwnerConnection))
+			{
+				Record(Connection, Property, 1, Bits);
+				INC_DWORD_STAT(STAT_ShooterNetPropertyUpdates);
+				INC_DWORD_STAT_BY(STAT_ShooterNetPropertyBits, Bits);
+			}
+		}
+
+		if (bChanged)
+		{
+			Property->CopySingleValue(Last, Current);
+		}
+	}
+
+	for (int32 ConnIdx = 0; ConnIdx < NetDriver->ClientConnections.Num(); ConnIdx++)
+	{
+		UNetConnection* Connection = NetDriver->ClientConnections[ConnIdx];
+		if (Connection && Connection->ActorChannels.Contains(Actor))
+		{
+			Shadow.InitializedConnections.Add(Connection);
+		}
+	}
+}
+
+void FShooterNetProfiler::Record(UNetConnection* Connection, UField* Field, int32 Count, int64 Bits)
+{
+	FConnectionStats& ConnStats = Connections.FindOrAdd(Connection);
+	if (ConnStats.Label.IsEmpty())
+	{
+		APlayerController* PC = Connection->PlayerController;
+		ConnStats.Label = (PC && PC->PlayerState) ? PC->PlayerState->PlayerName : Connection->LowLevelGetRemoteAddress();
+	}
+
+	const int32 WindowSeconds = FMath::Max(1, GShooterNetProfileWindow);
+	if (ConnStats.Buckets.Num() != WindowSeconds)
+	{
+		ConnStats.Buckets.Empty(WindowSeconds);
+		ConnStats.Buckets.AddDefaulted(WindowSeconds);
+	}
+
+	const int64 Second = GetCurrentSecond();
+	FBucket& Bucket = ConnStats.Buckets[Second % WindowSeconds];
+	if (Bucket.Second != Second)
+	{
+		Bucket.Second = Second;
+		Bucket.Stats.Reset();
+	}
+
+	FStat& WindowStat = Bucket.Stats.FindOrAdd(Field);
+	WindowStat.Count += Count;
+	WindowStat.Bits += Bits;
+
+	FStat& TotalStat = ConnStats.Totals.FindOrAdd(Field);
+	TotalStat.Count += Count;
+	TotalStat.Bits += Bits;
+}
+
+const TArray<FShooterNetProfiler::FReplicatedProperty>& FShooterNetProfiler::GetReplicatedProperties(AActor* Actor)
+{
+	UClass* ActorClass = Actor->GetClass();
+	TArray<FReplicatedProperty>* Existing = ClassProperties.Find(ActorClass);
+	if (Existing)
+	{
+		return *Existing;
+	}
+
+	TArray<FReplicatedProperty>& Properties = ClassProperties.Add(ActorClass);
+
+	TArray<FLifetimeProperty> LifetimeProps;
+	Actor->GetLifetimeReplicatedProps(LifetimeProps);
+	for (int32 i = 0; i < LifetimeProps.Num(); i++)
+	{
+		const int32 RepIndex = LifetimeProps[i].RepIndex;
+		if (ActorClass->ClassReps.IsValidIndex(RepIndex))
+		{
+			FReplicatedProperty Entry;
+			Entry.Property = ActorClass->ClassReps[RepIndex].Property;
+			Entry.ArrayIndex = ActorClass->ClassReps[RepIndex].Index;
+			Entry.Condition = LifetimeProps[i].Condition;
+			Properties.Add(Entry);
+		}
+	}
+
+	return Properties;
+}
+
+void FShooterNetProfiler::FreeShadowState(FShadowState& Shadow)
+{
+	if (Shadow.Data)
+	{
+		const TArray<FReplicatedProperty>* Properties = ClassProperties.Find(Shadow.Class);
+		if (Properties)
+		{
+			for (int32 i = 0; i < Properties->Num(); i++)
+			{
+				if ((*Properties)[i].ArrayIndex == 0)
+				{
+					(*Properties)[i].Property->DestroyValue_InContainer(Shadow.Data);
+				}
+			}
+		}
+		FMemory::Free(Shadow.Data);
+		Shadow.Data = NULL;
+	}
+}
+
+void FShooterNetProfiler::Prune()
+{
+	const int64 Second = GetCurrentSecond();
+	if (Second == LastPruneSecond)
+	{
+		return;
+	}
+	LastPruneSecond = Second;
+
+	for (auto It = ShadowStates.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			FreeShadowState(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+
+	// refresh window averages for the stat page once per second
+	int64 WindowRPCBits = 0;
+	int64 WindowPropertyBits = 0;
+	const int32 WindowSeconds = FMath::Max(1, GShooterNetProfileWindow);
+	for (auto ConnIt = Connections.CreateConstIterator(); ConnIt; ++ConnIt)
+	{
+		const TArray<FBucket>& Buckets = ConnIt.Value().Buckets;
+		for (int32 i = 0; i < Buckets.Num(); i++)
+		{
+			if (Buckets[i].Second <= Second - WindowSeconds)
+			{
+				continue;
+			}
+
+			for (auto StatIt = Buckets[i].Stats.CreateConstIterator(); StatIt; ++StatIt)
+			{
+				if (Cast<UFunction>(StatIt.Key().Get()))
+				{
+					WindowRPCBits += StatIt.Value().Bits;
+				}
+				else
+				{
+					WindowPropertyBits += StatIt.Value().Bits;
+				}
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ShooterNetWindowRPCBitsPerSec, WindowRPCBits / WindowSeconds);
+	SET_DWORD_STAT(STAT_ShooterNetWindowPropertyBitsPerSec, WindowPropertyBits / WindowSeconds);
+}
+
+bool FShooterNetProfiler::PassesCondition(ELifetimeCondition Condition, bool bInitial, bool bIsOwner)
+{
+	switch (Condition)
+	{
+	case COND_InitialOnly:
+		return bInitial;
+	case COND_OwnerOnly:
+	case COND_AutonomousOnly:
+		return bIsOwner;
+	case COND_SkipOwner:
+	case COND_SimulatedOnly:
+		return !bIsOwner;
+	case COND_InitialOrOwner:
+		return bInitial || bIsOwner;
+	default:
+		// custom conditions are decided in PreReplication, assume they pass
+		return true;
+	}
+}
+
+int64 FShooterNetProfiler::EstimatePropertyBits(UProperty* Property, const void* Value)
+{
+	if (Property->IsA(UBoolProperty::StaticClass()))
+	{
+		return 1;
+	}
+
+	if (Property->IsA(UObjectPropertyBase::StaticClass()))
+	{
+		return NetGUIDBits;
+	}
+
+	if (UStrProperty* StrProperty = Cast<UStrProperty>(Property))
+	{
+		return 32 + StrProperty->GetPropertyValue(Value).Len() * 8;
+	}
+
+	if (UNameProperty* NameProperty = Cast<UNameProperty>(Property))
+	{
+		return 32 + NameProperty->GetPropertyValue(Value).ToString().Len() * 8;
+	}
+
+	if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property))
+	{
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+		int64 Bits = 16;
+		for (int32 i = 0; i < ArrayHelper.Num(); i++)
+		{
+			Bits += EstimatePropertyBits(ArrayProperty->Inner, ArrayHelper.GetRawPtr(i));
+		}
+		return Bits;
+	}
+
+	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+	{
+		int64 Bits = 0;
+		for (TFieldIterator<UProperty> It(StructProperty->Struct); It; ++It)
+		{
+			if ((It->PropertyFlags & CPF_RepSkip) == 0)
+			{
+				for (int32 i = 0; i < It->ArrayDim; i++)
+				{
+					Bits += EstimatePropertyBits(*It, It->ContainerPtrToValuePtr<void>(Value, i));
+				}
+			}
+		}
+		return Bits;
+	}
+
+	return Property->ElementSize * 8;
+}
+
+FString FShooterNetProfiler::GetFieldName(const TWeakObjectPtr<UField>& Field)
+{
+	UField* FieldPtr = Field.Get();
+	if (FieldPtr == NULL)
+	{
+		return TEXT("<unloaded>");
+	}
+
+	return FString::Printf(TEXT("%s::%s"), *FieldPtr->GetOuter()->GetName(), *FieldPtr->GetName());
+}
+
+void FShooterNetProfiler::DumpSummary(FOutputDevice& Ar) const
+{
+	const int32 WindowSeconds = FMath::Max(1, GShooterNetProfileWindow);
+	const int64 Second = GetCurrentSecond();
+
+	if (!IsEnabled())
+	{
+		Ar.Logf(TEXT("Shooter net profiler is disabled, set shooter.NetProfile 1 to start collecting."));
+	}
+
+	for (auto ConnIt = Connections.CreateConstIterator(); ConnIt; ++ConnIt)
+	{
+		const FConnectionStats& ConnStats = ConnIt.Value();
+
+		TMap<TWeakObjectPtr<UField>, FStat> WindowStats;
+		for (int32 i = 0; i < ConnStats.Buckets.Num(); i++)
+		{
+			if (ConnStats.Buckets[i].Second <= Second - WindowSeconds)
+			{
+				continue;
+			}
+
+			for (auto StatIt = ConnStats.Buckets[i].Stats.CreateConstIterator(); StatIt; ++StatIt)
+			{
+				FStat& Stat = WindowStats.FindOrAdd(StatIt.Key());
+				Stat.Count += StatIt.Value().Count;
+				Stat.Bits += StatIt.Value().Bits;
+			}
+		}
+
+		WindowStats.ValueSort([](const FStat& A, const FStat& B) { return A.Bits > B.Bits; });
+
+		Ar.Logf(TEXT("Connection %s (%s), last %d seconds:"), *ConnStats.Label, ConnIt.Key().IsValid() ? TEXT("open") : TEXT("closed"), WindowSeconds);
+		for (auto StatIt = WindowStats.CreateConstIterator(); StatIt; ++StatIt)
+		{
+			const FStat& Stat = StatIt.Value();
+			Ar.Logf(TEXT("  %-8s %-48s calls: %6d  bits: %10lld  bits/s: %8.1f"),
+				Cast<UFunction>(StatIt.Key().Get()) ? TEXT("RPC") : TEXT("Property"),
+				*GetFieldName(StatIt.Key()), Stat.Count, Stat.Bits, (float)Stat.Bits / WindowSeconds);
+		}
+	}
+}
+
+FString FShooterNetProfiler::DumpToCSV(const UWorld* World) const
+{
+	if (Connections.Num() == 0)
+	{
+		return FString();
+	}
+
+	FString CSV = TEXT("Connection,Type,Name,Calls,Bits\n");
+	for (auto ConnIt = Connections.CreateConstIterator(); ConnIt; ++ConnIt)
+	{
+		const FConnectionStats& ConnStats = ConnIt.Value();
+		for (auto StatIt = ConnStats.Totals.CreateConstIterator(); StatIt; ++StatIt)
+		{
+			CSV += FString::Printf(TEXT("%s,%s,%s,%d,%lld\n"),
+				*ConnStats.Label.Replace(TEXT(","), TEXT("_")),
+				Cast<UFunction>(StatIt.Key().Get()) ? TEXT("RPC") : TEXT("Property"),
+				*GetFieldName(StatIt.Key()), StatIt.Value().Count, StatIt.Value().Bits);
+		}
+	}
+
+	const FString MapName = World ? World->GetMapName() : TEXT("Unknown");
+	const FString FileName = FPaths::ProfilingDir() / TEXT("NetProfile") / FString::Printf(TEXT("NetProfile-%s-%s.csv"), *MapName, *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringToFile(CSV, *FileName))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to write net profile to %s"), *FileName);
+		return FString();
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Net profile written to %s"), *FileName);
+	return FileName;
+}
+
+void FShooterNetProfiler::Reset()
+{
+	for (auto It = ShadowStates.CreateIterator(); It; ++It)
+	{
+		FreeShadowState(It.Value());
+	}
+
+	ShadowStates.Empty();
+	Connections.Empty();
+	ClassProperties.Empty();
+}
@@ -0,0 +1,136 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Calls"), STAT_ShooterNetRPCCalls, STATGROUP_ShooterNet, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Bits"), STAT_ShooterNetRPCBits, STATGROUP_ShooterNet, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Property Updates"), STAT_ShooterNetPropertyUpdates, STATGROUP_ShooterNet, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Property Bits (estimated)"), STAT_ShooterNetPropertyBits, STATGROUP_ShooterNet, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Window RPC Bits/s"), STAT_ShooterNetWindowRPCBitsPerSec, STATGROUP_ShooterNet, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Window Property Bits/s"), STAT_ShooterNetWindowPropertyBitsPerSec, STATGROUP_ShooterNet, );
+
+/**
+ * Per connection network bandwidth profiler for shooter actors.
+ *
+ * RPC bits are measured from the connection's outgoing data around the call, property bits are
+ * estimated from the wire size of replicated properties that changed since the last PreReplication.
+ * Disabled unless shooter.NetProfile is set, see "shooter.NetProfileDump" for the summary.
+ */
+class FShooterNetProfiler
+{
+public:
+
+	/** call count and size for one RPC or property */
+	struct FStat
+	{
+		int32 Count;
+		int64 Bits;
+
+		FStat() : Count(0), Bits(0) {}
+	};
+
+	/** tracks RPC traffic for the lifetime of the scope */
+	class FRPCScope
+	{
+	public:
+		FRPCScope(AActor* InActor, UFunction* InFunction);
+		~FRPCScope();
+
+	private:
+		struct FConnectionSnapshot
+		{
+			UNetConnection* Connection;
+			int64 SentBits;
+		};
+
+		bool bActive;
+		UFunction* Function;
+		TArray<FConnectionSnapshot, TInlineAllocator<16> > Snapshots;
+	};
+
+	static FShooterNetProfiler& Get();
+
+	/** is profiling turned on? */
+	static bool IsEnabled();
+
+	/** [server] compare replicated properties against what was seen last time and account changes to each connection */
+	void TrackReplicatedProperties(AActor* Actor);
+
+	/** log aggregated stats for the sliding window, per connection */
+	void DumpSummary(FOutputDevice& Ar) const;
+
+	/** write match totals to Saved/Profiling/NetProfile, returns file name or empty string */
+	FString DumpToCSV(const UWorld* World) const;
+
+	/** clear all collected data */
+	void Reset();
+
+private:
+
+	/** one second of traffic for a connection */
+	struct FBucket
+	{
+		int64 Second;
+		TMap<TWeakObjectPtr<UField>, FStat> Stats;
+
+		FBucket() : Second(-1) {}
+	};
+
+	/** all traffic recorded for a connection */
+	struct FConnectionStats
+	{
+		FString Label;
+		TArray<FBucket> Buckets;
+		TMap<TWeakObjectPtr<UField>, FStat> Totals;
+	};
+
+	/** replicated property of a class and its replication condition */
+	struct FReplicatedProperty
+	{
+		UProperty* Property;
+		int32 ArrayIndex;
+		ELifetimeCondition Condition;
+	};
+
+	/** last seen replicated state of an actor */
+	struct FShadowState
+	{
+		UClass* Class;
+		uint8* Data;
+		TSet<TWeakObjectPtr<UNetConnection> > InitializedConnections;
+
+		FShadowState() : Class(NULL), Data(NULL) {}
+	};
+
+	FShooterNetProfiler() : LastPruneSecond(-1) {}
+	~FShooterNetProfiler();
+
+	/** add traffic for a connection to the current bucket and match totals */
+	void Record(UNetConnection* Connection, UField* Field, int32 Count, int64 Bits);
+
+	/** get replicated properties of class, building the list once */
+	const TArray<FReplicatedProperty>& GetReplicatedProperties(AActor* Actor);
+
+	/** destroy shadow state buffer */
+	void FreeShadowState(FShadowState& Shadow);
+
+	/** once per second, drop shadow states of destroyed actors and refresh the window stats; closed connections are kept for the summary and CSV */
+	void Prune();
+
+	/** check if property should be sent to connection */
+	static bool PassesCondition(ELifetimeCondition Condition, bool bInitial, bool bIsOwner);
+
+	/** rough wire size of a property value */
+	static int64 EstimatePropertyBits(UProperty* Property, const void* Value);
+
+	/** name used in logs and CSV for a tracked RPC or property */
+	static FString GetFieldName(const TWeakObjectPtr<UField>& Field);
+
+	TMap<TWeakObjectPtr<UNetConnection>, FConnectionStats> Connections;
+	TMap<UClass*, TArray<FReplicatedProperty> > ClassProperties;
+	TMap<TWeakObjectPtr<AActor>, FShadowState> ShadowStates;
+	int64 LastPruneSecond;
+};
+
+/** measure bits sent by a remote function call for the rest of the scope */
+#define SHOOTER_NET_PROFILE_RPC(Actor, Function) FShooterNetProfiler::FRPCScope ShooterNetRPCScope(Actor, Function)
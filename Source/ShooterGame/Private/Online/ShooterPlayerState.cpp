@@ -1,6 +1,8 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterGame.h"
+#include "Online/ShooterNetProfiler.h"
+#include "ShooterStats.h"
 
 AShooterPlayerState::AShooterPlayerState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -23,6 +25,8 @@ void AShooterPlayerState::Reset()
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
 	bQuitter = false;
+
+	UpdateRanking();
 }
 
 void AShooterPlayerState::UnregisterPlayerWithSession()
@@ -45,11 +49,29 @@ void AShooterPlayerState::SetTeamNum(int32 NewTeamNumber)
 	TeamNumber = NewTeamNumber;
 
 	UpdateTeamColors();
+	UpdateRanking();
 }
 
 void AShooterPlayerState::OnRep_TeamColor()
 {
 	UpdateTeamColors();
+	UpdateRanking();
+}
+
+void AShooterPlayerState::OnRep_Score()
+{
+	Super::OnRep_Score();
+
+	UpdateRanking();
+}
+
+void AShooterPlayerState::UpdateRanking()
+{
+	AShooterGameState* const MyGameState = GetWorld() ? Cast<AShooterGameState>(GetWorld()->GameState) : NULL;
+	if (MyGameState)
+	{
+		MyGameState->UpdatePlayerRanking(this);
+	}
 }
 
 void AShooterPlayerState::AddBulletsFired(int32 NumBullets)
@@ -86,7 +108,7 @@ void AShooterPlayerState::UpdateTeamColors()
 		AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(OwnerController->GetCharacter());
 		if (ShooterCharacter != NULL)
 		{
-			ShooterCharacter->UpdateTeamColorsAllMIDs();
+			ShooterCharacter->UpdateTeamMaterials();
 		}
 	}
 }
@@ -152,6 +174,8 @@ void AShooterPlayerState::ScorePoints(int32 Points)
 	}
 
 	Score += Points;
+
+	UpdateRanking();
 }
 
 void AShooterPlayerState::InformAboutKill_Implementation(class AShooterPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* KilledPlayerState)
@@ -190,6 +214,20 @@ void AShooterPlayerState::BroadcastDeath_Implementation(class AShooterPlayerStat
 	}	
 }
 
+void AShooterPlayerState::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	FShooterNetProfiler::Get().TrackReplicatedProperties(this);
+}
+
+bool AShooterPlayerState::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	SHOOTER_NET_PROFILE_RPC(this, Function);
+	SHOOTER_INC_COUNTER(RPCsSent);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
 void AShooterPlayerState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
 {
 	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
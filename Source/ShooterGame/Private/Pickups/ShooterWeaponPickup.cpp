@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "ShooterGame.h"
+#include "Weapons/ShooterWeaponPool.h"
 
 
 // Sets default values
@@ -23,14 +24,23 @@ void AShooterWeaponPickup::BeginPlay()
 {
 	Super::BeginPlay();
 
-	FActorSpawnParameters SpawnInfo;
-	SpawnInfo.bNoCollisionFail = true;
-
 	/**Spawn weapon to represent this */
-	WeaponPickup = GetWorld()->SpawnActor<AShooterWeapon>(WeaponType, SpawnInfo);
+	WeaponPickup = FShooterWeaponPool::SpawnWeapon(GetWorld(), WeaponType);
 
 }
 
+void AShooterWeaponPickup::Destroyed()
+{
+	Super::Destroyed();
+
+	// weapon wasn't taken, it's not needed anymore
+	if (WeaponPickup)
+	{
+		FShooterWeaponPool::ReleaseWeapon(WeaponPickup);
+		WeaponPickup = NULL;
+	}
+}
+
 // Called every frame
 void AShooterWeaponPickup::Tick( float DeltaTime )
 {
@@ -101,7 +111,8 @@ void AShooterWeaponPickup::Interact(class AActor* Interactor)
 			PickupSpawn = NULL;
 		}
 
-		//this pickup is now gone
+		//this pickup is now gone, the weapon lives on in the pawn's inventory
+		WeaponPickup = NULL;
 		this->Destroy();
 	}
 }
@@ -146,6 +157,11 @@ int32 AShooterWeaponPickup::GetCurrentAmmoInClip() const
 
 void AShooterWeaponPickup::SetWeaponPickup(AShooterWeapon* Weapon)
 {
+	// the weapon spawned for this pickup is replaced by the dropped one
+	if (WeaponPickup && WeaponPickup != Weapon)
+	{
+		FShooterWeaponPool::ReleaseWeapon(WeaponPickup);
+	}
 
 	WeaponPickup = Weapon;
 	
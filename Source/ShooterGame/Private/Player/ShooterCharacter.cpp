@@ -1,6 +1,97 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterGame.h"
+#include "Online/ShooterNetProfiler.h"
+#include "ShooterStats.h"
+#include "Weapons/ShooterWeaponPool.h"
+#include "ShooterPreloadManifest.h"
+#include "Serialization/ArchiveCountMem.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Avg Character Updates/s Saved"), STAT_ShooterNetAvgUpdatesSaved, STATGROUP_ShooterNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Adaptive Characters"), STAT_ShooterNetAdaptiveCharacters, STATGROUP_ShooterNet);
+
+/** sum of updates per second saved by all adaptive characters */
+static float GShooterNetUpdatesSaved = 0.0f;
+
+/** number of characters contributing to GShooterNetUpdatesSaved */
+static int32 GShooterNetAdaptiveCharacters = 0;
+
+int32 GShooterServerLean = 1;
+static FAutoConsoleVariableRef CVarShooterServerLean(
+	TEXT("shooter.ServerLean"),
+	GShooterServerLean,
+	TEXT("Skip cosmetic setup of characters and weapons on dedicated servers: team color materials,\n")
+	TEXT("first person meshes, weapon effects, sounds and animations. Collision and hit detection are not affected.\n")
+	TEXT("Applies to characters and weapons spawned after it is changed.\n")
+	TEXT("Default is 1."),
+	ECVF_Default
+	);
+
+/** time spent in character PostInitializeComponents, including default inventory, indexed by lean mode */
+static double GShooterCharacterSpawnSeconds[2] = { 0.0, 0.0 };
+static int32 GShooterCharacterSpawnCount[2] = { 0, 0 };
+
+/** serialized size of Object and everything inside it */
+static SIZE_T GetObjectSizeWithSubobjects(UObject* Object, int32& OutNumSubobjects)
+{
+	TArray<UObject*> Subobjects;
+	GetObjectsWithOuter(Object, Subobjects, true);
+	OutNumSubobjects = Subobjects.Num();
+
+	SIZE_T Size = FArchiveCountMem(Object).GetMax();
+	for (int32 i = 0; i < Subobjects.Num(); i++)
+	{
+		Size += FArchiveCountMem(Subobjects[i]).GetMax();
+	}
+	return Size;
+}
+
+static void ShooterServerLeanReport(UWorld* World)
+{
+	int32 NumCharacters = 0;
+	int32 NumCharacterSubobjects = 0;
+	SIZE_T CharacterSize = 0;
+	for (TActorIterator<AShooterCharacter> It(World); It; ++It)
+	{
+		int32 NumSubobjects = 0;
+		CharacterSize += GetObjectSizeWithSubobjects(*It, NumSubobjects);
+		NumCharacterSubobjects += NumSubobjects;
+		NumCharacters++;
+	}
+
+	int32 NumWeapons = 0;
+	int32 NumWeaponSubobjects = 0;
+	SIZE_T WeaponSize = 0;
+	for (TActorIterator<AShooterWeapon> It(World); It; ++It)
+	{
+		int32 NumSubobjects = 0;
+		WeaponSize += GetObjectSizeWithSubobjects(*It, NumSubobjects);
+		NumWeaponSubobjects += NumSubobjects;
+		NumWeapons++;
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Server lean %s, net mode %d"), GShooterServerLean ? TEXT("on") : TEXT("off"), (int32)World->GetNetMode());
+	UE_LOG(LogShooter, Log, TEXT("  %d characters, %.1f KB and %.1f subobjects each"),
+		NumCharacters, NumCharacters ? CharacterSize / 1024.0 / NumCharacters : 0.0, NumCharacters ? (float)NumCharacterSubobjects / NumCharacters : 0.0f);
+	UE_LOG(LogShooter, Log, TEXT("  %d weapons, %.1f KB and %.1f subobjects each"),
+		NumWeapons, NumWeapons ? WeaponSize / 1024.0 / NumWeapons : 0.0, NumWeapons ? (float)NumWeaponSubobjects / NumWeapons : 0.0f);
+
+	for (int32 Lean = 0; Lean < 2; Lean++)
+	{
+		if (GShooterCharacterSpawnCount[Lean] > 0)
+		{
+			UE_LOG(LogShooter, Log, TEXT("  %s character spawn: %.3f ms average over %d spawns"), Lean ? TEXT("lean") : TEXT("full"),
+				GShooterCharacterSpawnSeconds[Lean] * 1000.0 / GShooterCharacterSpawnCount[Lean], GShooterCharacterSpawnCount[Lean]);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorld CmdShooterServerLeanReport(
+	TEXT("shooter.ServerLeanReport"),
+	TEXT("Log memory per character and weapon and average character spawn cost, with and without shooter.ServerLean.\n")
+	TEXT("Sizes are serialized sizes of the actors and their subobjects."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(ShooterServerLeanReport)
+	);
 
 AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UShooterCharacterMovement>(ACharacter::CharacterMovementComponentName))
@@ -18,6 +109,8 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	Mesh1P->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	Mesh1P->SetCollisionResponseToAllChannels(ECR_Ignore);
 
+	InteractionComp = ObjectInitializer.CreateDefaultSubobject<UShooterInteractionComponent>(this, TEXT("InteractionComp"));
+
 	GetMesh()->bOnlyOwnerSee = false;
 	GetMesh()->bOwnerNoSee = true;
 	GetMesh()->bReceivesDecals = false;
@@ -66,12 +159,63 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	LungeActor = NULL;
 
 	Shields = NULL;
+
+	bAdaptiveNetUpdateFrequency = true;
+	MaxNetUpdateFrequency = 0.0f;
+	MinNetUpdateFrequency = 10.0f;
+	IdleNetUpdateFrequency = 30.0f;
+	NearNetViewerDistance = 2000.0f;
+	FarNetViewerDistance = 8000.0f;
+	NetActivityHoldTime = 2.0f;
+	ActiveNetPriorityScale = 2.0f;
+	NetUpdateFrequencyInterval = 0.25f;
+	LastNetActivityTime = -1000.0f;
+	LastNetUpdateFrequencyTime = 0.0f;
+	ReportedNetUpdatesSaved = -1.0f;
+	Mesh1PBaseMaterial = NULL;
+	bServerLean = false;
+}
+
+void AShooterCharacter::PostLoad()
+{
+	Super::PostLoad();
+
+	// defaults saved while the weapon classes were hard references
+	if (DefaultInventoryAssets.Num() == 0)
+	{
+		for (int32 i = 0; i < DefaultInventoryClasses_DEPRECATED.Num(); i++)
+		{
+			TAssetSubclassOf<AShooterWeapon>& WeaponAsset = DefaultInventoryAssets[DefaultInventoryAssets.AddDefaulted()];
+			FShooterPreloadManifest::MigrateClass(DefaultInventoryClasses_DEPRECATED[i], WeaponAsset);
+		}
+	}
+	DefaultInventoryClasses_DEPRECATED.Empty();
+
+	FShooterPreloadManifest::MigrateClass(Melee_DEPRECATED, MeleeAsset);
+	FShooterPreloadManifest::MigrateClass(FragGrenade_DEPRECATED, FragGrenadeAsset);
+	FShooterPreloadManifest::MigrateClass(StickyGrenade_DEPRECATED, StickyGrenadeAsset);
 }
 
 void AShooterCharacter::PostInitializeComponents()
 {
+	const double SpawnStartTime = FPlatformTime::Seconds();
+
 	Super::PostInitializeComponents();
 
+	// Blueprint defaults are applied after the constructor, take the ceiling from the class' tuned rate
+	if (MaxNetUpdateFrequency <= 0.0f)
+	{
+		MaxNetUpdateFrequency = NetUpdateFrequency;
+	}
+
+	bServerLean = IsServerLean(this);
+	if (bServerLean)
+	{
+		// first person mesh is only ever seen by the owning client
+		Mesh1P->SetComponentTickEnabled(false);
+		Mesh1P->bNoSkeletonUpdate = true;
+	}
+
 	if (Role == ROLE_Authority)
 	{
 		Health = GetMaxHealth();
@@ -87,12 +231,19 @@ void AShooterCharacter::PostInitializeComponents()
 
 	// set initial mesh visibility (3rd person view)
 	UpdatePawnMeshes();
+
+	// resolve hit zone bones once, damage only needs the body index of the hit after this
+	HitZoneBodyTable = GetHitZones()->GetBodyTable(GetMesh()->GetPhysicsAsset());
 	
-	// create material instance for setting team colors (3rd person view)
-	for (int32 iMat = 0; iMat < GetMesh()->GetNumMaterials(); iMat++)
+	// remember materials to color, team colored instances are shared through the game state
+	if (!bServerLean)
 	{
-		MeshMIDs.Add(GetMesh()->CreateAndSetMaterialInstanceDynamic(iMat));
-	} 
+		for (int32 iMat = 0; iMat < GetMesh()->GetNumMaterials(); iMat++)
+		{
+			MeshBaseMaterials.Add(GetMesh()->GetMaterial(iMat));
+		}
+		Mesh1PBaseMaterial = Mesh1P->GetMaterial(0);
+	}
 
 	// play respawn effects
 	if (GetNetMode() != NM_DedicatedServer)
@@ -107,6 +258,34 @@ void AShooterCharacter::PostInitializeComponents()
 			UGameplayStatics::PlaySoundAtLocation(this, RespawnSound, GetActorLocation());
 		}
 	}
+
+	GShooterCharacterSpawnSeconds[bServerLean ? 1 : 0] += FPlatformTime::Seconds() - SpawnStartTime;
+	GShooterCharacterSpawnCount[bServerLean ? 1 : 0]++;
+}
+
+bool AShooterCharacter::IsServerLean(const AActor* Actor)
+{
+	return GShooterServerLean != 0 && Actor->GetNetMode() == NM_DedicatedServer;
+}
+
+void AShooterCharacter::GetWeaponAssets(TArray<FStringAssetReference>& OutAssets) const
+{
+	for (int32 i = 0; i < DefaultInventoryAssets.Num(); i++)
+	{
+		if (!DefaultInventoryAssets[i].IsNull())
+		{
+			OutAssets.AddUnique(DefaultInventoryAssets[i].ToStringReference());
+		}
+	}
+
+	const TAssetSubclassOf<AShooterWeapon>* ExtraWeapons[] = { &MeleeAsset, &FragGrenadeAsset, &StickyGrenadeAsset };
+	for (int32 i = 0; i < ARRAY_COUNT(ExtraWeapons); i++)
+	{
+		if (!ExtraWeapons[i]->IsNull())
+		{
+			OutAssets.AddUnique(ExtraWeapons[i]->ToStringReference());
+		}
+	}
 }
 
 void AShooterCharacter::Destroyed()
@@ -126,8 +305,7 @@ void AShooterCharacter::PawnClientRestart()
 	SetCurrentWeapon(CurrentWeapon);
 
 	// set team colors for 1st person view
-	UMaterialInstanceDynamic* Mesh1PMID = Mesh1P->CreateAndSetMaterialInstanceDynamic(0);
-	UpdateTeamColors(Mesh1PMID);
+	UpdateTeamMaterials();
 }
 
 void AShooterCharacter::PossessedBy(class AController* InController)
@@ -135,7 +313,7 @@ void AShooterCharacter::PossessedBy(class AController* InController)
 	Super::PossessedBy(InController);
 
 	// [server] as soon as PlayerState is assigned, set team colors of this pawn for local player
-	UpdateTeamColorsAllMIDs();
+	UpdateTeamMaterials();
 }
 
 void AShooterCharacter::OnRep_PlayerState()
@@ -145,7 +323,7 @@ void AShooterCharacter::OnRep_PlayerState()
 	// [client] as soon as PlayerState is assigned, set team colors of this pawn for local player
 	if (PlayerState != NULL)
 	{
-		UpdateTeamColorsAllMIDs();
+		UpdateTeamMaterials();
 	}
 }
 
@@ -262,6 +440,7 @@ bool AShooterCharacter::ServerStartLunge_Validate(AShooterWeapon* LungingWeapon)
 //John
 void AShooterCharacter::Lunge()
 {
+	NotifyNetActivity();
 
 	LungeStartLocation = GetActorLocation();
 	if (LungeActor)
@@ -428,23 +607,6 @@ FVector AShooterCharacter::GetCameraStartLocation(const FVector& AimDir) const
 	return OutStartTrace;
 }
 
-//John
-/** find what object the player has interacted with */
-FHitResult AShooterCharacter::InteractTrace(const FVector& StartTrace, const FVector& EndTrace) const
-{
-	static FName InteractTag = FName(TEXT("InteractTrace"));
-
-	// Perform trace to retrieve hit info
-	FCollisionQueryParams TraceParams(InteractTag, true, this);
-	TraceParams.bTraceAsyncScene = true;
-	TraceParams.bReturnPhysicalMaterial = true;
-
-	FHitResult Hit(ForceInit);
-	GetWorld()->LineTraceSingle(Hit, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams);
-
-	return Hit;
-}
-
 bool AShooterCharacter::IsEnemyFor(AController* TestPC) const
 {
 	if (TestPC == Controller || TestPC == NULL)
@@ -476,24 +638,39 @@ void AShooterCharacter::UpdatePawnMeshes()
 {
 	bool const bFirstPerson = IsFirstPerson();
 
-	Mesh1P->MeshComponentUpdateFlag = !bFirstPerson ? EMeshComponentUpdateFlag::OnlyTickPoseWhenRendered : EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones;
-	Mesh1P->SetOwnerNoSee(!bFirstPerson);
+	if (!bServerLean)
+	{
+		Mesh1P->MeshComponentUpdateFlag = !bFirstPerson ? EMeshComponentUpdateFlag::OnlyTickPoseWhenRendered : EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones;
+		Mesh1P->SetOwnerNoSee(!bFirstPerson);
+	}
 
+	// 3rd person pose is needed on the server too, hit zones are looked up by bone
 	GetMesh()->MeshComponentUpdateFlag = bFirstPerson ? EMeshComponentUpdateFlag::OnlyTickPoseWhenRendered : EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones;
 	GetMesh()->SetOwnerNoSee(bFirstPerson);
 }
 
-void AShooterCharacter::UpdateTeamColors(UMaterialInstanceDynamic* UseMID)
+void AShooterCharacter::UpdateTeamMaterials()
 {
-	if (UseMID)
+	AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(PlayerState);
+	AShooterGameState* MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyPlayerState == NULL || MyGameState == NULL)
 	{
-		AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(PlayerState);
-		if (MyPlayerState != NULL)
+		return;
+	}
+
+	const int32 TeamNum = MyPlayerState->GetTeamNum();
+	for (int32 iMat = 0; iMat < MeshBaseMaterials.Num(); iMat++)
+	{
+		if (MeshBaseMaterials[iMat])
 		{
-			float MaterialParam = (float)MyPlayerState->GetTeamNum();
-			UseMID->SetScalarParameterValue(TEXT("Team Color Index"), MaterialParam);
+			GetMesh()->SetMaterial(iMat, MyGameState->GetTeamMaterial(MeshBaseMaterials[iMat], TeamNum));
 		}
 	}
+
+	if (Mesh1PBaseMaterial)
+	{
+		Mesh1P->SetMaterial(0, MyGameState->GetTeamMaterial(Mesh1PBaseMaterial, TeamNum));
+	}
 }
 
 void AShooterCharacter::OnCameraUpdate(const FVector& CameraLocation, const FRotator& CameraRotation)
@@ -587,17 +764,38 @@ bool AShooterCharacter::ShieldsDown()
 /**Check whether or not this actor can headshot.*/
 bool AShooterCharacter::CanHeadshot(class AActor* DamageCauser)
 {
-	//Get headshot tag from Actor
-	char* HeadshotStr = "Headshot";
-
 	//BOOM HEADSHOT
-	FName Headshot = FName(HeadshotStr);
+	static const FName HeadshotTag(TEXT("Headshot"));
 
-	return DamageCauser->ActorHasTag(Headshot);
+	return DamageCauser->ActorHasTag(HeadshotTag);
+}
+
+const UShooterHitZones* AShooterCharacter::GetHitZones() const
+{
+	return HitZones ? HitZones : GetDefault<UShooterHitZones>();
+}
+
+EShooterHitZone::Type AShooterCharacter::GetHitZone(const FHitResult& Hit, float* OutDamageMultiplier) const
+{
+	const FShooterHitZoneBody* Body = NULL;
+	// Item of a skeletal mesh hit is the index of the physics body that was hit
+	if (Hit.Component.Get() == GetMesh() && HitZoneBodyTable.IsValidIndex(Hit.Item))
+	{
+		Body = GetHitZones()->GetBody(HitZoneBodyTable[Hit.Item]);
+	}
+
+	if (OutDamageMultiplier)
+	{
+		*OutDamageMultiplier = Body ? Body->DamageMultiplier : 1.0f;
+	}
+
+	return Body ? Body->Zone.GetValue() : EShooterHitZone::None;
 }
 
 float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, class AActor* DamageCauser)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(CharacterTakeDamage);
+
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	if (MyPC && MyPC->HasGodMode())
 	{
@@ -609,6 +807,20 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 		return 0.f;
 	}
 
+	FHitResult ThisHit;
+	FVector ThisHitVector;
+
+	//Get Hit Info from the damage event
+	DamageEvent.GetBestHitInfo(this, EventInstigator, ThisHit, ThisHitVector);
+
+	// Scale point damage by the zone that was hit
+	float ZoneDamageMultiplier = 1.0f;
+	const EShooterHitZone::Type HitZone = GetHitZone(ThisHit, &ZoneDamageMultiplier);
+	if (DamageEvent.IsOfType(FPointDamageEvent::ClassID))
+	{
+		Damage *= ZoneDamageMultiplier;
+	}
+
 	// Modify based on game rules.
 	AShooterGameMode* const Game = GetWorld()->GetAuthGameMode<AShooterGameMode>();
 	Damage = Game ? Game->ModifyDamage(Damage, this, DamageEvent, EventInstigator, DamageCauser) : 0.f;
@@ -619,12 +831,6 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 	if (ActualDamage > 0.f)
 	{
 		Health -= ActualDamage;
-		
-		FHitResult ThisHit;
-		FVector ThisHitVector;
-
-		//Get Hit Info from the damage event
-		DamageEvent.GetBestHitInfo(this, EventInstigator, ThisHit, ThisHitVector);
 
 		AShooterWeapon* DamageCauserWeapon = Cast<AShooterWeapon>(DamageCauser);
 
@@ -636,7 +842,7 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 			if (ShieldsDown() && DamageCauserWeapon->CanHeadshot())//CanHeadshot(DamageCauser))
 			{
 				//If the pawn was hit in the head
-				if (ThisHit.BoneName.ToString() == "head" || ThisHit.BoneName.ToString() == "neck_01")
+				if (HitZone == EShooterHitZone::Head)
 				{
 					//Dead
 					Health = 0;
@@ -644,7 +850,7 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 			}
 
 			//Check for assassination
-			if (DamageCauserWeapon->CanAssassinate() && FVector::Coincident(ThisHitVector, GetCameraAim(), .5) && (ThisHit.BoneName.ToString() == "b_neck" || ThisHit.BoneName.ToString() == "b_spine1" || ThisHit.BoneName.ToString() == "b_spine"))
+			if (DamageCauserWeapon->CanAssassinate() && HitZone == EShooterHitZone::Back && FVector::Coincident(ThisHitVector, GetCameraAim(), .5))
 			{
 				Health = 0;
 			}
@@ -793,7 +999,8 @@ bool AShooterCharacter::Die(float KillingDamage, FDamageEvent const& DamageEvent
 	AController* const KilledPlayer = (Controller != NULL) ? Controller : Cast<AController>(GetOwner());
 	GetWorld()->GetAuthGameMode<AShooterGameMode>()->Killed(Killer, KilledPlayer, this, DamageType);
 
-	NetUpdateFrequency = GetDefault<AShooterCharacter>()->NetUpdateFrequency;
+	NetUpdateFrequency = MaxNetUpdateFrequency;
+	ReportNetUpdatesSaved(-1.0f);
 	GetCharacterMovement()->ForceReplicationUpdate();
 
 	////John
@@ -1024,6 +1231,8 @@ void AShooterCharacter::ReplicateHit(float Damage, struct FDamageEvent const& Da
 	LastTakeHitInfo.EnsureReplication();
 
 	LastTakeHitTimeTimeout = TimeoutTime;
+
+	NotifyNetActivity();
 }
 
 void AShooterCharacter::OnRep_LastTakeHitInfo()
@@ -1069,7 +1278,7 @@ void AShooterCharacter::DropWeapon()
 				FRotator NewRotator = GetActorRotation() + FRotator(0.f, -135.f, 0.f);
 
 				//Spawn new weapon pickup to match removed weapon
-				AShooterWeaponPickup* NewPickup = GetWorld()->SpawnActor<AShooterWeaponPickup>(RemovedWeapon->WeaponPickup, NewLocation, NewRotator, SpawnInfo);
+				AShooterWeaponPickup* NewPickup = GetWorld()->SpawnActor<AShooterWeaponPickup>(RemovedWeapon->GetWeaponPickupClass(), NewLocation, NewRotator, SpawnInfo);
 
 				NewPickup->SetWeaponPickup(RemovedWeapon);
 
@@ -1094,54 +1303,17 @@ void AShooterCharacter::DropWeapon()
 }
 
 //John
-/** Check if the player can interact with an object
- *	You should figure out a way around this
- *	redundance.
- *	Perhaps a method called CanInteractWith(), that returns
- *	the object that you can interact with. Or as an out parameter.
- */
+/** Check if the player can interact with an object */
 bool AShooterCharacter::CanInteract(AActor** OutObject) const
 {
+	AActor* InteractableObject = InteractionComp ? InteractionComp->GetFocusedActor() : NULL;
 
-	/**Get what the player is pointing at*/
-	const FVector AimDir = GetCameraAim();
-	const FVector StartTrace = GetCameraStartLocation(AimDir);
-	const FVector EndTrace = StartTrace + AimDir * InteractRange;
-	const FHitResult Interaction = InteractTrace(StartTrace, EndTrace);
-
-	/*The object the player is pointing at*/
-	AActor* InteractableObject = Interaction.GetActor();
-
-	*OutObject = InteractableObject;
-
-	if (InteractableObject && InteractableObject->ActorHasTag(FName(TEXT("Interact"))))
+	if (OutObject)
 	{
-		return true;
+		*OutObject = InteractableObject;
 	}
 
-	/*Get all objects the player is standing on.*/
-	TArray<class AActor*> ProximityInteractableObjects;
-
-	GetOverlappingActors(ProximityInteractableObjects);
-
-	if (ProximityInteractableObjects.Num() > 0)
-	{
-		InteractableObject = ProximityInteractableObjects[0];
-	}
-
-	/*if (GEngine)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Yellow, FString::FromInt(ProximityInteractableObjects.Num()));
-	}*/
-
-	*OutObject = InteractableObject;
-
-	if (InteractableObject && InteractableObject->ActorHasTag(FName(TEXT("Interact"))))
-	{
-		return true;
-	}
-
-	return false;
+	return InteractableObject != NULL;
 }
 
 //John
@@ -1150,61 +1322,22 @@ void AShooterCharacter::Interact()
 {
 	if (Role == ROLE_Authority)
 	{
-		/**Get what the player is pointing at*/
-		const FVector AimDir = GetCameraAim();
-		const FVector StartTrace = GetCameraStartLocation(AimDir);
-		const FVector EndTrace = StartTrace + AimDir * InteractRange;
-		const FHitResult Interaction = InteractTrace(StartTrace, EndTrace);
-
-		/*The object the player is pointing at*/
-		AActor* InteractedObject = Interaction.GetActor();
-
-		/**If the object the player is pointing at is interactable*/
-		if (InteractedObject && InteractedObject->ActorHasTag(FName(TEXT("Interact"))))
+		/** validate the request against the replicated view, focus of remote players isn't tracked on the server */
+		if (IsLocallyControlled())
 		{
-			FPointDamageEvent PointDmg;
-			PointDmg.DamageTypeClass = NULL;
-			PointDmg.HitInfo = Interaction;
-			PointDmg.ShotDirection = FVector(0.0);
-			PointDmg.Damage = 0.0;
-
-			APlayerController* PC = Cast<APlayerController>(Controller);
-
-			/**Call TakeDamage with 0 damage,
-			which will serve as an interaction
-			Consider trying to find a different function
-			to perform interaction
-
-			in this case, TakeDamage will place
-			the weapon in the user's inventory*/
-			InteractedObject->TakeDamage(0.0, PointDmg, PC, this);
-			return;
+			InteractionComp->ConditionalRefreshFocus();
 		}
-
-		/**	If the function hasn't returned yet, that means the player wasn't pointing at an interactable object.
-		 *	Now we will detect proximity interactable objects
-		 */
-
-		TArray<class AActor*> ProximityInteractableObjects;
-
-		/*Get all objects the player is standing on.*/
-		GetOverlappingActors(ProximityInteractableObjects);
-
-		if (ProximityInteractableObjects.Num() > 0)
+		else
 		{
-			InteractedObject = ProximityInteractableObjects[0];
+			InteractionComp->RefreshFocus();
 		}
 
-		/*if (GEngine)
-		{
-		GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Yellow, FString::FromInt(ProximityInteractableObjects.Num()));
-		}*/
-
-		if (InteractedObject && InteractedObject->ActorHasTag(FName(TEXT("Interact"))))
+		AActor* InteractedObject = InteractionComp->GetFocusedActor();
+		if (InteractedObject)
 		{
 			FPointDamageEvent PointDmg;
 			PointDmg.DamageTypeClass = NULL;
-			PointDmg.HitInfo = Interaction;
+			PointDmg.HitInfo = InteractionComp->GetFocusHit();
 			PointDmg.ShotDirection = FVector(0.0);
 			PointDmg.Damage = 0.0;
 
@@ -1218,9 +1351,12 @@ void AShooterCharacter::Interact()
 			in this case, TakeDamage will place
 			the weapon in the user's inventory*/
 			InteractedObject->TakeDamage(0.0, PointDmg, PC, this);
+
+			/** object may be gone now, look again next time */
+			InteractionComp->RefreshFocus();
 		}
 	}
-	else
+	else if (CanInteract())
 	{
 		ServerInteract();
 	}
@@ -1267,47 +1403,17 @@ int32 AShooterCharacter::GetMaxInventory()
 
 bool AShooterCharacter::InventoryFull()
 {
-
-	int32 NumWeapons = 0;
-
-	for (int32 i = 0; i < Inventory.Num(); i++)
-	{
-		if (!Inventory[i]->IsExtraWeapon())
-		{
-			NumWeapons++;
-		}
-	}
-
-	return NumWeapons >= GetMaxInventory();
+	return Inventory.GetNumPrimaryWeapons() >= GetMaxInventory();
 }
 
 bool AShooterCharacter::InventoryEmpty()
 {
-	int32 NumWeapons = 0;
-
-	for (int32 i = 0; i < Inventory.Num(); i++)
-	{
-		if (!Inventory[i]->IsExtraWeapon())
-		{
-			return false;
-		}
-	}
-
-	return true;
+	return Inventory.GetNumPrimaryWeapons() == 0;
 }
 
 int AShooterCharacter::NumPrimaryWeapons()
 {
-	int32 NumWeapons = 0;
-	for (int32 i = 0; i < Inventory.Num(); i++)
-	{
-		if (!Inventory[i]->IsExtraWeapon())
-		{
-			NumWeapons++;
-		}
-	}
-
-	return NumWeapons++;
+	return Inventory.GetNumPrimaryWeapons();
 }
 
 
@@ -1318,15 +1424,14 @@ void AShooterCharacter::SpawnDefaultInventory()
 		return;
 	}
 
-	int32 NumWeaponClasses = DefaultInventoryClasses.Num();
+	int32 NumWeaponClasses = DefaultInventoryAssets.Num();
 	
 	for (int32 i = 0; i < NumWeaponClasses; i++)
 	{
-		if (DefaultInventoryClasses[i])
+		UClass* WeaponClass = FShooterPreloadManifest::ResolveClass(DefaultInventoryAssets[i]);
+		if (WeaponClass)
 		{
-			FActorSpawnParameters SpawnInfo;
-			SpawnInfo.bNoCollisionFail = true;
-			AShooterWeapon* NewWeapon = GetWorld()->SpawnActor<AShooterWeapon>(DefaultInventoryClasses[i], SpawnInfo);
+			AShooterWeapon* NewWeapon = FShooterWeaponPool::SpawnWeapon(GetWorld(), WeaponClass);
 			AddWeapon(NewWeapon);
 
 		}
@@ -1336,7 +1441,7 @@ void AShooterCharacter::SpawnDefaultInventory()
 	// equip first weapon in inventory
 	if (Inventory.Num() > 0)
 	{
-		EquipWeapon(Inventory[0]);
+		EquipWeapon(Inventory.GetWeaponInSlot(0));
 	}
 }
 
@@ -1357,14 +1462,14 @@ void AShooterCharacter::DestroyInventory()
 		return;
 	}
 
-	// remove all weapons from inventory and destroy them
+	// remove all weapons from inventory and hand them back to the weapon pool
 	for (int32 i = Inventory.Num() - 1; i >= 0; i--)
 	{
-		AShooterWeapon* Weapon = Inventory[i];
+		AShooterWeapon* Weapon = Inventory.GetWeapon(i);
 		if (Weapon)
 		{
 			RemoveWeapon(Weapon);
-			Weapon->Destroy();
+			FShooterWeaponPool::ReleaseWeapon(Weapon);
 		}
 	}
 }
@@ -1374,7 +1479,7 @@ void AShooterCharacter::AddWeapon(AShooterWeapon* Weapon)
 	if (Weapon && Role == ROLE_Authority)
 	{
 		Weapon->OnEnterInventory(this);
-		Inventory.AddUnique(Weapon);
+		Inventory.Add(Weapon);
 	}
 }
 
@@ -1383,21 +1488,13 @@ void AShooterCharacter::RemoveWeapon(AShooterWeapon* Weapon)
 	if (Weapon && Role == ROLE_Authority)
 	{
 		Weapon->OnLeaveInventory();
-		Inventory.RemoveSingle(Weapon);
+		Inventory.Remove(Weapon);
 	}
 }
 
 AShooterWeapon* AShooterCharacter::FindWeapon(TSubclassOf<AShooterWeapon> WeaponClass)
 {
-	for (int32 i = 0; i < Inventory.Num(); i++)
-	{
-		if (Inventory[i] && Inventory[i]->IsA(WeaponClass))
-		{
-			return Inventory[i];
-		}
-	}
-
-	return NULL;
+	return Inventory.Find(WeaponClass);
 }
 
 void AShooterCharacter::EquipWeapon(AShooterWeapon* Weapon)
@@ -1603,13 +1700,14 @@ bool AShooterCharacter::InventoryOffCooldown(bool bExceptCurrent) const
 
 	for (int i = 0; i < InvCount; i++)
 	{
-		if (Inventory[i])
+		const AShooterWeapon* Weapon = Inventory.GetWeapon(i);
+		if (Weapon)
 		{
-			if (bExceptCurrent && Inventory[i] == CurrentWeapon)
+			if (bExceptCurrent && Weapon == CurrentWeapon)
 			{
 				continue;
 			}
-			else if (!Inventory[i]->OffCooldown())
+			else if (!Weapon->OffCooldown())
 			{
 				return false;
 			}
@@ -1925,8 +2023,13 @@ void AShooterCharacter::OnNextWeapon()
 	{
 		if (Inventory.Num() >= 2)// && (CurrentWeapon == NULL || CurrentWeapon->GetCurrentState() != EWeaponState::Equipping))
 		{
-			const int32 CurrentWeaponIdx = Inventory.IndexOfByKey(CurrentWeapon);
-			AShooterWeapon* NextWeapon = Inventory[(CurrentWeaponIdx + 1) % Inventory.Num()];
+			const int32 NumSlots = Inventory.GetNumSlots();
+			const int32 CurrentSlot = Inventory.GetSlotIndex(CurrentWeapon);
+			AShooterWeapon* NextWeapon = NULL;
+			for (int32 i = 1; i <= NumSlots && NextWeapon == NULL; i++)
+			{
+				NextWeapon = Inventory.GetWeaponInSlot((CurrentSlot + i) % NumSlots);
+			}
 			EquipWeapon(NextWeapon);
 		}
 	}
@@ -1939,8 +2042,13 @@ void AShooterCharacter::OnPrevWeapon()
 	{
 		if (Inventory.Num() >= 2)// && (CurrentWeapon == NULL || CurrentWeapon->GetCurrentState() != EWeaponState::Equipping))
 		{
-			const int32 CurrentWeaponIdx = Inventory.IndexOfByKey(CurrentWeapon);
-			AShooterWeapon* PrevWeapon = Inventory[(CurrentWeaponIdx - 1 + Inventory.Num()) % Inventory.Num()];
+			const int32 NumSlots = Inventory.GetNumSlots();
+			const int32 CurrentSlot = FMath::Max(0, Inventory.GetSlotIndex(CurrentWeapon));
+			AShooterWeapon* PrevWeapon = NULL;
+			for (int32 i = 1; i <= NumSlots && PrevWeapon == NULL; i++)
+			{
+				PrevWeapon = Inventory.GetWeaponInSlot((CurrentSlot - i + NumSlots) % NumSlots);
+			}
 			EquipWeapon(PrevWeapon);
 		}
 	}
@@ -1969,22 +2077,27 @@ void AShooterCharacter::OnSwitchWeapon()
 	{
 		if (Inventory.Num() >= 2)// && (CurrentWeapon == NULL || CurrentWeapon->GetCurrentState() != EWeaponState::Equipping))
 		{
-			int32 CurrentWeaponIdx = Inventory.IndexOfByKey(CurrentWeapon);
 			//AShooterWeapon* NextWeapon = Inventory[(CurrentWeaponIdx = CurrentWeaponIdx + 1) % Inventory.Num()];
 
 			AShooterWeapon* NextWeapon = NULL;
 
-			for (int i = 0; i < Inventory.Num(); i++)
+			for (int i = 0; i < Inventory.GetNumSlots(); i++)
 			{
-				if (!Inventory[i]->IsExtraWeapon() && Inventory[i] != CurrentWeapon)
+				AShooterWeapon* SlotWeapon = Inventory.GetWeaponInSlot(i);
+				if (SlotWeapon == NULL)
+				{
+					continue;
+				}
+
+				if (!SlotWeapon->IsExtraWeapon() && SlotWeapon != CurrentWeapon)
 				{
-					NextWeapon = Inventory[i];
+					NextWeapon = SlotWeapon;
 					break;
 				}
 				
-				if (Inventory[i] == CurrentWeapon && NumPrimaryWeapons() == 1)
+				if (SlotWeapon == CurrentWeapon && NumPrimaryWeapons() == 1)
 				{
-					NextWeapon = Inventory[i];
+					NextWeapon = SlotWeapon;
 					break;
 				}
 			}
@@ -2005,7 +2118,7 @@ void AShooterCharacter::OnSwitchWeapon()
 			}
 			else
 			{
-				EquipWeapon(FindWeapon(Melee));
+				EquipWeapon(FindWeapon(FShooterPreloadManifest::ResolveClass(MeleeAsset)));
 			}
 
 			//while (!NextWeapon->IsEquippable())
@@ -2028,7 +2141,7 @@ void AShooterCharacter::OnDropWeapon()
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	if (MyPC && MyPC->IsGameInputAllowed())
 	{
-		if (CurrentWeapon && CurrentWeapon->WeaponPickup && CurrentWeapon->IsDroppable() && !InventoryEmpty())//&& CurrentWeapon->GetCurrentState() != EWeaponState::Equipping)
+		if (CurrentWeapon && !CurrentWeapon->WeaponPickupAsset.IsNull() && CurrentWeapon->IsDroppable() && !InventoryEmpty())//&& CurrentWeapon->GetCurrentState() != EWeaponState::Equipping)
 		{
 			DropWeapon();
 		}
@@ -2050,11 +2163,7 @@ void AShooterCharacter::OnThrowFragGrenade()
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	if (MyPC && MyPC->IsGameInputAllowed())
 	{
-		AShooterWeapon* FragGrenadeWeapon = NULL;
-		if (FragGrenade)
-		{
-			FragGrenadeWeapon = FindWeapon(FragGrenade);
-		}
+		AShooterWeapon* FragGrenadeWeapon = FindWeapon(FShooterPreloadManifest::ResolveClass(FragGrenadeAsset));
 
 		if (FragGrenadeWeapon && FragGrenadeWeapon->GetCurrentAmmo() > 0)
 		{
@@ -2077,11 +2186,7 @@ void AShooterCharacter::OnThrowStickyGrenade()
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	if (MyPC && MyPC->IsGameInputAllowed())
 	{
-		AShooterWeapon* StickyGrenadeWeapon = NULL;
-		if (StickyGrenade)
-		{
-			StickyGrenadeWeapon = FindWeapon(StickyGrenade);
-		}
+		AShooterWeapon* StickyGrenadeWeapon = FindWeapon(FShooterPreloadManifest::ResolveClass(StickyGrenadeAsset));
 
 		if (StickyGrenadeWeapon && StickyGrenadeWeapon->GetCurrentAmmo() > 0)
 		{
@@ -2099,11 +2204,7 @@ void AShooterCharacter::OnMelee()
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	if (MyPC && MyPC->IsGameInputAllowed())
 	{
-		AShooterWeapon* MeleeWeapon = NULL;
-		if (Melee)
-		{
-			MeleeWeapon = FindWeapon(Melee);
-		}
+		AShooterWeapon* MeleeWeapon = FindWeapon(FShooterPreloadManifest::ResolveClass(MeleeAsset));
 
 		if (MeleeWeapon && MeleeWeapon->GetCurrentAmmo() > 0 && !bLunging)
 		{
@@ -2224,10 +2325,22 @@ bool AShooterCharacter::IsRunning() const
 //This function is called on every frame.
 void AShooterCharacter::Tick(float DeltaSeconds)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(CharacterTick);
+
 	Super::Tick(DeltaSeconds);
 
 	CheckLungeFinished();
 
+	if (bAdaptiveNetUpdateFrequency && Role == ROLE_Authority && !bIsDying && GetNetMode() != NM_Standalone)
+	{
+		const float TimeSeconds = GetWorld()->GetTimeSeconds();
+		if (TimeSeconds - LastNetUpdateFrequencyTime >= NetUpdateFrequencyInterval)
+		{
+			LastNetUpdateFrequencyTime = TimeSeconds;
+			UpdateNetUpdateFrequency();
+		}
+	}
+
 	/*if (CurrentWeapon && CurrentWeapon->OffCooldown())
 	{
 		if (GEngine)
@@ -2302,6 +2415,15 @@ void AShooterCharacter::PreReplication( IRepChangedPropertyTracker & ChangedProp
 
 	// Only replicate this property for a short duration after it changes so join in progress players don't get spammed with fx when joining late
 	DOREPLIFETIME_ACTIVE_OVERRIDE( AShooterCharacter, LastTakeHitInfo, GetWorld() && GetWorld()->GetTimeSeconds() < LastTakeHitTimeTimeout );
+
+	FShooterNetProfiler::Get().TrackReplicatedProperties(this);
+}
+
+bool AShooterCharacter::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	SHOOTER_NET_PROFILE_RPC(this, Function);
+	SHOOTER_INC_COUNTER(RPCsSent);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
 }
 
 void AShooterCharacter::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
@@ -2326,6 +2448,112 @@ void AShooterCharacter::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	DOREPLIFETIME(AShooterCharacter, LungeActor);
 }
 
+float AShooterCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, InChannel, Time, bLowBandwidth);
+
+	if (bAdaptiveNetUpdateFrequency && !bTearOff && (Viewer == NULL || Viewer->GetPawn() != this))
+	{
+		if (IsNetActive())
+		{
+			Priority *= ActiveNetPriorityScale;
+		}
+		else if ((GetActorLocation() - ViewPos).SizeSquared() > FMath::Square(FarNetViewerDistance))
+		{
+			Priority *= 0.5f;
+		}
+	}
+
+	return Priority;
+}
+
+void AShooterCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReportNetUpdatesSaved(-1.0f);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterCharacter::NotifyNetActivity()
+{
+	if (Role == ROLE_Authority && bAdaptiveNetUpdateFrequency && GetWorld())
+	{
+		const bool bWasActive = IsNetActive();
+		LastNetActivityTime = GetWorld()->GetTimeSeconds();
+
+		// don't wait for the reduced rate to send the change that made us active
+		if (!bWasActive && !bIsDying && NetUpdateFrequency < MaxNetUpdateFrequency)
+		{
+			NetUpdateFrequency = MaxNetUpdateFrequency;
+			ForceNetUpdate();
+		}
+	}
+}
+
+bool AShooterCharacter::IsNetActive() const
+{
+	return GetWorld() && GetWorld()->GetTimeSeconds() - LastNetActivityTime < NetActivityHoldTime;
+}
+
+void AShooterCharacter::UpdateNetUpdateFrequency()
+{
+	if (CurrentWeapon && CurrentWeapon->GetCurrentState() == EWeaponState::Firing)
+	{
+		NotifyNetActivity();
+	}
+
+	float NewFrequency = MaxNetUpdateFrequency;
+	if (!IsNetActive())
+	{
+		// closest view point of any other player
+		float ClosestDistSq = MAX_FLT;
+		const FVector MyLocation = GetActorLocation();
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = *It;
+			const AActor* ViewTarget = PC ? PC->GetViewTarget() : NULL;
+			if (ViewTarget && ViewTarget != this)
+			{
+				ClosestDistSq = FMath::Min(ClosestDistSq, (ViewTarget->GetActorLocation() - MyLocation).SizeSquared());
+			}
+		}
+
+		const float DistanceAlpha = FMath::Clamp(FMath::GetRangePct(NearNetViewerDistance, FarNetViewerDistance, FMath::Sqrt(ClosestDistSq)), 0.0f, 1.0f);
+		NewFrequency = FMath::Lerp(MaxNetUpdateFrequency, MinNetUpdateFrequency, DistanceAlpha);
+
+		if (GetVelocity().IsNearlyZero())
+		{
+			NewFrequency = FMath::Min(NewFrequency, IdleNetUpdateFrequency);
+		}
+
+		NewFrequency = FMath::Clamp(NewFrequency, MinNetUpdateFrequency, MaxNetUpdateFrequency);
+	}
+
+	NetUpdateFrequency = NewFrequency;
+	ReportNetUpdatesSaved(MaxNetUpdateFrequency - NewFrequency);
+}
+
+void AShooterCharacter::ReportNetUpdatesSaved(float NewSaved)
+{
+	// negative value removes the character from the stat
+	if (ReportedNetUpdatesSaved >= 0.0f)
+	{
+		GShooterNetUpdatesSaved -= ReportedNetUpdatesSaved;
+		GShooterNetAdaptiveCharacters--;
+	}
+
+	if (NewSaved >= 0.0f)
+	{
+		GShooterNetUpdatesSaved += NewSaved;
+		GShooterNetAdaptiveCharacters++;
+	}
+
+	ReportedNetUpdatesSaved = NewSaved;
+
+	SET_DWORD_STAT(STAT_ShooterNetAdaptiveCharacters, GShooterNetAdaptiveCharacters);
+	SET_FLOAT_STAT(STAT_ShooterNetAvgUpdatesSaved, GShooterNetAdaptiveCharacters > 0 ? GShooterNetUpdatesSaved / GShooterNetAdaptiveCharacters : 0.0f);
+}
+
 AShooterWeapon* AShooterCharacter::GetWeapon() const
 {
 	return CurrentWeapon;
@@ -2338,7 +2566,12 @@ int32 AShooterCharacter::GetInventoryCount() const
 
 AShooterWeapon* AShooterCharacter::GetInventoryWeapon(int32 index) const
 {
-	return Inventory[index];
+	return Inventory.GetWeapon(index);
+}
+
+int32 AShooterCharacter::GetInventorySlot(const AShooterWeapon* Weapon) const
+{
+	return Inventory.GetSlotIndex(Weapon);
 }
 
 USkeletalMeshComponent* AShooterCharacter::GetPawnMesh() const
@@ -2400,11 +2633,3 @@ float AShooterCharacter::GetLowHealthPercentage() const
 {
 	return LowHealthPercentage;
 }
-
-void AShooterCharacter::UpdateTeamColorsAllMIDs()
-{
-	for (int32 i = 0; i < MeshMIDs.Num(); ++i)
-	{
-		UpdateTeamColors(MeshMIDs[i]);
-	}
-}
@@ -9,6 +9,10 @@
 UShooterCharacterMovement::UShooterCharacterMovement(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	bPendingTeleport = false;
+	bPendingTeleportKeepHeight = false;
+	PendingTeleportLocation = FVector::ZeroVector;
+	LastTeleportTimeStamp = -1.0f;
 }
 
 
@@ -31,3 +35,60 @@ float UShooterCharacterMovement::GetMaxSpeed() const
 
 	return MaxSpeed;
 }
+
+void UShooterCharacterMovement::QueueTeleport(const FVector& Destination, bool bKeepHeight)
+{
+	// don't chain into the exit teleporter during the move that brought us there
+	if (bPendingTeleport || GetCurrentMoveTimeStamp() == LastTeleportTimeStamp)
+	{
+		return;
+	}
+
+	bPendingTeleport = true;
+	bPendingTeleportKeepHeight = bKeepHeight;
+	PendingTeleportLocation = Destination;
+}
+
+void UShooterCharacterMovement::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
+{
+	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
+
+	if (bPendingTeleport && HasValidData())
+	{
+		bPendingTeleport = false;
+		LastTeleportTimeStamp = GetCurrentMoveTimeStamp();
+
+		FVector Destination = PendingTeleportLocation;
+		if (bPendingTeleportKeepHeight)
+		{
+			// keep height so the teleport doesn't make the character "jump"
+			Destination.Z = UpdatedComponent->GetComponentLocation().Z;
+		}
+
+		// moved as part of the move itself, so it ends up in the client's saved move and the server's ServerMove result
+		UpdatedComponent->SetWorldLocation(Destination, false);
+		OnTeleported();
+
+		UE_LOG(LogShooter, Verbose, TEXT("%s teleported to %s at move time %f"), *GetNameSafe(CharacterOwner), *Destination.ToString(), LastTeleportTimeStamp);
+	}
+}
+
+float UShooterCharacterMovement::GetCurrentMoveTimeStamp() const
+{
+	if (CharacterOwner)
+	{
+		if (CharacterOwner->Role == ROLE_AutonomousProxy)
+		{
+			const FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+			return ClientData ? ClientData->CurrentTimeStamp : 0.0f;
+		}
+		else if (CharacterOwner->Role == ROLE_Authority && !CharacterOwner->IsLocallyControlled() && CharacterOwner->IsPlayerControlled())
+		{
+			const FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+			return ServerData ? ServerData->CurrentClientTimeStamp : 0.0f;
+		}
+	}
+
+	// locally simulated (listen server host, bots)
+	return GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+}
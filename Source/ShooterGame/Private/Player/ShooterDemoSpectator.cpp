@@ -2,11 +2,19 @@
 
 #include "ShooterGame.h"
 #include "UI/Menu/ShooterDemoPlaybackMenu.h"
+#include "Engine/DemoNetDriver.h"
+
+/** real time after which a seek that didn't finish is considered failed */
+static const double DemoSeekTimeout = 30.0;
 
 AShooterDemoSpectator::AShooterDemoSpectator(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	PrimaryActorTick.bTickEvenWhenPaused = true;
 	bShouldPerformFullTickWhenPaused = true;
+
+	SeekTargetTime = 0.0f;
+	SeekStartTime = 0.0;
+	bSeeking = false;
 }
 
 void AShooterDemoSpectator::SetupInputComponent()
@@ -41,6 +49,16 @@ void AShooterDemoSpectator::SetPlayer( UPlayer* InPlayer )
 	PlaybackSpeed = 2;
 }
 
+void AShooterDemoSpectator::Tick( float DeltaSeconds )
+{
+	Super::Tick( DeltaSeconds );
+
+	if ( bSeeking && FPlatformTime::Seconds() - SeekStartTime > DemoSeekTimeout )
+	{
+		OnSeekTimedOut();
+	}
+}
+
 void AShooterDemoSpectator::OnToggleInGameMenu()
 {
 	// if no one's paused, pause
@@ -79,3 +97,102 @@ void AShooterDemoSpectator::OnPausePlayback()
 		WorldSettings->Pauser = NULL;
 	}
 }
+
+void AShooterDemoSpectator::DemoSeek(float Percent)
+{
+	UDemoNetDriver* DemoNetDriver = GetWorld()->DemoNetDriver;
+	if (DemoNetDriver)
+	{
+		SeekToTime(DemoNetDriver->DemoTotalTime * FMath::Clamp(Percent, 0.0f, 100.0f) / 100.0f);
+	}
+}
+
+void AShooterDemoSpectator::SeekToTime(float Time)
+{
+	UDemoNetDriver* DemoNetDriver = GetWorld()->DemoNetDriver;
+	if (DemoNetDriver == NULL)
+	{
+		return;
+	}
+
+	// the engine loads the last checkpoint before the target and fast forwards from there
+	SeekTargetTime = FMath::Clamp(Time, 0.0f, DemoNetDriver->DemoTotalTime);
+	SeekStartTime = FPlatformTime::Seconds();
+	bSeeking = true;
+
+	DemoNetDriver->GotoTimeInSeconds(SeekTargetTime, FOnGotoTimeDelegate::CreateUObject(this, &AShooterDemoSpectator::OnSeekFinished));
+}
+
+void AShooterDemoSpectator::OnSeekFinished()
+{
+	if (!bSeeking)
+	{
+		// already given up on
+		return;
+	}
+
+	const double SeekTime = (FPlatformTime::Seconds() - SeekStartTime) * 1000.0;
+	UE_LOG(LogShooter, Verbose, TEXT("Demo seek to %.1fs took %.1f ms"), SeekTargetTime, SeekTime);
+
+	bSeeking = false;
+
+	if (BenchmarkFractions.Num() > 0)
+	{
+		BenchmarkTimes.Add(SeekTime);
+		NextBenchmarkSeek();
+	}
+}
+
+void AShooterDemoSpectator::OnSeekTimedOut()
+{
+	UE_LOG(LogShooter, Warning, TEXT("Demo seek to %.1fs didn't finish within %.0fs"), SeekTargetTime, DemoSeekTimeout);
+
+	bSeeking = false;
+
+	if (BenchmarkFractions.Num() > 0)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Demo seek benchmark aborted"));
+		BenchmarkFractions.Reset();
+		BenchmarkTimes.Reset();
+	}
+}
+
+void AShooterDemoSpectator::DemoSeekBenchmark()
+{
+	if (BenchmarkFractions.Num() > 0)
+	{
+		// already running
+		return;
+	}
+
+	BenchmarkFractions.Add(0.25f);
+	BenchmarkFractions.Add(0.5f);
+	BenchmarkFractions.Add(0.9f);
+	BenchmarkTimes.Reset();
+
+	NextBenchmarkSeek();
+}
+
+void AShooterDemoSpectator::NextBenchmarkSeek()
+{
+	UDemoNetDriver* DemoNetDriver = GetWorld()->DemoNetDriver;
+	if (DemoNetDriver == NULL)
+	{
+		BenchmarkFractions.Reset();
+		return;
+	}
+
+	if (BenchmarkTimes.Num() < BenchmarkFractions.Num())
+	{
+		SeekToTime(DemoNetDriver->DemoTotalTime * BenchmarkFractions[BenchmarkTimes.Num()]);
+		return;
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Demo seek benchmark, %s (%.0fs):"), *DemoNetDriver->DemoURL.Map, DemoNetDriver->DemoTotalTime);
+	for (int32 i = 0; i < BenchmarkTimes.Num(); i++)
+	{
+		UE_LOG(LogShooter, Log, TEXT("  %3.0f%%: %.1f ms"), BenchmarkFractions[i] * 100.0f, BenchmarkTimes[i]);
+	}
+
+	BenchmarkFractions.Reset();
+}
@@ -0,0 +1,65 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/BodySetup.h"
+
+UShooterHitZones::UShooterHitZones(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	// bones checked by name before zones were data driven, used when a character has no asset assigned
+	Bodies.Add(FShooterHitZoneBody(TEXT("head"), EShooterHitZone::Head));
+	Bodies.Add(FShooterHitZoneBody(TEXT("neck_01"), EShooterHitZone::Head));
+	Bodies.Add(FShooterHitZoneBody(TEXT("b_neck"), EShooterHitZone::Back));
+	Bodies.Add(FShooterHitZoneBody(TEXT("b_spine1"), EShooterHitZone::Back));
+	Bodies.Add(FShooterHitZoneBody(TEXT("b_spine"), EShooterHitZone::Back));
+}
+
+const TArray<uint8>& UShooterHitZones::GetBodyTable(const UPhysicsAsset* PhysicsAsset) const
+{
+	static const TArray<uint8> EmptyTable;
+	if (PhysicsAsset == NULL)
+	{
+		return EmptyTable;
+	}
+
+	const TWeakObjectPtr<UPhysicsAsset> AssetKey(const_cast<UPhysicsAsset*>(PhysicsAsset));
+	const TArray<uint8>* ExistingTable = BodyTables.Find(AssetKey);
+	if (ExistingTable)
+	{
+		return *ExistingTable;
+	}
+
+	checkf(Bodies.Num() < MAX_uint8, TEXT("Too many hit zone bodies in %s"), *GetName());
+
+	TArray<uint8>& BodyTable = BodyTables.Add(AssetKey);
+	BodyTable.AddZeroed(PhysicsAsset->BodySetup.Num());
+	for (int32 BodyIndex = 0; BodyIndex < PhysicsAsset->BodySetup.Num(); BodyIndex++)
+	{
+		const UBodySetup* BodySetup = PhysicsAsset->BodySetup[BodyIndex];
+		if (BodySetup == NULL)
+		{
+			continue;
+		}
+
+		// first entry listing the bone wins
+		for (int32 i = 0; i < Bodies.Num(); i++)
+		{
+			if (Bodies[i].BoneName == BodySetup->BoneName)
+			{
+				BodyTable[BodyIndex] = (uint8)(i + 1);
+				break;
+			}
+		}
+	}
+
+	return BodyTable;
+}
+
+#if WITH_EDITOR
+void UShooterHitZones::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BodyTables.Empty();
+}
+#endif
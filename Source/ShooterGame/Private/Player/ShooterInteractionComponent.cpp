@@ -0,0 +1,167 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterStats.h"
+
+const FName UShooterInteractionComponent::InteractTag(TEXT("Interact"));
+
+UShooterInteractionComponent::UShooterInteractionComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+	bWantsInitializeComponent = true;
+
+	RefreshInterval = 0.1f;
+	CameraMoveThreshold = 10.0f;
+	CameraTurnThreshold = 2.0f;
+
+	LastViewLocation = FVector::ZeroVector;
+	LastViewDirection = FVector::ZeroVector;
+	LastRefreshTime = -1.0f;
+	bCandidatesDirty = false;
+}
+
+void UShooterInteractionComponent::InitializeComponent()
+{
+	Super::InitializeComponent();
+
+	AActor* MyOwner = GetOwner();
+	if (MyOwner)
+	{
+		MyOwner->OnActorBeginOverlap.AddDynamic(this, &UShooterInteractionComponent::OnOwnerBeginOverlap);
+		MyOwner->OnActorEndOverlap.AddDynamic(this, &UShooterInteractionComponent::OnOwnerEndOverlap);
+	}
+}
+
+void UShooterInteractionComponent::UninitializeComponent()
+{
+	AActor* MyOwner = GetOwner();
+	if (MyOwner)
+	{
+		MyOwner->OnActorBeginOverlap.RemoveDynamic(this, &UShooterInteractionComponent::OnOwnerBeginOverlap);
+		MyOwner->OnActorEndOverlap.RemoveDynamic(this, &UShooterInteractionComponent::OnOwnerEndOverlap);
+	}
+
+	OverlapCandidates.Reset();
+	FocusedActor.Reset();
+
+	Super::UninitializeComponent();
+}
+
+void UShooterInteractionComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// only the local player needs continuous focus, the server traces when a remote player asks to interact
+	const APawn* MyPawn = Cast<APawn>(GetOwner());
+	if (MyPawn && MyPawn->IsLocallyControlled())
+	{
+		ConditionalRefreshFocus();
+	}
+}
+
+bool UShooterInteractionComponent::CanTrackFocus() const
+{
+	const AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetOwner());
+	return MyPawn && MyPawn->IsAlive() && Cast<AShooterPlayerController>(MyPawn->Controller) != NULL;
+}
+
+void UShooterInteractionComponent::ConditionalRefreshFocus()
+{
+	if (!CanTrackFocus())
+	{
+		FocusedActor.Reset();
+		return;
+	}
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	bool bNeedsRefresh = bCandidatesDirty || FocusedActor.IsStale() || LastRefreshTime < 0.0f || CurrentTime - LastRefreshTime >= RefreshInterval;
+
+	if (!bNeedsRefresh)
+	{
+		const AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetOwner());
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		MyPawn->Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		bNeedsRefresh = FVector::DistSquared(ViewLocation, LastViewLocation) > FMath::Square(CameraMoveThreshold)
+			|| (ViewRotation.Vector() | LastViewDirection) < FMath::Cos(FMath::DegreesToRadians(CameraTurnThreshold));
+	}
+
+	if (bNeedsRefresh)
+	{
+		RefreshFocus();
+	}
+}
+
+void UShooterInteractionComponent::RefreshFocus()
+{
+	AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetOwner());
+	if (!CanTrackFocus())
+	{
+		FocusedActor.Reset();
+		return;
+	}
+
+	FRotator ViewRotation;
+	MyPawn->Controller->GetPlayerViewPoint(LastViewLocation, ViewRotation);
+	LastViewDirection = ViewRotation.Vector();
+	LastRefreshTime = GetWorld()->GetTimeSeconds();
+	bCandidatesDirty = false;
+
+	// what the player is pointing at takes precedence
+	static FName InteractTraceTag = FName(TEXT("InteractTrace"));
+	FCollisionQueryParams TraceParams(InteractTraceTag, true, MyPawn);
+	TraceParams.bTraceAsyncScene = true;
+	TraceParams.bReturnPhysicalMaterial = true;
+
+	const FVector AimDir = MyPawn->GetCameraAim();
+	const FVector StartTrace = MyPawn->GetCameraStartLocation(AimDir);
+	const FVector EndTrace = StartTrace + AimDir * MyPawn->GetInteractRange();
+
+	FocusHit = FHitResult(ForceInit);
+	GetWorld()->LineTraceSingle(FocusHit, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams);
+	SHOOTER_INC_COUNTER(Traces);
+
+	AActor* HitActor = FocusHit.GetActor();
+	if (HitActor && HitActor->ActorHasTag(InteractTag))
+	{
+		FocusedActor = HitActor;
+		return;
+	}
+
+	// then whatever the player is standing on
+	FocusHit = FHitResult(ForceInit);
+	FocusedActor.Reset();
+	for (int32 i = 0; i < OverlapCandidates.Num(); i++)
+	{
+		AActor* Candidate = OverlapCandidates[i].Get();
+		if (Candidate && !Candidate->IsPendingKill())
+		{
+			FocusedActor = Candidate;
+			break;
+		}
+	}
+}
+
+void UShooterInteractionComponent::OnOwnerBeginOverlap(AActor* OtherActor)
+{
+	if (OtherActor && OtherActor->ActorHasTag(InteractTag))
+	{
+		OverlapCandidates.AddUnique(OtherActor);
+		bCandidatesDirty = true;
+	}
+}
+
+void UShooterInteractionComponent::OnOwnerEndOverlap(AActor* OtherActor)
+{
+	// also drop candidates that were destroyed without an end overlap
+	for (int32 i = OverlapCandidates.Num() - 1; i >= 0; i--)
+	{
+		if (!OverlapCandidates[i].IsValid() || OverlapCandidates[i].Get() == OtherActor)
+		{
+			OverlapCandidates.RemoveAt(i);
+			bCandidatesDirty = true;
+		}
+	}
+}
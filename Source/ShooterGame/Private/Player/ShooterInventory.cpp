@@ -0,0 +1,222 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+
+void FShooterInventoryItem::PreReplicatedRemove(const struct FShooterInventory& InArraySerializer)
+{
+	const_cast<FShooterInventory&>(InArraySerializer).OnItemRemoved(*this);
+}
+
+void FShooterInventoryItem::PostReplicatedAdd(const struct FShooterInventory& InArraySerializer)
+{
+	const_cast<FShooterInventory&>(InArraySerializer).OnItemAdded(*this);
+}
+
+void FShooterInventoryItem::PostReplicatedChange(const struct FShooterInventory& InArraySerializer)
+{
+	const_cast<FShooterInventory&>(InArraySerializer).OnItemChanged(*this);
+}
+
+int32 FShooterInventory::Add(AShooterWeapon* Weapon)
+{
+	if (Weapon == NULL || Contains(Weapon))
+	{
+		return INDEX_NONE;
+	}
+
+	FShooterInventoryItem& NewItem = Items[Items.AddDefaulted()];
+	NewItem.Weapon = Weapon;
+	NewItem.SlotIndex = (uint8)FindFreeSlot();
+	NewItem.bExtraWeapon = Weapon->IsExtraWeapon();
+	MarkItemDirty(NewItem);
+
+	// fast array callbacks only run on clients
+	OnItemAdded(NewItem);
+
+	return NewItem.SlotIndex;
+}
+
+bool FShooterInventory::Remove(AShooterWeapon* Weapon)
+{
+	for (int32 i = 0; i < Items.Num(); i++)
+	{
+		if (Items[i].Weapon == Weapon)
+		{
+			OnItemRemoved(Items[i]);
+			Items.RemoveAt(i);
+			MarkArrayDirty();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+AShooterWeapon* FShooterInventory::Find(UClass* WeaponClass) const
+{
+	const TWeakObjectPtr<AShooterWeapon>* IndexedWeapon = WeaponClass ? WeaponsByClass.Find(WeaponClass) : NULL;
+	if (IndexedWeapon == NULL)
+	{
+		return NULL;
+	}
+
+	AShooterWeapon* Weapon = IndexedWeapon->Get();
+	if (Weapon == NULL)
+	{
+		// indexed weapon was destroyed without leaving the inventory, look for another one of the class
+		for (int32 Slot = 0; Slot < SlotWeapons.Num() && Weapon == NULL; Slot++)
+		{
+			AShooterWeapon* SlotWeapon = SlotWeapons[Slot].Get();
+			if (SlotWeapon && SlotWeapon->IsA(WeaponClass))
+			{
+				Weapon = SlotWeapon;
+			}
+		}
+	}
+
+	return Weapon;
+}
+
+bool FShooterInventory::Contains(const AShooterWeapon* Weapon) const
+{
+	return GetSlotIndex(Weapon) != INDEX_NONE;
+}
+
+AShooterWeapon* FShooterInventory::GetWeaponInSlot(int32 Slot) const
+{
+	return SlotWeapons.IsValidIndex(Slot) ? SlotWeapons[Slot].Get() : NULL;
+}
+
+int32 FShooterInventory::GetSlotIndex(const AShooterWeapon* Weapon) const
+{
+	if (Weapon)
+	{
+		for (int32 Slot = 0; Slot < SlotWeapons.Num(); Slot++)
+		{
+			if (SlotWeapons[Slot].Get() == Weapon)
+			{
+				return Slot;
+			}
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void FShooterInventory::OnItemAdded(FShooterInventoryItem& Item)
+{
+	if (Item.bExtraWeapon)
+	{
+		NumExtraWeapons++;
+	}
+	else
+	{
+		NumPrimaryWeapons++;
+	}
+
+	IndexWeapon(Item);
+}
+
+void FShooterInventory::OnItemRemoved(FShooterInventoryItem& Item)
+{
+	if (Item.bExtraWeapon)
+	{
+		NumExtraWeapons--;
+	}
+	else
+	{
+		NumPrimaryWeapons--;
+	}
+
+	UnindexWeapon(Item);
+}
+
+void FShooterInventory::OnItemChanged(FShooterInventoryItem& Item)
+{
+	if (Item.IndexedWeapon.Get() != Item.Weapon)
+	{
+		UnindexWeapon(Item);
+		IndexWeapon(Item);
+	}
+}
+
+void FShooterInventory::IndexWeapon(FShooterInventoryItem& Item)
+{
+	if (SlotWeapons.Num() <= Item.SlotIndex)
+	{
+		SlotWeapons.SetNum(Item.SlotIndex + 1);
+	}
+	SlotWeapons[Item.SlotIndex] = Item.Weapon;
+
+	// client may receive the entry before the weapon actor itself, it will be indexed from PostReplicatedChange
+	if (Item.Weapon)
+	{
+		for (UClass* Class = Item.Weapon->GetClass(); Class && Class->IsChildOf(AShooterWeapon::StaticClass()); Class = Class->GetSuperClass())
+		{
+			if (!WeaponsByClass.FindRef(Class).IsValid())
+			{
+				WeaponsByClass.Add(Class, Item.Weapon);
+			}
+		}
+	}
+
+	Item.IndexedWeapon = Item.Weapon;
+}
+
+void FShooterInventory::UnindexWeapon(FShooterInventoryItem& Item)
+{
+	// NULL if the weapon was already destroyed, its stale lookup entries are dropped the same way
+	AShooterWeapon* Weapon = Item.IndexedWeapon.Get();
+	Item.IndexedWeapon.Reset();
+
+	if (SlotWeapons.IsValidIndex(Item.SlotIndex) && SlotWeapons[Item.SlotIndex].Get() == Weapon)
+	{
+		SlotWeapons[Item.SlotIndex].Reset();
+		while (SlotWeapons.Num() > 0 && !SlotWeapons.Last().IsValid())
+		{
+			SlotWeapons.Pop(false);
+		}
+	}
+
+	for (TMap<UClass*, TWeakObjectPtr<AShooterWeapon> >::TIterator It(WeaponsByClass); It; ++It)
+	{
+		AShooterWeapon* IndexedWeapon = It.Value().Get();
+		if (IndexedWeapon && IndexedWeapon != Weapon)
+		{
+			continue;
+		}
+
+		// hand the class over to another weapon sharing it, if any
+		AShooterWeapon* Replacement = NULL;
+		for (int32 i = 0; i < SlotWeapons.Num() && Replacement == NULL; i++)
+		{
+			AShooterWeapon* SlotWeapon = SlotWeapons[i].Get();
+			if (SlotWeapon && SlotWeapon != Weapon && SlotWeapon->IsA(It.Key()))
+			{
+				Replacement = SlotWeapon;
+			}
+		}
+
+		if (Replacement)
+		{
+			It.Value() = Replacement;
+		}
+		else
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+int32 FShooterInventory::FindFreeSlot() const
+{
+	for (int32 Slot = 0; Slot < SlotWeapons.Num(); Slot++)
+	{
+		if (!SlotWeapons[Slot].IsValid())
+		{
+			return Slot;
+		}
+	}
+
+	return SlotWeapons.Num();
+}
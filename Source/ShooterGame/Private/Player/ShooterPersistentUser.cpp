@@ -1,6 +1,189 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterGame.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+
+float GShooterPersistentUserSaveInterval = 1.0f;
+static FAutoConsoleVariableRef CVarShooterPersistentUserSaveInterval(
+	TEXT("shooter.PersistentUserSaveInterval"),
+	GShooterPersistentUserSaveInterval,
+	TEXT("Seconds a save of the persistent user is delayed, changes made meanwhile are written together.\n")
+	TEXT("Default is 1."),
+	ECVF_Default
+	);
+
+/** save game header, as written by UGameplayStatics::SaveGameToSlot so LoadGameFromSlot can read the slot */
+static const int32 SaveGameFileTypeTag = 0x53415647;
+static const int32 SaveGameFileVersion = 1;
+
+/** path FGenericSaveGameSystem reads a slot from */
+static FString GetSaveGamePath(const FString& SlotName)
+{
+	return FString::Printf(TEXT("%sSaveGames/%s.sav"), *FPaths::GameSavedDir(), *SlotName);
+}
+
+/**
+ * Writes persistent user saves on a worker thread, one at a time.
+ * Data queued for a slot that isn't saved yet is replaced, so only the latest snapshot is written.
+ *
+ * Only desktop platforms go through the worker: they use the generic save game system, whose file is written
+ * here as a temp file renamed over the slot, so a crash mid write leaves the previous save intact.
+ * Other platforms hand the data to their save game system on the game thread, since those aren't known to be
+ * safe to call from another thread and take care of committing the save themselves.
+ */
+class FShooterPersistentUserWriter
+{
+public:
+
+	FShooterPersistentUserWriter()
+		: InFlightUserIndex(0)
+		, bWorkerRunning(false)
+		, SaveDoneEvent(NULL)
+	{
+	}
+
+	~FShooterPersistentUserWriter()
+	{
+		delete SaveDoneEvent;
+	}
+
+	/** [game thread] queue data for slot, starts the worker if it isn't running */
+	void Submit(const FString& SlotName, int32 UserIndex, TArray<uint8>& Data)
+	{
+#if PLATFORM_DESKTOP
+		FScopeLock Lock(&CriticalSection);
+		FSave& Save = Pending.FindOrAdd(SlotName);
+		Save.UserIndex = UserIndex;
+		Save.Data = MoveTemp(Data);
+
+		if (SaveDoneEvent == NULL)
+		{
+			SaveDoneEvent = FPlatformProcess::CreateSynchEvent(true);
+		}
+
+		if (!bWorkerRunning)
+		{
+			bWorkerRunning = true;
+			(new FAutoDeleteAsyncTask<FWriteTask>(*this))->StartBackgroundTask();
+		}
+#else
+		ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+		if (SaveSystem == NULL || !SaveSystem->SaveGame(false, *SlotName, UserIndex, Data))
+		{
+			UE_LOG(LogShooter, Warning, TEXT("Failed to save %s"), *SlotName);
+		}
+#endif
+	}
+
+	/** [game thread] wait until the queued save of slot is written, or every queued save if SlotName is empty */
+	void Flush(const FString& SlotName)
+	{
+		for (;;)
+		{
+			{
+				FScopeLock Lock(&CriticalSection);
+				const bool bSaving = SlotName.IsEmpty() ? bWorkerRunning : (Pending.Contains(SlotName) || InFlightSlotName == SlotName);
+				if (!bSaving)
+				{
+					return;
+				}
+
+				// triggered under the lock by the worker once the next save is done
+				SaveDoneEvent->Reset();
+			}
+			SaveDoneEvent->Wait();
+		}
+	}
+
+private:
+
+	struct FSave
+	{
+		int32 UserIndex;
+		TArray<uint8> Data;
+	};
+
+	class FWriteTask : public FNonAbandonableTask
+	{
+	public:
+
+		FWriteTask(FShooterPersistentUserWriter& InWriter)
+			: Writer(InWriter)
+		{
+		}
+
+		void DoWork()
+		{
+			Writer.WriteAll();
+		}
+
+		FORCEINLINE TStatId GetStatId() const
+		{
+			RETURN_QUICK_DECLARE_CYCLE_STAT(FShooterPersistentUserWriteTask, STATGROUP_ThreadPoolAsyncTasks);
+		}
+
+	private:
+
+		FShooterPersistentUserWriter& Writer;
+	};
+
+	/** [worker] save slots until the queue is empty */
+	void WriteAll()
+	{
+		for (;;)
+		{
+			{
+				FScopeLock Lock(&CriticalSection);
+				InFlightSlotName.Empty();
+				InFlightData.Empty();
+				SaveDoneEvent->Trigger();
+
+				TMap<FString, FSave>::TIterator It(Pending);
+				if (!It)
+				{
+					bWorkerRunning = false;
+					return;
+				}
+
+				InFlightSlotName = It.Key();
+				InFlightUserIndex = It.Value().UserIndex;
+				InFlightData = MoveTemp(It.Value().Data);
+				It.RemoveCurrent();
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			const FString FileName = GetSaveGamePath(InFlightSlotName);
+			const FString TempFileName = FileName + TEXT(".tmp");
+			if (FFileHelper::SaveArrayToFile(InFlightData, *TempFileName) && IFileManager::Get().Move(*FileName, *TempFileName, true, true))
+			{
+				UE_LOG(LogShooter, Verbose, TEXT("Saved %s (%d bytes) in %.1f ms"), *InFlightSlotName, InFlightData.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+			}
+			else
+			{
+				UE_LOG(LogShooter, Warning, TEXT("Failed to save %s"), *InFlightSlotName);
+				IFileManager::Get().Delete(*TempFileName, false, false, true);
+			}
+		}
+	}
+
+	FCriticalSection CriticalSection;
+
+	/** saves waiting to be written, by slot name */
+	TMap<FString, FSave> Pending;
+
+	/** save the worker is writing */
+	FString InFlightSlotName;
+	int32 InFlightUserIndex;
+	TArray<uint8> InFlightData;
+
+	bool bWorkerRunning;
+
+	/** [manual reset] a save finished, or the worker went idle */
+	FEvent* SaveDoneEvent;
+};
+
+static FShooterPersistentUserWriter GShooterPersistentUserWriter;
 
 UShooterPersistentUser::UShooterPersistentUser(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -97,10 +280,74 @@ bool UShooterPersistentUser::IsInvertedYAxisDirty() const
 
 void UShooterPersistentUser::SavePersistentUser()
 {
-	UGameplayStatics::SaveGameToSlot(this, SlotName, UserIndex);
+	bIsDirty = true;
+
+	if (!SaveTickerHandle.IsValid())
+	{
+		SaveTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UShooterPersistentUser::HandleSaveTicker), GShooterPersistentUserSaveInterval);
+	}
+}
+
+bool UShooterPersistentUser::HandleSaveTicker(float DeltaTime)
+{
+	// returning false removes the ticker
+	SaveTickerHandle.Reset();
+	WriteSnapshot();
+	return false;
+}
+
+void UShooterPersistentUser::WriteSnapshot()
+{
+	if (SaveTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(SaveTickerHandle);
+		SaveTickerHandle.Reset();
+	}
+
+	if (!bIsDirty || SlotName.Len() == 0)
+	{
+		return;
+	}
+
+	// serialized the way UGameplayStatics::SaveGameToSlot does, only handing it to the save system is deferred
+	TArray<uint8> Data;
+	FMemoryWriter MemoryWriter(Data, true);
+
+	int32 FileTypeTag = SaveGameFileTypeTag;
+	int32 FileVersion = SaveGameFileVersion;
+	int32 PackageFileUE4Version = GPackageFileUE4Version;
+	FEngineVersion SavedEngineVersion = GEngineVersion;
+	FString SaveGameClassName = GetClass()->GetName();
+	MemoryWriter << FileTypeTag << FileVersion << PackageFileUE4Version << SavedEngineVersion << SaveGameClassName;
+
+	FObjectAndNameAsStringProxyArchive Ar(MemoryWriter, false);
+	Serialize(Ar);
+
+	GShooterPersistentUserWriter.Submit(SlotName, UserIndex, Data);
 	bIsDirty = false;
 }
 
+void UShooterPersistentUser::FlushPendingSaves()
+{
+	for (TObjectIterator<UShooterPersistentUser> It; It; ++It)
+	{
+		It->WriteSnapshot();
+	}
+
+	GShooterPersistentUserWriter.Flush(FString());
+}
+
+void UShooterPersistentUser::BeginDestroy()
+{
+	// a replaced user may still have a save scheduled
+	if (SaveTickerHandle.IsValid())
+	{
+		WriteSnapshot();
+	}
+
+	Super::BeginDestroy();
+}
+
 UShooterPersistentUser* UShooterPersistentUser::LoadPersistentUser(FString SlotName, const int32 UserIndex)
 {
 	UShooterPersistentUser* Result = nullptr;
@@ -109,7 +356,11 @@ UShooterPersistentUser* UShooterPersistentUser::LoadPersistentUser(FString SlotN
 	// Persistent users aren't valid in this state.
 	if (SlotName.Len() > 0)
 	{	
+		// a save of the slot may still be on its way to disk, other slots don't hold up the load
+		GShooterPersistentUserWriter.Flush(SlotName);
+
 		Result = Cast<UShooterPersistentUser>(UGameplayStatics::LoadGameFromSlot(SlotName, UserIndex));
+
 		if (Result == NULL)
 		{
 			// if failed to load, create a new one
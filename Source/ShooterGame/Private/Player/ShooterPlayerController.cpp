@@ -2,37 +2,16 @@
 
 #include "ShooterGame.h"
 #include "UI/Menu/ShooterIngameMenu.h"
-#include "UI/Style/ShooterStyle.h"
 #include "Online.h"
 #include "OnlineAchievementsInterface.h"
 #include "OnlineEventsInterface.h"
 #include "OnlineIdentityInterface.h"
 #include "OnlineSessionInterface.h"
+#include "Online/ShooterNetProfiler.h"
+#include "ShooterStats.h"
+#include "Online/ShooterMatchStats.h"
 
 #define  ACH_FRAG_SOMEONE	TEXT("ACH_FRAG_SOMEONE")
-#define  ACH_SOME_KILLS		TEXT("ACH_SOME_KILLS")
-#define  ACH_LOTS_KILLS		TEXT("ACH_LOTS_KILLS")
-#define  ACH_FINISH_MATCH	TEXT("ACH_FINISH_MATCH")
-#define  ACH_LOTS_MATCHES	TEXT("ACH_LOTS_MATCHES")
-#define  ACH_FIRST_WIN		TEXT("ACH_FIRST_WIN")
-#define  ACH_LOTS_WIN		TEXT("ACH_LOTS_WIN")
-#define  ACH_MANY_WIN		TEXT("ACH_MANY_WIN")
-#define  ACH_SHOOT_BULLETS	TEXT("ACH_SHOOT_BULLETS")
-#define  ACH_SHOOT_ROCKETS	TEXT("ACH_SHOOT_ROCKETS")
-#define  ACH_GOOD_SCORE		TEXT("ACH_GOOD_SCORE")
-#define  ACH_GREAT_SCORE	TEXT("ACH_GREAT_SCORE")
-#define  ACH_PLAY_SANCTUARY	TEXT("ACH_PLAY_SANCTUARY")
-#define  ACH_PLAY_HIGHRISE	TEXT("ACH_PLAY_HIGHRISE")
-
-static const int32 SomeKillsCount = 10;
-static const int32 LotsKillsCount = 20;
-static const int32 LotsMatchesCount = 5;
-static const int32 LotsWinsCount = 3;
-static const int32 ManyWinsCount = 5;
-static const int32 LotsBulletsCount = 100;
-static const int32 LotsRocketsCount = 10;
-static const int32 GoodScoreCount = 10;
-static const int32 GreatScoreCount = 15;
 
 AShooterPlayerController::AShooterPlayerController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -43,7 +22,10 @@ AShooterPlayerController::AShooterPlayerController(const FObjectInitializer& Obj
 	LastDeathLocation = FVector::ZeroVector;
 
 	ServerSayString = TEXT("Say");
-	ShooterFriendUpdateTimer = 0.0f;
+	ChatBurstSize = 5.0f;
+	ChatMessagesPerSecond = 0.5f;
+	ChatAllowance = ChatBurstSize;
+	LastChatTime = 0.0f;
 	bHasSentStartEvents = false;
 }
 
@@ -69,8 +51,6 @@ void AShooterPlayerController::SetupInputComponent()
 void AShooterPlayerController::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
-	FShooterStyle::Initialize();
-	ShooterFriendUpdateTimer = 0;
 }
 
 void AShooterPlayerController::BeginPlay()
@@ -78,27 +58,20 @@ void AShooterPlayerController::BeginPlay()
 	Super::BeginPlay();	
 }
 
-void AShooterPlayerController::TickActor(float DeltaTime, enum ELevelTick TickType, FActorTickFunction& ThisTickFunction)
+void AShooterPlayerController::SetPawn(APawn* InPawn)
 {
-	Super::TickActor(DeltaTime, TickType, ThisTickFunction);
+	Super::SetPawn(InPawn);
 
-	if (IsGameMenuVisible())
+	UShooterGameInstance* const GameInstance = Cast<UShooterGameInstance>(GetGameInstance());
+	if (InPawn != NULL && IsLocalController() && GameInstance != NULL)
 	{
-		if (ShooterFriendUpdateTimer > 0)
-		{
-			ShooterFriendUpdateTimer -= DeltaTime;
-		}
-		else
-		{
-			TSharedPtr<class FShooterFriends> ShooterFriends = ShooterIngameMenu->GetShooterFriends();
-			ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
-			if (ShooterFriends.IsValid() && LocalPlayer && LocalPlayer->GetControllerId() >= 0)
-			{
-				ShooterFriends->UpdateFriends(LocalPlayer->GetControllerId());
-			}
-			ShooterFriendUpdateTimer = 4; //make sure the time between calls is long enough that we won't trigger (0x80552C81) and not exceed the web api rate limit
-		}
+		GameInstance->OnLocalPawnPossessed();
 	}
+}
+
+void AShooterPlayerController::TickActor(float DeltaTime, enum ELevelTick TickType, FActorTickFunction& ThisTickFunction)
+{
+	Super::TickActor(DeltaTime, TickType, ThisTickFunction);
 
 	// Is this the first frame after the game has ended
 	if(bGameEndedFrame)
@@ -205,10 +178,7 @@ void AShooterPlayerController::PawnPendingDestroy(APawn* P)
 
 void AShooterPlayerController::GameHasEnded(class AActor* EndGameFocus, bool bIsWinner)
 {
-	UpdateSaveFileOnGameEnd(bIsWinner);
-	UpdateAchievementsOnGameEnd();
-	UpdateLeaderboardsOnGameEnd();
-
+	// match stats of local players are submitted by ClientGameEnded, which is called from here
 	Super::GameHasEnded(EndGameFocus, bIsWinner);
 }
 
@@ -236,6 +206,7 @@ bool AShooterPlayerController::FindDeathCameraSpot(FVector& CameraLocation, FRot
 
 		const FVector TestLocation = PawnLocation - CameraDir.Vector() * CameraOffset;
 		const bool bBlocked = GetWorld()->LineTraceTest(PawnLocation, TestLocation, ECC_Camera, TraceParams);
+		SHOOTER_INC_COUNTER(Traces);
 
 		if (!bBlocked)
 		{
@@ -669,9 +640,7 @@ void AShooterPlayerController::ClientGameEnded_Implementation(class AActor* EndG
 		ShooterHUD->SetMatchState(bIsWinner ? EShooterMatchState::Won : EShooterMatchState::Lost);
 	}
 
-	UpdateSaveFileOnGameEnd(bIsWinner);
-	UpdateAchievementsOnGameEnd();
-	UpdateLeaderboardsOnGameEnd();
+	SubmitMatchResult(bIsWinner);
 
 	// Flag that the game has just ended (if it's ended due to host loss we want to wait for ClientReturnToMainMenu_Implementation first, incase we don't want to process)
 	bGameEndedFrame = true;
@@ -784,6 +753,13 @@ void AShooterPlayerController::InitInputSystem()
 	}
 }
 
+bool AShooterPlayerController::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	SHOOTER_NET_PROFILE_RPC(this, Function);
+	SHOOTER_INC_COUNTER(RPCsSent);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
 void AShooterPlayerController::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
 {
 	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
@@ -860,7 +836,7 @@ void AShooterPlayerController::ClientTeamMessage_Implementation( APlayerState* S
 		{
 			if( SenderPlayerState != PlayerState  )
 			{
-				ShooterHUD->AddChatLine(S, false);
+				ShooterHUD->AddChatLine(S, false, SenderPlayerState ? FName(*SenderPlayerState->PlayerName) : NAME_None);
 			}
 		}
 	}
@@ -878,7 +854,19 @@ bool AShooterPlayerController::ServerSay_Validate( const FString& Msg )
 
 void AShooterPlayerController::ServerSay_Implementation( const FString& Msg )
 {
-	GetWorld()->GetAuthGameMode()->Broadcast(this, Msg, ServerSayString);
+	// refill allowance over time, drop messages once a player has used it up
+	const float CurrentTime = GetWorld()->GetRealTimeSeconds();
+	ChatAllowance = FMath::Min(ChatBurstSize, ChatAllowance + (CurrentTime - LastChatTime) * ChatMessagesPerSecond);
+	LastChatTime = CurrentTime;
+
+	if (ChatAllowance < 1.0f)
+	{
+		UE_LOG(LogShooter, Verbose, TEXT("Dropped chat message from %s, rate limit exceeded"), PlayerState ? *PlayerState->PlayerName : *GetName());
+		return;
+	}
+	ChatAllowance -= 1.0f;
+
+	GetWorld()->GetAuthGameMode()->Broadcast(this, Msg.Left(128), ServerSayString);
 }
 
 AShooterHUD* AShooterPlayerController::GetShooterHUD() const
@@ -945,234 +933,14 @@ void AShooterPlayerController::ShowInGameMenu()
 		ShooterIngameMenu->ToggleGameMenu();
 	}
 }
-void AShooterPlayerController::UpdateAchievementsOnGameEnd()
+void AShooterPlayerController::SubmitMatchResult(bool bIsWinner)
 {
-	ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
-	if (LocalPlayer)
-	{
-		AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
-		if (ShooterPlayerState)
-		{			
-			const UShooterPersistentUser*  PersistentUser = GetPersistentUser();
-
-			if (PersistentUser)
-			{						
-				const int32 Wins = PersistentUser->GetWins();
-				const int32 Losses = PersistentUser->GetLosses();
-				const int32 Matches = Wins + Losses;
-
-				const int32 TotalKills = PersistentUser->GetKills();
-				const int32 MatchScore = (int32)ShooterPlayerState->GetScore();
-
-				const int32 TotalBulletsFired = PersistentUser->GetBulletsFired();
-				const int32 TotalRocketsFired = PersistentUser->GetRocketsFired();
-			
-				float TotalGameAchievement = 0;
-				float CurrentGameAchievement = 0;
-			
-				///////////////////////////////////////
-				// Kill achievements
-				if (TotalKills >= 1)
-				{
-					CurrentGameAchievement += 100.0f;
-				}
-				TotalGameAchievement += 100;
-
-				{
-					float fSomeKillPct = ((float)TotalKills / (float)SomeKillsCount) * 100.0f;
-					fSomeKillPct = FMath::RoundToFloat(fSomeKillPct);
-					UpdateAchievementProgress(ACH_SOME_KILLS, fSomeKillPct);
-
-					CurrentGameAchievement += FMath::Min(fSomeKillPct, 100.0f);
-					TotalGameAchievement += 100;
-				}
-
-				{
-					float fLotsKillPct = ((float)TotalKills / (float)LotsKillsCount) * 100.0f;
-					fLotsKillPct = FMath::RoundToFloat(fLotsKillPct);
-					UpdateAchievementProgress(ACH_LOTS_KILLS, fLotsKillPct);
-
-					CurrentGameAchievement += FMath::Min(fLotsKillPct, 100.0f);
-					TotalGameAchievement += 100;
-				}
-				///////////////////////////////////////
-
-				///////////////////////////////////////
-				// Match Achievements
-				{
-					UpdateAchievementProgress(ACH_FINISH_MATCH, 100.0f);
-
-					CurrentGameAchievement += 100;
-					TotalGameAchievement += 100;
-				}
-			
-				{
-					float fLotsRoundsPct = ((float)Matches / (float)LotsMatchesCount) * 100.0f;
-					fLotsRoundsPct = FMath::RoundToFloat(fLotsRoundsPct);
-					UpdateAchievementProgress(ACH_LOTS_MATCHES, fLotsRoundsPct);
-
-					CurrentGameAchievement += FMath::Min(fLotsRoundsPct, 100.0f);
-					TotalGameAchievement += 100;
-				}
-				///////////////////////////////////////
-
-				///////////////////////////////////////
-				// Win Achievements
-				if (Wins >= 1)
-				{
-					UpdateAchievementProgress(ACH_FIRST_WIN, 100.0f);
-
-					CurrentGameAchievement += 100.0f;
-				}
-				TotalGameAchievement += 100;
-
-				{			
-					float fLotsWinPct = ((float)Wins / (float)LotsWinsCount) * 100.0f;
-					fLotsWinPct = FMath::RoundToInt(fLotsWinPct);
-					UpdateAchievementProgress(ACH_LOTS_WIN, fLotsWinPct);
-
-					CurrentGameAchievement += FMath::Min(fLotsWinPct, 100.0f);
-					TotalGameAchievement += 100;
-				}
-
-				{			
-					float fManyWinPct = ((float)Wins / (float)ManyWinsCount) * 100.0f;
-					fManyWinPct = FMath::RoundToInt(fManyWinPct);
-					UpdateAchievementProgress(ACH_MANY_WIN, fManyWinPct);
-
-					CurrentGameAchievement += FMath::Min(fManyWinPct, 100.0f);
-					TotalGameAchievement += 100;
-				}
-				///////////////////////////////////////
-
-				///////////////////////////////////////
-				// Ammo Achievements
-				{
-					float fLotsBulletsPct = ((float)TotalBulletsFired / (float)LotsBulletsCount) * 100.0f;
-					fLotsBulletsPct = FMath::RoundToFloat(fLotsBulletsPct);
-					UpdateAchievementProgress(ACH_SHOOT_BULLETS, fLotsBulletsPct);
-
-					CurrentGameAchievement += FMath::Min(fLotsBulletsPct, 100.0f);
-					TotalGameAchievement += 100;
-				}
-
-				{
-					float fLotsRocketsPct = ((float)TotalRocketsFired / (float)LotsRocketsCount) * 100.0f;
-					fLotsRocketsPct = FMath::RoundToFloat(fLotsRocketsPct);
-					UpdateAchievementProgress(ACH_SHOOT_ROCKETS, fLotsRocketsPct);
-
-					CurrentGameAchievement += FMath::Min(fLotsRocketsPct, 100.0f);
-					TotalGameAchievement += 100;
-				}
-				///////////////////////////////////////
-
-				///////////////////////////////////////
-				// Score Achievements
-				{
-					float fGoodScorePct = ((float)MatchScore / (float)GoodScoreCount) * 100.0f;
-					fGoodScorePct = FMath::RoundToFloat(fGoodScorePct);
-					UpdateAchievementProgress(ACH_GOOD_SCORE, fGoodScorePct);
-				}
-
-				{
-					float fGreatScorePct = ((float)MatchScore / (float)GreatScoreCount) * 100.0f;
-					fGreatScorePct = FMath::RoundToFloat(fGreatScorePct);
-					UpdateAchievementProgress(ACH_GREAT_SCORE, fGreatScorePct);
-				}
-				///////////////////////////////////////
-
-				///////////////////////////////////////
-				// Map Play Achievements
-				UWorld* World = GetWorld();
-				if (World)
-				{			
-					FString MapName = *FPackageName::GetShortName(World->PersistentLevel->GetOutermost()->GetName());
-					if (MapName.Find(TEXT("Highrise")) != -1)
-					{
-						UpdateAchievementProgress(ACH_PLAY_HIGHRISE, 100.0f);
-					}
-					else if (MapName.Find(TEXT("Sanctuary")) != -1)
-					{
-						UpdateAchievementProgress(ACH_PLAY_SANCTUARY, 100.0f);
-					}
-				}
-				///////////////////////////////////////			
-
-				const auto Events = Online::GetEventsInterface();
-				const auto Identity = Online::GetIdentityInterface();
-
-				if (Events.IsValid() && Identity.IsValid())
-				{							
-					const int32 UserIndex = LocalPlayer->GetControllerId();
-					TSharedPtr<FUniqueNetId> UniqueID = Identity->GetUniquePlayerId(UserIndex);
-					if (UniqueID.IsValid())
-					{				
-						FOnlineEventParms Params;
-
-						float fGamePct = (CurrentGameAchievement / TotalGameAchievement) * 100.0f;
-						fGamePct = FMath::RoundToFloat(fGamePct);
-						Params.Add( TEXT( "CompletionPercent" ), FVariantData( (float)fGamePct ) );
-						if (UniqueID.IsValid())
-						{				
-							Events->TriggerEvent(*UniqueID, TEXT("GameProgress"), Params);
-						}
-					}
-				}
-			}
-		}
-	}
-}
-
-void AShooterPlayerController::UpdateLeaderboardsOnGameEnd()
-{
-	ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
-	if (LocalPlayer)
-	{
-		// update leaderboards
-		IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
-		if (OnlineSub)
-		{
-			IOnlineIdentityPtr Identity = OnlineSub->GetIdentityInterface();
-			if (Identity.IsValid())
-			{
-				TSharedPtr<FUniqueNetId> UserId = Identity->GetUniquePlayerId(LocalPlayer->GetControllerId());
-				if (UserId.IsValid())
-				{
-					IOnlineLeaderboardsPtr Leaderboards = OnlineSub->GetLeaderboardsInterface();
-					if (Leaderboards.IsValid())
-					{
-						AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
-						if (ShooterPlayerState)
-						{
-							FShooterAllTimeMatchResultsWrite WriteObject;
-
-							WriteObject.SetIntStat(LEADERBOARD_STAT_SCORE, ShooterPlayerState->GetKills());
-							WriteObject.SetIntStat(LEADERBOARD_STAT_KILLS, ShooterPlayerState->GetKills());
-							WriteObject.SetIntStat(LEADERBOARD_STAT_DEATHS, ShooterPlayerState->GetDeaths());
-							WriteObject.SetIntStat(LEADERBOARD_STAT_MATCHESPLAYED, 1);
-
-							// the call will copy the user id and write object to its own memory
-							Leaderboards->WriteLeaderboards(ShooterPlayerState->SessionName, *UserId, WriteObject);
-						}
-					}
-				}
-			}
-		}
-	}
-}
+	UShooterGameInstance* SGI = GetWorld() != NULL ? Cast<UShooterGameInstance>(GetWorld()->GetGameInstance()) : NULL;
 
-void AShooterPlayerController::UpdateSaveFileOnGameEnd(bool bIsWinner)
-{
-	AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
-	if (ShooterPlayerState)
+	FShooterMatchResult Result;
+	if (SGI != NULL && Result.Collect(this, bIsWinner))
 	{
-		// update local saved profile
-		UShooterPersistentUser* const PersistentUser = GetPersistentUser();
-		if (PersistentUser)
-		{
-			PersistentUser->AddMatchResult(ShooterPlayerState->GetKills(), ShooterPlayerState->GetDeaths(), ShooterPlayerState->GetNumBulletsFired(), ShooterPlayerState->GetNumRocketsFired(), bIsWinner);
-			PersistentUser->SaveIfDirty();
-		}
+		SGI->GetMatchStats()->Submit(Result);
 	}
 }
 
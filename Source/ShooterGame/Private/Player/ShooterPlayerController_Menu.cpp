@@ -1,7 +1,6 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterGame.h"
-#include "../UI/Style/ShooterStyle.h"
 
 
 AShooterPlayerController_Menu::AShooterPlayerController_Menu(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -11,6 +10,4 @@ AShooterPlayerController_Menu::AShooterPlayerController_Menu(const FObjectInitia
 void AShooterPlayerController_Menu::PostInitializeComponents() 
 {
 	Super::PostInitializeComponents();
-
-	FShooterStyle::Initialize();
 }
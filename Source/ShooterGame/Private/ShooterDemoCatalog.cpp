@@ -0,0 +1,349 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterDemoCatalog.h"
+
+/** index file header */
+static const uint32 DemoIndexMagic = 0x49434453;
+static const uint32 DemoIndexVersion = 1;
+
+/** demos handed to the game thread at once while scanning */
+static const int32 DemoCatalogBatchSize = 16;
+
+FShooterDemoCatalog* FShooterDemoCatalog::Instance = NULL;
+
+FShooterDemoCatalog& FShooterDemoCatalog::Get()
+{
+	if (Instance == NULL)
+	{
+		Instance = new FShooterDemoCatalog();
+	}
+	return *Instance;
+}
+
+void FShooterDemoCatalog::Shutdown()
+{
+	delete Instance;
+	Instance = NULL;
+}
+
+FString FShooterDemoCatalog::GetDemoDir()
+{
+	return FPaths::GameSavedDir() + TEXT("Demos/");
+}
+
+FString FShooterDemoCatalog::GetDemoFileName(const FString& DemoName)
+{
+	return DemoName.EndsWith(TEXT(".demo")) ? DemoName : DemoName + TEXT(".demo");
+}
+
+FString FShooterDemoCatalog::GetIndexFileName()
+{
+	return GetDemoDir() + TEXT("DemoIndex.bin");
+}
+
+FShooterDemoCatalog::FShooterDemoCatalog()
+	: Thread(NULL)
+	, WorkEvent(NULL)
+	, bIndexLoaded(false)
+	, bRefreshPending(false)
+	, bReportAllPending(false)
+{
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		WorkEvent = FPlatformProcess::CreateSynchEvent();
+		Thread = FRunnableThread::Create(this, TEXT("FShooterDemoCatalog"), 0, TPri_BelowNormal);
+	}
+}
+
+FShooterDemoCatalog::~FShooterDemoCatalog()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = NULL;
+	}
+
+	delete WorkEvent;
+	WorkEvent = NULL;
+}
+
+uint32 FShooterDemoCatalog::Run()
+{
+	while (StopTaskCounter.GetValue() == 0)
+	{
+		bool bRefresh = false;
+		bool bReportAll = false;
+		{
+			FScopeLock ScopeLock(&CriticalSection);
+			bRefresh = bRefreshPending;
+			bReportAll = bReportAllPending;
+			bRefreshPending = false;
+			bReportAllPending = false;
+		}
+
+		if (bRefresh)
+		{
+			Refresh(bReportAll);
+		}
+		else
+		{
+			WorkEvent->Wait();
+		}
+	}
+
+	return 0;
+}
+
+void FShooterDemoCatalog::Stop()
+{
+	StopTaskCounter.Increment();
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+void FShooterDemoCatalog::RequestRefresh(bool bReportAll)
+{
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		bRefreshPending = true;
+		bReportAllPending |= bReportAll;
+		PendingUpdate.bFinished = false;
+	}
+
+	if (Thread)
+	{
+		WorkEvent->Trigger();
+	}
+	else
+	{
+		bReportAllPending = false;
+		bRefreshPending = false;
+		Refresh(bReportAll);
+	}
+}
+
+void FShooterDemoCatalog::PollUpdate(FUpdate& OutUpdate)
+{
+	FScopeLock ScopeLock(&CriticalSection);
+
+	OutUpdate.Changed = MoveTemp(PendingUpdate.Changed);
+	OutUpdate.Removed = MoveTemp(PendingUpdate.Removed);
+	OutUpdate.bFinished = PendingUpdate.bFinished;
+	PendingUpdate.Changed.Reset();
+	PendingUpdate.Removed.Reset();
+}
+
+void FShooterDemoCatalog::NotifyRecordingStarted(const FString& DemoName)
+{
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		const FString FileName = GetDemoFileName(DemoName);
+		MatchInfos.Remove(FileName);
+		InvalidatedDemos.Add(FileName);
+	}
+
+	RequestRefresh();
+}
+
+void FShooterDemoCatalog::NotifyRecordingFinished(const FString& DemoName, const FString& MapName, int32 Duration, int32 NumPlayers)
+{
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		FShooterDemoInfo& Info = MatchInfos.FindOrAdd(GetDemoFileName(DemoName));
+		Info.MapName = MapName;
+		Info.Duration = Duration;
+		Info.NumPlayers = NumPlayers;
+	}
+
+	RequestRefresh();
+}
+
+void FShooterDemoCatalog::Refresh(bool bReportAll)
+{
+	if (!bIndexLoaded)
+	{
+		bIndexLoaded = true;
+		if (!LoadIndex())
+		{
+			Index.Empty();
+		}
+	}
+
+	TMap<FString, FShooterDemoInfo> NewMatchInfos;
+	TSet<FString> NewInvalidatedDemos;
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		Exchange(NewMatchInfos, MatchInfos);
+		Exchange(NewInvalidatedDemos, InvalidatedDemos);
+	}
+
+	const FString DemoDir = GetDemoDir();
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *(DemoDir + TEXT("*.demo")), true, false);
+
+	bool bIndexDirty = false;
+	TSet<FString> FoundDemos;
+	TArray<FShooterDemoInfo> Changed;
+	TArray<FString> Removed;
+
+	for (int32 i = 0; i < FileNames.Num(); i++)
+	{
+		const FString& FileName = FileNames[i];
+		const FString FullName = DemoDir + FileName;
+		FoundDemos.Add(FileName);
+
+		const int64 Size = IFileManager::Get().FileSize(*FullName);
+		const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*FullName);
+
+		FShooterDemoInfo* Info = Index.Find(FileName);
+		bool bChanged = (Info == NULL) || Info->Size != Size || Info->TimeStamp != TimeStamp;
+		if (Info == NULL)
+		{
+			Info = &Index.Add(FileName, FShooterDemoInfo());
+			Info->DemoName = FileName;
+		}
+
+		// file was reused for a new recording, match info of the old one is stale
+		if (NewInvalidatedDemos.Contains(FileName))
+		{
+			Info->MapName.Empty();
+			Info->Duration = 0;
+			Info->NumPlayers = 0;
+			bChanged = true;
+		}
+
+		const FShooterDemoInfo* MatchInfo = NewMatchInfos.Find(FileName);
+		if (MatchInfo)
+		{
+			Info->MapName = MatchInfo->MapName;
+			Info->Duration = MatchInfo->Duration;
+			Info->NumPlayers = MatchInfo->NumPlayers;
+			NewMatchInfos.Remove(FileName);
+			bChanged = true;
+		}
+
+		Info->Size = Size;
+		Info->TimeStamp = TimeStamp;
+		bIndexDirty |= bChanged;
+
+		if (bChanged || bReportAll)
+		{
+			Changed.Add(*Info);
+			if (Changed.Num() >= DemoCatalogBatchSize)
+			{
+				Publish(Changed, Removed, false);
+			}
+		}
+	}
+
+	for (auto It = Index.CreateIterator(); It; ++It)
+	{
+		if (!FoundDemos.Contains(It.Key()))
+		{
+			Removed.Add(It.Key());
+			It.RemoveCurrent();
+			bIndexDirty = true;
+		}
+	}
+
+	// keep match info of demos that weren't written to disk yet
+	if (NewMatchInfos.Num() > 0)
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		for (auto It = NewMatchInfos.CreateConstIterator(); It; ++It)
+		{
+			if (!MatchInfos.Contains(It.Key()))
+			{
+				MatchInfos.Add(It.Key(), It.Value());
+			}
+		}
+	}
+
+	Publish(Changed, Removed, true);
+
+	if (bIndexDirty)
+	{
+		SaveIndex();
+	}
+}
+
+void FShooterDemoCatalog::Publish(TArray<FShooterDemoInfo>& Changed, TArray<FString>& Removed, bool bFinished)
+{
+	FScopeLock ScopeLock(&CriticalSection);
+
+	for (int32 i = 0; i < Changed.Num(); i++)
+	{
+		PendingUpdate.Removed.Remove(Changed[i].DemoName);
+		PendingUpdate.Changed.RemoveAll([&](const FShooterDemoInfo& Info) { return Info.DemoName == Changed[i].DemoName; });
+		PendingUpdate.Changed.Add(Changed[i]);
+	}
+
+	for (int32 i = 0; i < Removed.Num(); i++)
+	{
+		PendingUpdate.Changed.RemoveAll([&](const FShooterDemoInfo& Info) { return Info.DemoName == Removed[i]; });
+		PendingUpdate.Removed.AddUnique(Removed[i]);
+	}
+
+	// another refresh was requested while this one was running
+	PendingUpdate.bFinished = bFinished && !bRefreshPending;
+
+	Changed.Reset();
+	Removed.Reset();
+}
+
+bool FShooterDemoCatalog::LoadIndex()
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetIndexFileName(), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Ar(Data);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumDemos = 0;
+	Ar << Magic << Version << NumDemos;
+	if (Ar.IsError() || Magic != DemoIndexMagic || Version != DemoIndexVersion || NumDemos < 0)
+	{
+		UE_LOG(LogShooter, Log, TEXT("Ignoring outdated demo index %s"), *GetIndexFileName());
+		return false;
+	}
+
+	for (int32 i = 0; i < NumDemos && !Ar.IsError(); i++)
+	{
+		FShooterDemoInfo Info;
+		Ar << Info;
+		Index.Add(Info.DemoName, Info);
+	}
+
+	return !Ar.IsError();
+}
+
+void FShooterDemoCatalog::SaveIndex() const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Ar(Data);
+
+	uint32 Magic = DemoIndexMagic;
+	uint32 Version = DemoIndexVersion;
+	int32 NumDemos = Index.Num();
+	Ar << Magic << Version << NumDemos;
+
+	for (auto It = Index.CreateConstIterator(); It; ++It)
+	{
+		FShooterDemoInfo Info = It.Value();
+		Ar << Info;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Data, *GetIndexFileName()))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to write demo index %s"), *GetIndexFileName());
+	}
+}
@@ -0,0 +1,154 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** cached metadata of a recorded demo */
+struct FShooterDemoInfo
+{
+	/** file name in the demo directory, including extension */
+	FString DemoName;
+
+	/** file size in bytes */
+	int64 Size;
+
+	/** last modification time of the file (UTC) */
+	FDateTime TimeStamp;
+
+	/** map the match was played on, empty if the match didn't finish while recording */
+	FString MapName;
+
+	/** length of the match in seconds */
+	int32 Duration;
+
+	/** number of players at the end of the match */
+	int32 NumPlayers;
+
+	FShooterDemoInfo()
+		: Size(0)
+		, TimeStamp(0)
+		, Duration(0)
+		, NumPlayers(0)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FShooterDemoInfo& Info)
+	{
+		return Ar << Info.DemoName << Info.Size << Info.TimeStamp << Info.MapName << Info.Duration << Info.NumPlayers;
+	}
+};
+
+/**
+ * Index of demos in Saved/Demos, maintained on a worker thread.
+ *
+ * File stats are gathered off the game thread and cached together with match metadata in a small
+ * index file next to the demos. A refresh is requested whenever the demo directory is known to
+ * change (recording started or finished, demo deleted, demo browser opened), and results are
+ * handed to the game thread in batches so the list can be filled progressively.
+ */
+class FShooterDemoCatalog : public FRunnable
+{
+public:
+
+	/** changes found by a refresh since the last poll */
+	struct FUpdate
+	{
+		/** new or changed demos */
+		TArray<FShooterDemoInfo> Changed;
+
+		/** file names of demos that are gone */
+		TArray<FString> Removed;
+
+		/** were all requested refreshes completed */
+		bool bFinished;
+
+		FUpdate() : bFinished(false) {}
+	};
+
+	static FShooterDemoCatalog& Get();
+
+	/** stop worker thread, called on module shutdown */
+	static void Shutdown();
+
+	/** directory demos are recorded to */
+	static FString GetDemoDir();
+
+	/**
+	 * Scan the demo directory again.
+	 *
+	 * @param bReportAll	Report every demo as changed, for consumers that start from an empty list.
+	 */
+	void RequestRefresh(bool bReportAll = false);
+
+	/** [game thread] take changes found since the last call */
+	void PollUpdate(FUpdate& OutUpdate);
+
+	/** [server] demo is being recorded, metadata of a previous recording with the same name doesn't apply anymore */
+	void NotifyRecordingStarted(const FString& DemoName);
+
+	/** [server] match recorded to demo has finished */
+	void NotifyRecordingFinished(const FString& DemoName, const FString& MapName, int32 Duration, int32 NumPlayers);
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+
+	FShooterDemoCatalog();
+	virtual ~FShooterDemoCatalog();
+
+	/** scan directory, update index and publish changes */
+	void Refresh(bool bReportAll);
+
+	/** read index file, returns false if missing or outdated */
+	bool LoadIndex();
+
+	/** write index file */
+	void SaveIndex() const;
+
+	/** add changes to be picked up by the game thread */
+	void Publish(TArray<FShooterDemoInfo>& Changed, TArray<FString>& Removed, bool bFinished);
+
+	/** demo file name (with extension) from a name passed around as DemoRec option */
+	static FString GetDemoFileName(const FString& DemoName);
+
+	/** index file name */
+	static FString GetIndexFileName();
+
+	/** singleton instance, created on first use */
+	static FShooterDemoCatalog* Instance;
+
+	/** worker thread, NULL when the platform doesn't support threads and refreshes are done in place */
+	FRunnableThread* Thread;
+
+	/** wakes up worker when a refresh is requested */
+	FEvent* WorkEvent;
+
+	/** set when worker should exit */
+	FThreadSafeCounter StopTaskCounter;
+
+	/** [worker] cached demos keyed by file name */
+	TMap<FString, FShooterDemoInfo> Index;
+
+	/** [worker] was index file read yet */
+	bool bIndexLoaded;
+
+	/** guards all members below */
+	FCriticalSection CriticalSection;
+
+	/** refresh requested and not started yet */
+	bool bRefreshPending;
+
+	/** next refresh should report every demo */
+	bool bReportAllPending;
+
+	/** changes waiting for the game thread */
+	FUpdate PendingUpdate;
+
+	/** match metadata reported by the game, keyed by demo file name */
+	TMap<FString, FShooterDemoInfo> MatchInfos;
+
+	/** demo file names whose cached metadata was invalidated */
+	TSet<FString> InvalidatedDemos;
+};
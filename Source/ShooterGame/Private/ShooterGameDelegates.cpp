@@ -49,17 +49,16 @@ static void WebServerDelegate(int32 UserIndex, const FString& Action, const FStr
 					AShooterGameState* const GameState = Cast<AShooterGameState>(Player->PlayerController->GetWorld()->GameState);
 
 
-					RankedPlayerMap Players;
-					GameState->GetRankedMap(0, Players);
+					const TArray<AShooterPlayerState*>& Players = GameState->GetRankedPlayers(0);
 
 					bool bNeedsComma = false;
-					for (auto It = Players.CreateIterator(); It; ++It)
+					for (int32 i = 0; i < Players.Num(); i++)
 					{
 						if (bNeedsComma)
 						{
 							ScoreboardStr += TEXT(" ,");
 						}
-						ScoreboardStr += FString::Printf(TEXT(" { \"n\" : \"%s\" , \"k\" : \"%d\" , \"d\" : \"%d\" }"), *It.Value()->GetShortPlayerName(), It.Value()->GetKills(), It.Value()->GetDeaths());
+						ScoreboardStr += FString::Printf(TEXT(" { \"n\" : \"%s\" , \"k\" : \"%d\" , \"d\" : \"%d\" }"), *Players[i]->GetShortPlayerName(), Players[i]->GetKills(), Players[i]->GetDeaths());
 						bNeedsComma = true;
 					}
 				}
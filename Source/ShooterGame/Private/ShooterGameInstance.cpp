@@ -14,6 +14,11 @@
 #include "OnlineKeyValuePair.h"
 #include "ShooterStyle.h"
 #include "ShooterMenuItemWidgetStyle.h"
+#include "ShooterPreloadManifest.h"
+#include "Online/ShooterMatchStats.h"
+#include "Online/ShooterFriendsCache.h"
+#include "ShooterTimeline.h"
+#include "ShooterStats.h"
 
 
 void SShooterWaitDialog::Construct(const FArguments& InArgs)
@@ -80,12 +85,23 @@ UShooterGameInstance::UShooterGameInstance(const FObjectInitializer& ObjectIniti
 	: Super(ObjectInitializer)
 	, bIsOnline(true) // Default to online
 	, bIsLicensed(true) // Default to licensed (should have been checked by OS on boot)
+	, InitStartTime(0.0)
+	, InitEndTime(0.0)
+	, StartGameInstanceTime(0.0)
+	, FirstStateTime(0.0)
+	, bLogStartupTiming(false)
+	, bPawnPossessedSinceMapLoad(false)
 {
 	CurrentState = ShooterGameInstanceState::None;
 }
 
 void UShooterGameInstance::Init() 
 {
+	InitStartTime = FPlatformTime::Seconds();
+
+	Timeline = MakeShareable(new FShooterTimeline());
+	Timeline->BeginSpan(EShooterTimelineTrack::State, TEXT("Init"));
+
 	Super::Init();
 
 	IgnorePairingChangeForControllerId = -1;
@@ -117,6 +133,18 @@ void UShooterGameInstance::Init()
 	FCoreDelegates::OnControllerConnectionChange.AddUObject(this, &UShooterGameInstance::HandleControllerConnectionChange);
 	FCoreDelegates::ApplicationLicenseChange.AddUObject(this, &UShooterGameInstance::HandleAppLicenseUpdate);
 
+	PreloadManifest = MakeShareable(new FShooterPreloadManifest());
+	MatchStats = MakeShareable(new FShooterMatchStats());
+	FriendsCache = MakeShareable(new FShooterFriendsCache());
+	FriendsCache->Init();
+	bPendingHideLoadingScreen = false;
+
+	// stream the menu styles in while the front end map loads
+	if (!IsRunningDedicatedServer())
+	{
+		FShooterStyle::Initialize();
+	}
+
 	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UShooterGameInstance::OnPreLoadMap);
 	FCoreUObjectDelegates::PostLoadMap.AddUObject(this, &UShooterGameInstance::OnPostLoadMap);
 
@@ -133,6 +161,9 @@ void UShooterGameInstance::Init()
 	// Register delegate for ticker callback
 	TickDelegate = FTickerDelegate::CreateUObject(this, &UShooterGameInstance::Tick);
 	TickDelegateHandle = FTicker::GetCoreTicker().AddTicker(TickDelegate);
+
+	InitEndTime = FPlatformTime::Seconds();
+	Timeline->EndSpan(EShooterTimelineTrack::State);
 }
 
 void UShooterGameInstance::Shutdown()
@@ -141,6 +172,19 @@ void UShooterGameInstance::Shutdown()
 
 	// Unregister ticker delegate
 	FTicker::GetCoreTicker().RemoveTicker(TickDelegateHandle);
+
+	// Make sure queued match results and saves reach the disk
+	MatchStats->Flush();
+	UShooterPersistentUser::FlushPendingSaves();
+
+	// Unsubscribe from friends and presence changes while the online subsystem is still around
+	FriendsCache.Reset();
+
+	if (Timeline->IsEnabled())
+	{
+		Timeline->EndSpan(EShooterTimelineTrack::State);
+		Timeline->Write();
+	}
 }
 
 void UShooterGameInstance::HandleSessionUserInviteAccepted( 
@@ -218,10 +262,33 @@ void UShooterGameInstance::OnPreLoadMap()
 
 		bPendingEnableSplitscreen = false;
 	}
+
+	bPendingHideLoadingScreen = false;
+	PreloadManifest->OnPreLoadMap();
+
+	bPawnPossessedSinceMapLoad = false;
+	Timeline->BeginSpan(EShooterTimelineTrack::Map, TEXT("LoadMap"));
 }
 
 void UShooterGameInstance::OnPostLoadMap()
 {
+	PreloadManifest->OnPostLoadMap(GetWorld());
+	FShooterStats::TrackWorld(GetWorld());
+
+	Timeline->EndSpan(EShooterTimelineTrack::Map);
+	if ( GetWorld() != NULL )
+	{
+		Timeline->Mark(EShooterTimelineTrack::Map, FString::Printf(TEXT("Loaded %s"), *GetWorld()->GetMapName()));
+	}
+
+	// Keep the loading screen up until the weapons of the map are loaded
+	if ( PreloadManifest->IsPreloading() )
+	{
+		Timeline->BeginSpan(EShooterTimelineTrack::Map, TEXT("Preload"));
+		bPendingHideLoadingScreen = true;
+		return;
+	}
+
 	// Make sure we hide the loading screen when the level is done loading
 	UShooterGameViewportClient * ShooterViewport = Cast<UShooterGameViewportClient>(GetGameViewportClient());
 
@@ -265,6 +332,10 @@ void UShooterGameInstance::HandleDemoPlaybackFailure( EDemoPlayFailure::Type Fai
 
 void UShooterGameInstance::StartGameInstance()
 {
+	StartGameInstanceTime = FPlatformTime::Seconds();
+	bLogStartupTiming = !IsRunningDedicatedServer();
+	Timeline->Mark(EShooterTimelineTrack::State, TEXT("StartGameInstance"));
+
 #if PLATFORM_PS4 == 0
 	TCHAR Parm[4096] = TEXT("");
 
@@ -458,6 +529,8 @@ AShooterGameSession* UShooterGameInstance::GetGameSession() const
 
 void UShooterGameInstance::TravelLocalSessionFailure(UWorld *World, ETravelFailure::Type FailureType, const FString& ReasonString)
 {
+	Timeline->Mark(EShooterTimelineTrack::Session, TEXT("TravelFailed"));
+
 	AShooterPlayerController_Menu* const FirstPC = Cast<AShooterPlayerController_Menu>(UGameplayStatics::GetPlayerController(GetWorld(), 0));
 	if (FirstPC != nullptr)
 	{
@@ -526,10 +599,13 @@ void UShooterGameInstance::EndCurrentState(FName NextState)
 	}
 
 	CurrentState = ShooterGameInstanceState::None;
+	Timeline->EndSpan(EShooterTimelineTrack::State);
 }
 
 void UShooterGameInstance::BeginNewState(FName NewState, FName PrevState)
 {
+	Timeline->BeginSpan(EShooterTimelineTrack::State, NewState.ToString());
+
 	// per-state custom starting code here
 
 	if (NewState == ShooterGameInstanceState::PendingInvite)
@@ -860,6 +936,7 @@ bool UShooterGameInstance::HostGame(ULocalPlayer* LocalPlayer, const FString& Ga
 		// Offline game, just go straight to map
 		//
 
+		Timeline->Mark(EShooterTimelineTrack::Session, TEXT("HostOffline"));
 		ShowLoadingScreen();
 		GotoState(ShooterGameInstanceState::Playing);
 
@@ -879,6 +956,8 @@ bool UShooterGameInstance::HostGame(ULocalPlayer* LocalPlayer, const FString& Ga
 		// add callback delegate for completion
 		OnCreatePresenceSessionCompleteDelegateHandle = GameSession->OnCreatePresenceSessionComplete().AddUObject(this, &UShooterGameInstance::OnCreatePresenceSessionComplete);
 
+		Timeline->BeginSpan(EShooterTimelineTrack::Session, TEXT("HostSession"));
+
 		TravelURL = InTravelURL;
 		bool const bIsLanMatch = InTravelURL.Contains(TEXT("?bIsLanMatch"));
 
@@ -914,6 +993,7 @@ bool UShooterGameInstance::JoinSession(ULocalPlayer* LocalPlayer, int32 SessionI
 		AddNetworkFailureHandlers();
 
 		OnJoinSessionCompleteDelegateHandle = GameSession->OnJoinSessionComplete().AddUObject(this, &UShooterGameInstance::OnJoinSessionComplete);
+		Timeline->BeginSpan(EShooterTimelineTrack::Session, TEXT("JoinSession"));
 		if (GameSession->JoinSession(LocalPlayer->GetPreferredUniqueNetId(), GameSessionName, SessionIndexInSearchResults))
 		{
 			// If any error occured in the above, pending state would be set
@@ -940,6 +1020,7 @@ bool UShooterGameInstance::JoinSession(ULocalPlayer* LocalPlayer, const FOnlineS
 		AddNetworkFailureHandlers();
 
 		OnJoinSessionCompleteDelegateHandle = GameSession->OnJoinSessionComplete().AddUObject(this, &UShooterGameInstance::OnJoinSessionComplete);
+		Timeline->BeginSpan(EShooterTimelineTrack::Session, TEXT("JoinSession"));
 		if (GameSession->JoinSession(LocalPlayer->GetPreferredUniqueNetId(), GameSessionName, SearchResult))
 		{
 			// If any error occured in the above, pending state would be set
@@ -977,6 +1058,9 @@ void UShooterGameInstance::OnJoinSessionComplete(EOnJoinSessionCompleteResult::T
 		GameSession->OnJoinSessionComplete().Remove(OnJoinSessionCompleteDelegateHandle);
 	}
 
+	Timeline->EndSpan(EShooterTimelineTrack::Session);
+	Timeline->Mark(EShooterTimelineTrack::Session, Result == EOnJoinSessionCompleteResult::Success ? TEXT("JoinSessionComplete") : TEXT("JoinSessionFailed"));
+
 	// Add the splitscreen player if one exists
 	if (Result == EOnJoinSessionCompleteResult::Success && LocalPlayers.Num() > 1)
 	{
@@ -1063,12 +1147,16 @@ void UShooterGameInstance::InternalTravelToSession(const FName& SessionName)
 		return;
 	}
 
+	Timeline->Mark(EShooterTimelineTrack::Session, FString::Printf(TEXT("TravelToSession %s"), *SessionName.ToString()));
 	PlayerController->ClientTravel(URL, TRAVEL_Absolute);
 }
 
 /** Callback which is intended to be called upon session creation */
 void UShooterGameInstance::OnCreatePresenceSessionComplete(FName SessionName, bool bWasSuccessful)
 {
+	Timeline->EndSpan(EShooterTimelineTrack::Session);
+	Timeline->Mark(EShooterTimelineTrack::Session, bWasSuccessful ? TEXT("CreateSessionComplete") : TEXT("CreateSessionFailed"));
+
 	AShooterGameSession* const GameSession = GetGameSession();
 	if (GameSession)
 	{
@@ -1127,6 +1215,8 @@ void UShooterGameInstance::OnSearchSessionsComplete(bool bWasSuccessful)
 
 bool UShooterGameInstance::Tick(float DeltaSeconds)
 {
+	PreloadManifest->Tick(GetWorld());
+
 	// Dedicated server doesn't need to worry about game state
 	if (IsRunningDedicatedServer() == true)
 	{
@@ -1135,8 +1225,35 @@ bool UShooterGameInstance::Tick(float DeltaSeconds)
 
 	MaybeChangeState();
 
+	if (bLogStartupTiming && CurrentState != ShooterGameInstanceState::None)
+	{
+		// log once the first state has been up for a frame
+		if (FirstStateTime <= 0.0)
+		{
+			FirstStateTime = FPlatformTime::Seconds();
+		}
+		else
+		{
+			bLogStartupTiming = false;
+			LogStartupTiming();
+		}
+	}
+
+	MatchStats->Tick();
+
 	UShooterGameViewportClient * ShooterViewport = Cast<UShooterGameViewportClient>(GetGameViewportClient());
 
+	if (bPendingHideLoadingScreen && !PreloadManifest->IsPreloading())
+	{
+		bPendingHideLoadingScreen = false;
+		Timeline->EndSpan(EShooterTimelineTrack::Map);
+
+		if (ShooterViewport != NULL)
+		{
+			ShooterViewport->HideLoadingScreen();
+		}
+	}
+
 	if (CurrentState != ShooterGameInstanceState::WelcomeScreen)
 	{
 		// If at any point we aren't licensed (but we are after welcome screen) bounce them back to the welcome screen
@@ -1204,6 +1321,28 @@ bool UShooterGameInstance::Tick(float DeltaSeconds)
 	return true;
 }
 
+void UShooterGameInstance::OnLocalPawnPossessed()
+{
+	if (!bPawnPossessedSinceMapLoad)
+	{
+		bPawnPossessedSinceMapLoad = true;
+		Timeline->Mark(EShooterTimelineTrack::Player, TEXT("FirstPawnPossessed"));
+	}
+}
+
+void UShooterGameInstance::LogStartupTiming() const
+{
+	const double Now = FPlatformTime::Seconds();
+	UE_LOG(LogShooter, Log, TEXT("Startup: engine %.1f ms, Init %.1f ms, until StartGameInstance %.1f ms, %s built after %.1f ms, first interactive frame after %.1f ms, total %.1f ms"),
+		(InitStartTime - GStartTime) * 1000.0,
+		(InitEndTime - InitStartTime) * 1000.0,
+		(StartGameInstanceTime - InitEndTime) * 1000.0,
+		*CurrentState.ToString(),
+		(FirstStateTime - StartGameInstanceTime) * 1000.0,
+		(Now - FirstStateTime) * 1000.0,
+		(Now - GStartTime) * 1000.0);
+}
+
 bool UShooterGameInstance::HandleOpenCommand(const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld)
 {
 	bool const bOpenSuccessful = Super::HandleOpenCommand(Cmd, Ar, InWorld);
@@ -1822,6 +1961,7 @@ void UShooterGameInstance::FinishSessionCreation(EOnJoinSessionCompleteResult::T
 	if (Result == EOnJoinSessionCompleteResult::Success)
 	{
 		// Travel to the specified match URL
+		Timeline->Mark(EShooterTimelineTrack::Session, TEXT("ServerTravel"));
 		GetWorld()->ServerTravel(TravelURL);
 	}
 	else
@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "ShooterGameDelegates.h"
+#include "ShooterDemoCatalog.h"
 
 #include "ShooterMenuSoundsWidgetStyle.h"
 #include "ShooterMenuWidgetStyle.h"
@@ -24,13 +25,13 @@ class FShooterGameModule : public FDefaultGameModuleImpl
 		InitializeShooterGameDelegates();
 		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
 
-		//Hot reload hack
+		//Hot reload hack, the style is created again when it's first used
 		FSlateStyleRegistry::UnRegisterSlateStyle(FShooterStyle::GetStyleSetName());
-		FShooterStyle::Initialize();
 	}
 
 	virtual void ShutdownModule() override
 	{
+		FShooterDemoCatalog::Shutdown();
 		FShooterStyle::Shutdown();
 	}
 };
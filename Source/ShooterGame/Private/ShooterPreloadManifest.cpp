@@ -0,0 +1,204 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterPreloadManifest.h"
+
+int32 GShooterPreloadManifest = 1;
+static FAutoConsoleVariableRef CVarShooterPreloadManifest(
+	TEXT("shooter.PreloadManifest"),
+	GShooterPreloadManifest,
+	TEXT("Load weapons of the map asynchronously while the loading screen is up.\n")
+	TEXT("When disabled weapons are loaded the first time they are spawned, use it to compare load times.\n")
+	TEXT("Default is 1."),
+	ECVF_Default
+	);
+
+FShooterPreloadManifest::FShooterPreloadManifest()
+	: LoadVersion(0)
+	, bPickupsRequested(false)
+	, bPreloading(false)
+	, bWaitingForFirstFrame(false)
+	, LoadStartTime(0.0)
+	, MapLoadedTime(0.0)
+	, PreloadDoneTime(0.0)
+{
+}
+
+void FShooterPreloadManifest::OnPreLoadMap()
+{
+	LoadVersion++;
+	bPreloading = false;
+	bWaitingForFirstFrame = false;
+	LoadStartTime = FPlatformTime::Seconds();
+
+	UnloadAssets();
+}
+
+void FShooterPreloadManifest::OnPostLoadMap(UWorld* World)
+{
+	if (World == NULL)
+	{
+		return;
+	}
+
+	MapName = World->GetMapName();
+	MapLoadedTime = FPlatformTime::Seconds();
+	if (LoadStartTime <= 0.0)
+	{
+		LoadStartTime = MapLoadedTime;
+	}
+
+	bPickupsRequested = false;
+	bWaitingForFirstFrame = true;
+
+	if (!GShooterPreloadManifest)
+	{
+		PreloadDoneTime = MapLoadedTime;
+		return;
+	}
+
+	TArray<FStringAssetReference> Assets;
+
+	// weapons of players and bots, only for match maps. The game mode only exists on the server, clients
+	// only ever join matches and go by the map's game mode or the shooter defaults
+	const AShooterGameMode* GameMode = NULL;
+	const AGameMode* AuthGameMode = World->GetAuthGameMode();
+	if (AuthGameMode)
+	{
+		GameMode = Cast<AShooterGameMode>(AuthGameMode);
+	}
+	else
+	{
+		const AWorldSettings* WorldSettings = World->GetWorldSettings();
+		UClass* MapGameModeClass = WorldSettings ? *WorldSettings->DefaultGameMode : NULL;
+		GameMode = MapGameModeClass ? Cast<AShooterGameMode>(MapGameModeClass->GetDefaultObject()) : GetDefault<AShooterGameMode>();
+	}
+
+	if (GameMode)
+	{
+		GatherPawnWeapons(GameMode->DefaultPawnClass, Assets);
+		GatherPawnWeapons(GameMode->BotPawnClass, Assets);
+	}
+
+	TArray<FString> MapAssets;
+	GConfig->GetArray(TEXT("ShooterGame.PreloadManifest"), *MapName, MapAssets, GGameIni);
+	for (int32 i = 0; i < MapAssets.Num(); i++)
+	{
+		Assets.AddUnique(FStringAssetReference(MapAssets[i]));
+	}
+
+	bPreloading = true;
+	RequestAssets(Assets);
+}
+
+void FShooterPreloadManifest::GatherPawnWeapons(UClass* PawnClass, TArray<FStringAssetReference>& OutAssets)
+{
+	const AShooterCharacter* DefaultPawn = PawnClass ? Cast<AShooterCharacter>(PawnClass->GetDefaultObject()) : NULL;
+	if (DefaultPawn == NULL)
+	{
+		return;
+	}
+
+	DefaultPawn->GetWeaponAssets(OutAssets);
+}
+
+void FShooterPreloadManifest::RequestAssets(const TArray<FStringAssetReference>& Assets)
+{
+	PendingAssets.Reset();
+	for (int32 i = 0; i < Assets.Num(); i++)
+	{
+		if (!RequestedAssets.Contains(Assets[i]))
+		{
+			PendingAssets.Add(Assets[i]);
+			RequestedAssets.Add(Assets[i]);
+		}
+	}
+
+	if (PendingAssets.Num() > 0)
+	{
+		// the delegate may run right away when everything is in memory already and start the next request
+		const TArray<FStringAssetReference> Request = PendingAssets;
+		StreamableManager.RequestAsyncLoad(Request, FStreamableDelegate::CreateRaw(this, &FShooterPreloadManifest::OnAssetsLoaded, LoadVersion));
+	}
+	else
+	{
+		OnAssetsLoaded(LoadVersion);
+	}
+}
+
+void FShooterPreloadManifest::OnAssetsLoaded(int32 Version)
+{
+	if (Version != LoadVersion || !bPreloading)
+	{
+		return;
+	}
+
+	TArray<FStringAssetReference> PickupAssets;
+	for (int32 i = 0; i < PendingAssets.Num(); i++)
+	{
+		UObject* Asset = PendingAssets[i].ResolveObject();
+		if (Asset == NULL)
+		{
+			UE_LOG(LogShooter, Warning, TEXT("Preload manifest of %s: failed to load %s"), *MapName, *PendingAssets[i].ToString());
+			continue;
+		}
+
+		LoadedAssets.AddUnique(Asset);
+
+		// projectiles, sounds and effects are loaded with the weapon, its pickup is only referenced softly
+		UClass* WeaponClass = Cast<UClass>(Asset);
+		const AShooterWeapon* DefaultWeapon = (WeaponClass && WeaponClass->IsChildOf(AShooterWeapon::StaticClass())) ? WeaponClass->GetDefaultObject<AShooterWeapon>() : NULL;
+		if (DefaultWeapon && !DefaultWeapon->WeaponPickupAsset.IsNull())
+		{
+			PickupAssets.AddUnique(DefaultWeapon->WeaponPickupAsset.ToStringReference());
+		}
+	}
+
+	if (!bPickupsRequested)
+	{
+		bPickupsRequested = true;
+		RequestAssets(PickupAssets);
+		return;
+	}
+
+	bPreloading = false;
+	PreloadDoneTime = FPlatformTime::Seconds();
+}
+
+void FShooterPreloadManifest::Tick(UWorld* World)
+{
+	if (!bWaitingForFirstFrame || bPreloading || World == NULL || !World->HasBegunPlay())
+	{
+		return;
+	}
+
+	bWaitingForFirstFrame = false;
+
+	const double Now = FPlatformTime::Seconds();
+	UE_LOG(LogShooter, Log, TEXT("Loaded %s: map %.1f ms, preload %.1f ms (%d assets%s), first playable frame after %.1f ms"),
+		*MapName,
+		(MapLoadedTime - LoadStartTime) * 1000.0,
+		(PreloadDoneTime - MapLoadedTime) * 1000.0,
+		LoadedAssets.Num(),
+		GShooterPreloadManifest ? TEXT("") : TEXT(", disabled"),
+		(Now - LoadStartTime) * 1000.0);
+
+	LoadStartTime = 0.0;
+}
+
+void FShooterPreloadManifest::UnloadAssets()
+{
+	for (int32 i = 0; i < RequestedAssets.Num(); i++)
+	{
+		StreamableManager.Unload(RequestedAssets[i]);
+	}
+
+	RequestedAssets.Reset();
+	PendingAssets.Reset();
+	LoadedAssets.Reset();
+}
+
+void FShooterPreloadManifest::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(LoadedAssets);
+}
@@ -0,0 +1,104 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/StreamableManager.h"
+
+/**
+ * Loads the weapons of the map asynchronously while the loading screen is up.
+ *
+ * Pawns only hold soft references to their weapons, so loading the map no longer pulls in every weapon
+ * with its projectiles, sounds and effects. The manifest of a map is the default inventory of the game mode's
+ * pawn classes, the pickup classes of those weapons, and the assets listed for the map in the
+ * [ShooterGame.PreloadManifest] section of the game ini:
+ *
+ *   [ShooterGame.PreloadManifest]
+ *   +Highrise=/Game/Blueprints/Weapons/WeapGun_Rocket.WeapGun_Rocket_C
+ */
+class FShooterPreloadManifest : public FGCObject
+{
+public:
+
+	FShooterPreloadManifest();
+
+	/** map load starts */
+	void OnPreLoadMap();
+
+	/** map is loaded, start preloading its manifest */
+	void OnPostLoadMap(UWorld* World);
+
+	/** waiting for manifest assets? */
+	bool IsPreloading() const { return bPreloading; }
+
+	/** report time to the first playable frame once preloading is done */
+	void Tick(UWorld* World);
+
+	// Begin FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	// End FGCObject interface
+
+	/** get class of soft reference, loads it right away if it wasn't preloaded */
+	template<typename T>
+	static UClass* ResolveClass(const TAssetSubclassOf<T>& Asset)
+	{
+		UClass* Class = Asset.Get();
+		if (Class == NULL && !Asset.IsNull())
+		{
+			UE_LOG(LogShooter, Warning, TEXT("%s wasn't preloaded, loading it now"), *Asset.ToStringReference().ToString());
+			Class = StaticLoadClass(T::StaticClass(), NULL, *Asset.ToStringReference().ToString());
+		}
+		return Class;
+	}
+
+	/** move a class reference saved before it became a soft reference to its replacement, called from PostLoad */
+	template<typename T>
+	static void MigrateClass(TSubclassOf<T>& OldClass, TAssetSubclassOf<T>& NewClass)
+	{
+		if (*OldClass && NewClass.IsNull())
+		{
+			NewClass = TAssetSubclassOf<T>(*OldClass);
+		}
+		OldClass = NULL;
+	}
+
+private:
+
+	/** request assets, OnAssetsLoaded is called when they are in memory */
+	void RequestAssets(const TArray<FStringAssetReference>& Assets);
+
+	/** add weapons of pawn class to list */
+	static void GatherPawnWeapons(UClass* PawnClass, TArray<FStringAssetReference>& OutAssets);
+
+	/** [delegate] requested assets are loaded */
+	void OnAssetsLoaded(int32 Version);
+
+	/** release assets of previous map */
+	void UnloadAssets();
+
+	FStreamableManager StreamableManager;
+
+	/** assets of the current request */
+	TArray<FStringAssetReference> PendingAssets;
+
+	/** assets loaded for current map, kept in memory until the next map */
+	TArray<FStringAssetReference> RequestedAssets;
+	TArray<UObject*> LoadedAssets;
+
+	/** map being preloaded */
+	FString MapName;
+
+	/** incremented on every map load, so requests of a previous map are ignored */
+	int32 LoadVersion;
+
+	/** weapon classes are loaded, pickup classes requested */
+	bool bPickupsRequested;
+
+	bool bPreloading;
+
+	/** preload done, waiting for the first frame of play */
+	bool bWaitingForFirstFrame;
+
+	double LoadStartTime;
+	double MapLoadedTime;
+	double PreloadDoneTime;
+};
@@ -0,0 +1,185 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterStats.h"
+
+DEFINE_STAT(STAT_ShooterCharacterTick);
+DEFINE_STAT(STAT_ShooterCharacterTakeDamage);
+DEFINE_STAT(STAT_ShooterWeaponHandleFiring);
+DEFINE_STAT(STAT_ShooterWeaponFire);
+DEFINE_STAT(STAT_ShooterWeaponServerNotifyHit);
+DEFINE_STAT(STAT_ShooterProjectileTick);
+DEFINE_STAT(STAT_ShooterProjectileExplode);
+DEFINE_STAT(STAT_ShooterAIFindEnemy);
+DEFINE_STAT(STAT_ShooterAIWeaponLOS);
+DEFINE_STAT(STAT_ShooterChoosePlayerStart);
+DEFINE_STAT(STAT_ShooterDrawHUD);
+DEFINE_STAT(STAT_ShooterTraces);
+DEFINE_STAT(STAT_ShooterActorsSpawned);
+DEFINE_STAT(STAT_ShooterRPCsSent);
+
+int32 GShooterStatsWindow = 10;
+static FAutoConsoleVariableRef CVarShooterStatsWindow(
+	TEXT("shooter.StatsWindow"),
+	GShooterStatsWindow,
+	TEXT("Length of the rolling window summarized by shooter.StatsDump, in seconds.\n")
+	TEXT("Default is 10."),
+	ECVF_Default
+	);
+
+#if SHOOTER_STATS
+static void ShooterStatsDump(const TArray<FString>& Args)
+{
+	if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+	{
+		FShooterStats::Get().Reset();
+		return;
+	}
+
+	FShooterStats::Get().DumpSummary(*GLog);
+}
+
+static FAutoConsoleCommand CmdShooterStatsDump(
+	TEXT("shooter.StatsDump"),
+	TEXT("Log hot path timings and trace, spawn and RPC counts of the last shooter.StatsWindow seconds.\n")
+	TEXT("Pass 'reset' to clear collected data."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(ShooterStatsDump)
+	);
+#endif
+
+/** second of the current frame, FApp keeps the time of the frame so every sample of a frame lands in the same bucket */
+static int64 GetCurrentSecond()
+{
+	return (int64)FApp::GetCurrentTime();
+}
+
+void FShooterStats::FBucket::Clear(int64 InSecond)
+{
+	Second = InSecond;
+	FMemory::Memzero(Calls);
+	FMemory::Memzero(Cycles);
+	FMemory::Memzero(MaxCycles);
+}
+
+FShooterStats& FShooterStats::Get()
+{
+	static FShooterStats Stats;
+	return Stats;
+}
+
+FShooterStats::FBucket& FShooterStats::GetCurrentBucket()
+{
+	const int32 WindowSeconds = FMath::Max(1, GShooterStatsWindow);
+	if (Buckets.Num() != WindowSeconds)
+	{
+		Buckets.Empty(WindowSeconds);
+		Buckets.AddDefaulted(WindowSeconds);
+	}
+
+	const int64 Second = GetCurrentSecond();
+	FBucket& Bucket = Buckets[Second % WindowSeconds];
+	if (Bucket.Second != Second)
+	{
+		Bucket.Clear(Second);
+	}
+	return Bucket;
+}
+
+void FShooterStats::AddTime(EShooterStat::Type Stat, uint32 Cycles)
+{
+	FBucket& Bucket = GetCurrentBucket();
+	Bucket.Calls[Stat]++;
+	Bucket.Cycles[Stat] += Cycles;
+	Bucket.MaxCycles[Stat] = FMath::Max(Bucket.MaxCycles[Stat], Cycles);
+}
+
+void FShooterStats::AddCount(EShooterStat::Type Stat, int32 Count)
+{
+	GetCurrentBucket().Calls[Stat] += Count;
+}
+
+void FShooterStats::TrackWorld(UWorld* World)
+{
+#if SHOOTER_STATS
+	if (World)
+	{
+		// the handler goes away with the world
+		World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateStatic(&FShooterStats::OnActorSpawned));
+	}
+#endif
+}
+
+void FShooterStats::OnActorSpawned(AActor* Actor)
+{
+	SHOOTER_INC_COUNTER(ActorsSpawned);
+}
+
+const TCHAR* FShooterStats::GetStatName(EShooterStat::Type Stat)
+{
+	switch (Stat)
+	{
+		case EShooterStat::CharacterTick:			return TEXT("Character Tick");
+		case EShooterStat::CharacterTakeDamage:		return TEXT("Character TakeDamage");
+		case EShooterStat::WeaponHandleFiring:		return TEXT("Weapon HandleFiring");
+		case EShooterStat::WeaponFire:				return TEXT("Weapon FireWeapon");
+		case EShooterStat::WeaponServerNotifyHit:	return TEXT("Weapon ServerNotifyHit");
+		case EShooterStat::ProjectileTick:			return TEXT("Projectile Tick");
+		case EShooterStat::ProjectileExplode:		return TEXT("Projectile Explode");
+		case EShooterStat::AIFindEnemy:				return TEXT("AI FindEnemy");
+		case EShooterStat::AIWeaponLOS:				return TEXT("AI WeaponLOS");
+		case EShooterStat::ChoosePlayerStart:		return TEXT("GameMode ChoosePlayerStart");
+		case EShooterStat::DrawHUD:					return TEXT("HUD DrawHUD");
+		case EShooterStat::Traces:					return TEXT("Traces");
+		case EShooterStat::ActorsSpawned:			return TEXT("Actors Spawned");
+		case EShooterStat::RPCsSent:				return TEXT("RPCs Sent");
+		default:									return TEXT("Unknown");
+	}
+}
+
+void FShooterStats::DumpSummary(FOutputDevice& Ar) const
+{
+	const int32 WindowSeconds = FMath::Max(1, GShooterStatsWindow);
+	const int64 Second = GetCurrentSecond();
+
+	FBucket Window;
+	for (int32 i = 0; i < Buckets.Num(); i++)
+	{
+		const FBucket& Bucket = Buckets[i];
+		if (Bucket.Second <= Second - WindowSeconds)
+		{
+			continue;
+		}
+
+		for (int32 StatIdx = 0; StatIdx < EShooterStat::Max; StatIdx++)
+		{
+			Window.Calls[StatIdx] += Bucket.Calls[StatIdx];
+			Window.Cycles[StatIdx] += Bucket.Cycles[StatIdx];
+			Window.MaxCycles[StatIdx] = FMath::Max(Window.MaxCycles[StatIdx], Bucket.MaxCycles[StatIdx]);
+		}
+	}
+
+	const double MsPerCycle = FPlatformTime::GetSecondsPerCycle() * 1000.0;
+
+	Ar.Logf(TEXT("Shooter stats, last %d seconds:"), WindowSeconds);
+	for (int32 StatIdx = 0; StatIdx < EShooterStat::Max; StatIdx++)
+	{
+		const uint32 Calls = Window.Calls[StatIdx];
+		if (StatIdx >= EShooterStat::Traces)
+		{
+			Ar.Logf(TEXT("  %-28s count: %8u  per second: %8.1f"),
+				GetStatName((EShooterStat::Type)StatIdx), Calls, (float)Calls / WindowSeconds);
+		}
+		else
+		{
+			const double TotalMs = Window.Cycles[StatIdx] * MsPerCycle;
+			Ar.Logf(TEXT("  %-28s calls/s: %8.1f  avg: %8.3f ms  max: %8.3f ms  total: %7.2f ms/s"),
+				GetStatName((EShooterStat::Type)StatIdx), (float)Calls / WindowSeconds,
+				Calls > 0 ? TotalMs / Calls : 0.0, Window.MaxCycles[StatIdx] * MsPerCycle, TotalMs / WindowSeconds);
+		}
+	}
+}
+
+void FShooterStats::Reset()
+{
+	Buckets.Empty();
+}
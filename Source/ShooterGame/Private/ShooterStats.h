@@ -0,0 +1,139 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Character Tick"), STAT_ShooterCharacterTick, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Character TakeDamage"), STAT_ShooterCharacterTakeDamage, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon HandleFiring"), STAT_ShooterWeaponHandleFiring, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon FireWeapon"), STAT_ShooterWeaponFire, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon ServerNotifyHit"), STAT_ShooterWeaponServerNotifyHit, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Tick"), STAT_ShooterProjectileTick, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Explode"), STAT_ShooterProjectileExplode, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI FindEnemy"), STAT_ShooterAIFindEnemy, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI WeaponLOS"), STAT_ShooterAIWeaponLOS, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GameMode ChoosePlayerStart"), STAT_ShooterChoosePlayerStart, STATGROUP_Shooter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD DrawHUD"), STAT_ShooterDrawHUD, STATGROUP_Shooter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_ShooterTraces, STATGROUP_Shooter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actors Spawned"), STAT_ShooterActorsSpawned, STATGROUP_Shooter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPCs Sent"), STAT_ShooterRPCsSent, STATGROUP_Shooter, );
+
+/** collect the rolling summary of shooter.StatsDump, not available in shipping builds */
+#define SHOOTER_STATS !UE_BUILD_SHIPPING
+
+/** stats of STATGROUP_Shooter that are also kept for shooter.StatsDump, entries match STAT_Shooter<Entry> */
+namespace EShooterStat
+{
+	enum Type
+	{
+		// cycle counters
+		CharacterTick,
+		CharacterTakeDamage,
+		WeaponHandleFiring,
+		WeaponFire,
+		WeaponServerNotifyHit,
+		ProjectileTick,
+		ProjectileExplode,
+		AIFindEnemy,
+		AIWeaponLOS,
+		ChoosePlayerStart,
+		DrawHUD,
+
+		// counters
+		Traces,
+		ActorsSpawned,
+		RPCsSent,
+		Max,
+	};
+}
+
+/**
+ * Rolling summary of the hot path timings and counters in STATGROUP_Shooter.
+ *
+ * "stat shooter" needs a viewport, so the same numbers are also kept in per second buckets for the last
+ * shooter.StatsWindow seconds and logged by shooter.StatsDump, which works from the console of a dedicated server.
+ * Only meant to be used from the game thread.
+ */
+class FShooterStats
+{
+public:
+
+	/** times the rest of the scope */
+	class FScope
+	{
+	public:
+		FScope(EShooterStat::Type InStat)
+			: Stat(InStat)
+			, StartCycles(FPlatformTime::Cycles())
+		{
+		}
+
+		~FScope()
+		{
+			FShooterStats::Get().AddTime(Stat, FPlatformTime::Cycles() - StartCycles);
+		}
+
+	private:
+		EShooterStat::Type Stat;
+		uint32 StartCycles;
+	};
+
+	static FShooterStats& Get();
+
+	/** account one call of a timed scope */
+	void AddTime(EShooterStat::Type Stat, uint32 Cycles);
+
+	/** bump a counter */
+	void AddCount(EShooterStat::Type Stat, int32 Count);
+
+	/** count actors spawned in world */
+	static void TrackWorld(UWorld* World);
+
+	/** log the stats of the last shooter.StatsWindow seconds */
+	void DumpSummary(FOutputDevice& Ar) const;
+
+	/** clear all collected data */
+	void Reset();
+
+private:
+
+	/** one second of samples */
+	struct FBucket
+	{
+		int64 Second;
+		uint32 Calls[EShooterStat::Max];
+		uint64 Cycles[EShooterStat::Max];
+		uint32 MaxCycles[EShooterStat::Max];
+
+		FBucket() { Clear(-1); }
+
+		void Clear(int64 InSecond);
+	};
+
+	FShooterStats() {}
+
+	/** get the bucket of the current second, clearing it if it's stale */
+	FBucket& GetCurrentBucket();
+
+	/** [delegate] actor spawned in a tracked world */
+	static void OnActorSpawned(AActor* Actor);
+
+	static const TCHAR* GetStatName(EShooterStat::Type Stat);
+
+	TArray<FBucket> Buckets;
+};
+
+#if SHOOTER_STATS
+/** time the rest of the scope, for "stat shooter" and shooter.StatsDump */
+#define SHOOTER_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(STAT_Shooter##Stat); \
+	FShooterStats::FScope ShooterStatsScope(EShooterStat::Stat)
+
+/** add to a counter, for "stat shooter" and shooter.StatsDump */
+#define SHOOTER_INC_COUNTER_BY(Stat, Amount) \
+	do { INC_DWORD_STAT_BY(STAT_Shooter##Stat, Amount); FShooterStats::Get().AddCount(EShooterStat::Stat, Amount); } while (0)
+#else
+#define SHOOTER_SCOPE_CYCLE_COUNTER(Stat)
+#define SHOOTER_INC_COUNTER_BY(Stat, Amount)
+#endif
+
+#define SHOOTER_INC_COUNTER(Stat) SHOOTER_INC_COUNTER_BY(Stat, 1)
@@ -13,14 +13,6 @@ AShooterTeleporter::AShooterTeleporter(const FObjectInitializer& ObjectInitializ
 
 	//TpExitVector = GetActorForwardVector() * 250;
 
-	bTeleporting = false;
-
-}
-
-void AShooterTeleporter::PostInitializeComponents()
-{
-	Super::PostInitializeComponents();
-	TpExitVector = GetActorLocation() + TpExitVector;
 }
 
 // Called when the game starts or when spawned
@@ -35,48 +27,21 @@ void AShooterTeleporter::ReceiveActorBeginOverlap(AActor* Other)
 {
 	AShooterCharacter* Pawn = Cast<AShooterCharacter>(Other);
 
-	if (Pawn)
-	{
-		if (!bTeleporting)
-		{
-			bTeleporting = true;
-			SendTeleport(Pawn);
-		}
-		
-	}
-}
-
-void AShooterTeleporter::SendTeleport(AShooterCharacter* Pawn)
-{
-	if (Role == ROLE_Authority)
+	// only the server and the owning client simulate the pawn's movement, simulated proxies get the result replicated.
+	// The teleport is applied by the movement component within the move, on both sides, so no RPC or correction is needed.
+	if (Pawn && TpTo && (Pawn->Role == ROLE_Authority || Pawn->Role == ROLE_AutonomousProxy))
 	{
-		if (TpTo)
+		UShooterCharacterMovement* MoveComp = Cast<UShooterCharacterMovement>(Pawn->GetCharacterMovement());
+		if (MoveComp)
 		{
-			TpTo->ReceiveTeleport(Pawn, this);
-			bTeleporting = false;
+			MoveComp->QueueTeleport(TpTo->GetExitLocation(), true);
 		}
 	}
-	else
-	{
-		ServerSendTeleport(Pawn);
-	}
 }
 
-//
-void AShooterTeleporter::ReceiveTeleport(AShooterCharacter* Pawn, AShooterTeleporter* TpFrom)
+FVector AShooterTeleporter::GetExitLocation() const
 {
-	if (Role == ROLE_Authority)
-	{
-		FHitResult TpHit;
-		FVector NewPlayerLoc = TpExitVector;
-		//Set the player's Z location to what it is now, so that the tp doesn't make them "jump"
-		NewPlayerLoc.Z = Pawn->GetActorLocation().Z;
-		Pawn->SetActorLocation(NewPlayerLoc, false, &TpHit);
-	}
-	else
-	{
-		ServerReceiveTeleport(Pawn, this);
-	}
+	return GetActorLocation() + TpExitVector;
 }
 
 // Called every frame
@@ -85,23 +50,3 @@ void AShooterTeleporter::Tick( float DeltaTime )
 	Super::Tick( DeltaTime );
 
 }
-
-void AShooterTeleporter::ServerSendTeleport_Implementation(AShooterCharacter* Pawn)
-{
-	SendTeleport(Pawn);
-}
-
-bool AShooterTeleporter::ServerSendTeleport_Validate(AShooterCharacter* Pawn)
-{
-	return true;
-}
-
-void AShooterTeleporter::ServerReceiveTeleport_Implementation(AShooterCharacter* Pawn, AShooterTeleporter* TpFrom)
-{
-	ReceiveTeleport(Pawn, this);
-}
-
-bool AShooterTeleporter::ServerReceiveTeleport_Validate(AShooterCharacter* Pawn, AShooterTeleporter* TpFrom)
-{
-	return true;
-}
\ No newline at end of file
@@ -0,0 +1,138 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterTimeline.h"
+
+int32 GShooterTimeline = 0;
+static FAutoConsoleVariableRef CVarShooterTimeline(
+	TEXT("shooter.Timeline"),
+	GShooterTimeline,
+	TEXT("Record state changes, map loads and session operations, written to Saved/Profiling as a Chrome trace on exit.\n")
+	TEXT("Also enabled by -ShooterTimeline on the command line.\n")
+	TEXT("Default is 0."),
+	ECVF_Default
+	);
+
+static void WriteTimeline(UWorld* InWorld)
+{
+	UShooterGameInstance* const GameInstance = InWorld ? Cast<UShooterGameInstance>(InWorld->GetGameInstance()) : NULL;
+	if (GameInstance == NULL || !GameInstance->GetTimeline()->Write())
+	{
+		UE_LOG(LogShooter, Warning, TEXT("No timeline written, enable recording with shooter.Timeline 1."));
+	}
+}
+
+static FAutoConsoleCommandWithWorld TimelineWriteCmd(
+	TEXT("shooter.TimelineWrite"),
+	TEXT("Writes the timeline recorded so far to the trace file of this run."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(WriteTimeline)
+	);
+
+FShooterTimeline::FShooterTimeline()
+{
+	for (int32 i = 0; i < EShooterTimelineTrack::Max; i++)
+	{
+		bSpanOpen[i] = false;
+	}
+
+	bEnabledOnCommandLine = FParse::Param(FCommandLine::Get(), TEXT("ShooterTimeline"));
+	FileName = FPaths::ProfilingDir() / FString::Printf(TEXT("ShooterTimeline-%s.json"), *FDateTime::Now().ToString());
+}
+
+bool FShooterTimeline::IsEnabled() const
+{
+	return bEnabledOnCommandLine || GShooterTimeline != 0;
+}
+
+void FShooterTimeline::BeginSpan(EShooterTimelineTrack::Type Track, const FString& Name)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	EndSpan(Track);
+	AddEvent(Track, TEXT('B'), Name);
+	bSpanOpen[Track] = true;
+}
+
+void FShooterTimeline::EndSpan(EShooterTimelineTrack::Type Track)
+{
+	if (bSpanOpen[Track])
+	{
+		AddEvent(Track, TEXT('E'), FString());
+		bSpanOpen[Track] = false;
+	}
+}
+
+void FShooterTimeline::Mark(EShooterTimelineTrack::Type Track, const FString& Name)
+{
+	if (IsEnabled())
+	{
+		AddEvent(Track, TEXT('i'), Name);
+	}
+}
+
+void FShooterTimeline::AddEvent(EShooterTimelineTrack::Type Track, TCHAR Phase, const FString& Name)
+{
+	FEvent Event;
+	Event.Name = Name;
+	Event.Time = FPlatformTime::Seconds() - GStartTime;
+	Event.Phase = Phase;
+	Event.Track = Track;
+	Events.Add(Event);
+}
+
+const TCHAR* FShooterTimeline::GetTrackName(EShooterTimelineTrack::Type Track)
+{
+	switch (Track)
+	{
+		case EShooterTimelineTrack::State:		return TEXT("State");
+		case EShooterTimelineTrack::Map:		return TEXT("Map");
+		case EShooterTimelineTrack::Session:	return TEXT("Session");
+		case EShooterTimelineTrack::Player:		return TEXT("Player");
+		default:								return TEXT("Unknown");
+	}
+}
+
+bool FShooterTimeline::Write()
+{
+	if (Events.Num() == 0)
+	{
+		return false;
+	}
+
+	FString Json = TEXT("{\"traceEvents\":[\n");
+
+	// name the tracks
+	for (int32 i = 0; i < EShooterTimelineTrack::Max; i++)
+	{
+		Json += FString::Printf(TEXT("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n"), i, GetTrackName((EShooterTimelineTrack::Type)i));
+	}
+
+	for (int32 i = 0; i < Events.Num(); i++)
+	{
+		const FEvent& Event = Events[i];
+		const FString Name = Event.Name.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+
+		Json += FString::Printf(TEXT("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.1f,\"pid\":1,\"tid\":%d%s}%s\n"),
+			*Name,
+			GetTrackName(Event.Track),
+			Event.Phase,
+			Event.Time * 1000000.0,
+			(int32)Event.Track,
+			Event.Phase == TEXT('i') ? TEXT(",\"s\":\"g\"") : TEXT(""),
+			i < Events.Num() - 1 ? TEXT(",") : TEXT(""));
+	}
+
+	Json += TEXT("]}\n");
+
+	if (!FFileHelper::SaveStringToFile(Json, *FileName))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to write timeline to %s"), *FileName);
+		return false;
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Wrote timeline with %d events to %s"), Events.Num(), *FileName);
+	return true;
+}
@@ -0,0 +1,75 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+namespace EShooterTimelineTrack
+{
+	enum Type
+	{
+		State,
+		Map,
+		Session,
+		Player,
+		Max,
+	};
+}
+
+/**
+ * Timeline of startup, game instance states, map loads and session operations.
+ *
+ * Recording is enabled with -ShooterTimeline on the command line or shooter.Timeline 1. The events are written in
+ * Chrome trace format to Saved/Profiling/ShooterTimeline-<date>.json when the game shuts down or on
+ * shooter.TimelineWrite, and can be opened in chrome://tracing. Every track is shown as a thread of the trace and
+ * has at most one span open at a time.
+ */
+class FShooterTimeline
+{
+public:
+
+	FShooterTimeline();
+
+	/** is recording enabled? */
+	bool IsEnabled() const;
+
+	/** start a span on track, ends the span open on it */
+	void BeginSpan(EShooterTimelineTrack::Type Track, const FString& Name);
+
+	/** end the span open on track, if any */
+	void EndSpan(EShooterTimelineTrack::Type Track);
+
+	/** mark a point in time on track */
+	void Mark(EShooterTimelineTrack::Type Track, const FString& Name);
+
+	/** write the events recorded so far to the trace file of this run, returns false if nothing was written */
+	bool Write();
+
+private:
+
+	struct FEvent
+	{
+		FString Name;
+
+		/** seconds since the engine started */
+		double Time;
+
+		/** Chrome trace phase: B, E or i */
+		TCHAR Phase;
+
+		EShooterTimelineTrack::Type Track;
+	};
+
+	void AddEvent(EShooterTimelineTrack::Type Track, TCHAR Phase, const FString& Name);
+
+	static const TCHAR* GetTrackName(EShooterTimelineTrack::Type Track);
+
+	TArray<FEvent> Events;
+
+	/** is a span open on the track? */
+	bool bSpanOpen[EShooterTimelineTrack::Max];
+
+	/** enabled on the command line */
+	bool bEnabledOnCommandLine;
+
+	/** trace file of this run */
+	FString FileName;
+};
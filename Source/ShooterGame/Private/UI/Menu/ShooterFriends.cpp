@@ -5,6 +5,7 @@
 #include "ShooterTypes.h"
 #include "ShooterStyle.h"
 #include "ShooterOptionsWidgetStyle.h"
+#include "Online/ShooterFriendsCache.h"
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
@@ -25,10 +26,15 @@ void FShooterFriends::Construct(ULocalPlayer* _PlayerOwner, int32 LocalUserNum_)
 	FriendsItem = MenuHelper::AddMenuItem(FriendsRoot, LOCTEXT("Friends", "FRIENDS"));
 	OnlineSub = IOnlineSubsystem::Get();
 	OnlineFriendsPtr = OnlineSub->GetFriendsInterface();
-	if ( OnlineFriendsPtr.IsValid() )
+
+	UShooterGameInstance* const GI = PlayerOwner ? Cast<UShooterGameInstance>(PlayerOwner->GetGameInstance()) : NULL;
+	if (GI && GI->GetFriendsCache())
 	{
-		OnlineFriendsPtr->ReadFriendsList(LocalUserNum, EFriendsLists::ToString(EFriendsLists::OnlinePlayers)); //init read of the friends list with the current user
+		FriendsCache = GI->GetFriendsCache()->AsShared();
+		GI->GetFriendsCache()->OnFriendsChanged().AddSP(this, &FShooterFriends::OnFriendsChanged);
+		GI->GetFriendsCache()->RequestFriends(LocalUserNum); //init read of the friends list with the current user
 	}
+	RebuildFriendItems();
 
 	UserSettings = CastChecked<UShooterGameUserSettings>(GEngine->GetGameUserSettings());
 }
@@ -85,29 +91,97 @@ UShooterPersistentUser* FShooterFriends::GetPersistentUser() const
 
 void FShooterFriends::UpdateFriends(int32 NewOwnerIndex)
 {
-	if (!OnlineFriendsPtr.IsValid())
+	TSharedPtr<FShooterFriendsCache> Cache = FriendsCache.Pin();
+	if (!Cache.IsValid())
 	{
 		return;
 	}
 
-	LocalUserNum = NewOwnerIndex;
-	OnlineFriendsPtr->ReadFriendsList(LocalUserNum, EFriendsLists::ToString(EFriendsLists::OnlinePlayers));
+	if (NewOwnerIndex != LocalUserNum)
+	{
+		LocalUserNum = NewOwnerIndex;
+		RebuildFriendItems();
+	}
+
+	Cache->RequestFriends(LocalUserNum);
+}
+
+void FShooterFriends::RebuildFriendItems()
+{
 	MenuHelper::ClearSubMenu(FriendsItem);
 
-	if (OnlineFriendsPtr->GetFriendsList(LocalUserNum, EFriendsLists::ToString(EFriendsLists::OnlinePlayers), Friends))
+	TSharedPtr<FShooterFriendsCache> Cache = FriendsCache.Pin();
+	if (Cache.IsValid())
+	{
+		Friends = Cache->GetFriends(LocalUserNum);
+	}
+	else
+	{
+		Friends.Empty();
+	}
+
+	for (int32 Idx = 0; Idx < Friends.Num(); ++Idx)
+	{
+		FriendsItem->SubMenu.Add(CreateFriendItem(Friends[Idx]));
+	}
+	MaxFriendIndex = Friends.Num() - 1;
+	CurrFriendIndex = FMath::Clamp(CurrFriendIndex, MinFriendIndex, FMath::Max(MaxFriendIndex, MinFriendIndex));
+
+	MenuHelper::AddMenuItemSP(FriendsItem, LOCTEXT("Close", "CLOSE"), this, &FShooterFriends::OnApplySettings);
+}
+
+TSharedRef<FShooterMenuItem> FShooterFriends::CreateFriendItem(const TSharedRef<FOnlineFriend>& Friend)
+{
+	TSharedRef<FShooterMenuItem> FriendItem = MakeShareable(new FShooterMenuItem(FText::FromString(Friend->GetDisplayName())));
+	//FriendItem->OnControllerFacebuttonLeftPressed.BindRaw(this, &FShooterFriends::InviteSelectedFriendToGame);
+	FriendItem->OnControllerDownInputPressed.BindRaw(this, &FShooterFriends::IncrementFriendsCounter);
+	FriendItem->OnControllerUpInputPressed.BindRaw(this, &FShooterFriends::DecrementFriendsCounter);
+	FriendItem->OnControllerFacebuttonDownPressed.BindRaw(this, &FShooterFriends::ViewSelectedFriendProfile);
+	return FriendItem;
+}
+
+void FShooterFriends::OnFriendsChanged(int32 ChangedUserNum, const FShooterFriendsDiff& Diff)
+{
+	if (ChangedUserNum != LocalUserNum)
+	{
+		return;
+	}
+
+	// friend items come first, followed by the close item
+	for (int32 i = 0; i < Diff.Removed.Num(); ++i)
 	{
 		for (int32 Idx = 0; Idx < Friends.Num(); ++Idx)
 		{
-			const FString FriendUsername = Friends[Idx]->GetDisplayName();
-			TSharedPtr<FShooterMenuItem> FriendItem = MenuHelper::AddMenuItem(FriendsItem, FText::FromString(FriendUsername));
-			//FriendItem->OnControllerFacebuttonLeftPressed.BindRaw(this, &FShooterFriends::InviteSelectedFriendToGame);
-			FriendItem->OnControllerDownInputPressed.BindRaw(this, &FShooterFriends::IncrementFriendsCounter);
-			FriendItem->OnControllerUpInputPressed.BindRaw(this, &FShooterFriends::DecrementFriendsCounter);
-			FriendItem->OnControllerFacebuttonDownPressed.BindRaw(this, &FShooterFriends::ViewSelectedFriendProfile);
+			if (*Friends[Idx]->GetUserId() == *Diff.Removed[i]->GetUserId())
+			{
+				Friends.RemoveAt(Idx);
+				FriendsItem->SubMenu.RemoveAt(Idx);
+				break;
+			}
 		}
-		MaxFriendIndex = Friends.Num() - 1;
 	}
-	MenuHelper::AddMenuItemSP(FriendsItem, LOCTEXT("Close", "CLOSE"), this, &FShooterFriends::OnApplySettings);
+
+	for (int32 i = 0; i < Diff.Updated.Num(); ++i)
+	{
+		for (int32 Idx = 0; Idx < Friends.Num(); ++Idx)
+		{
+			if (*Friends[Idx]->GetUserId() == *Diff.Updated[i]->GetUserId())
+			{
+				Friends[Idx] = Diff.Updated[i];
+				FriendsItem->SubMenu[Idx]->SetText(FText::FromString(Diff.Updated[i]->GetDisplayName()));
+				break;
+			}
+		}
+	}
+
+	for (int32 i = 0; i < Diff.Added.Num(); ++i)
+	{
+		FriendsItem->SubMenu.Insert(CreateFriendItem(Diff.Added[i]), Friends.Num());
+		Friends.Add(Diff.Added[i]);
+	}
+
+	MaxFriendIndex = Friends.Num() - 1;
+	CurrFriendIndex = FMath::Clamp(CurrFriendIndex, MinFriendIndex, FMath::Max(MaxFriendIndex, MinFriendIndex));
 }
 
 void FShooterFriends::IncrementFriendsCounter()
@@ -30,7 +30,7 @@ public:
 	/** sets owning player controller */
 	void Construct(ULocalPlayer* _PlayerOwner, int32 LocalUserNum);
 
-	/** get current Friends values for display */
+	/** show friends of user, requests a read of the list if the cached one is out of date */
 	void UpdateFriends(int32 NewOwnerIndex);
 
 	/** UI callback for applying settings, plays sound */
@@ -92,9 +92,21 @@ protected:
 	/** Get the persistence user associated with PCOwner*/
 	UShooterPersistentUser* GetPersistentUser() const;
 
+	/** rebuild friends menu items from the cached list */
+	void RebuildFriendItems();
+
+	/** create menu item of a friend */
+	TSharedRef<FShooterMenuItem> CreateFriendItem(const TSharedRef<FOnlineFriend>& Friend);
+
+	/** [delegate] apply changes of the cached list to the menu items */
+	void OnFriendsChanged(int32 ChangedUserNum, const struct FShooterFriendsDiff& Diff);
+
 	/** Owning player controller */
 	ULocalPlayer* PlayerOwner;
 
+	/** friends list shared with the other menus */
+	TWeakPtr<class FShooterFriendsCache> FriendsCache;
+
 	/** style used for the shooter Friends */
 	const struct FShooterOptionsStyle *FriendsStyle;
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "ShooterMenuSoundsWidgetStyle.h"
 #include "Online.h"
 #include "OnlineExternalUIInterface.h"
+#include "Online/ShooterFriendsCache.h"
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
@@ -112,19 +113,6 @@ bool FShooterIngameMenu::GetIsGameMenuUp() const
 	return bIsGameMenuUp;
 }
 
-void FShooterIngameMenu::UpdateFriendsList()
-{
-	IOnlineSubsystem* OnlineSub = IOnlineSubsystem::Get();
-	if (OnlineSub)
-	{
-		IOnlineFriendsPtr OnlineFriendsPtr = OnlineSub->GetFriendsInterface();
-		if (OnlineFriendsPtr.IsValid())
-		{
-			OnlineFriendsPtr->ReadFriendsList(GetOwnerUserIndex(), EFriendsLists::ToString(EFriendsLists::OnlinePlayers));
-		}
-	}
-}
-
 void FShooterIngameMenu::DetachGameMenu()
 {
 	if (GEngine && GEngine->GameViewport)
@@ -194,6 +182,10 @@ void FShooterIngameMenu::ToggleGameMenu()
 		{
 			ShooterOptions->UpdateOptions();
 		}
+		if(ShooterFriends.IsValid())
+		{
+			ShooterFriends->UpdateFriends(OwnerUserIndex);
+		}
 		if(ShooterRecentlyMet.IsValid())
 		{
 			ShooterRecentlyMet->UpdateRecentlyMet(OwnerUserIndex);
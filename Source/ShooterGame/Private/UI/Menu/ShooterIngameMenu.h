@@ -20,9 +20,6 @@ public:
 	/** is game menu currently active? */
 	bool GetIsGameMenuUp() const;
 
-	/* updates the friends list of the current owner*/
-	void UpdateFriendsList();
-
 	/* Getter for the ShooterFriends interface/pointer*/
 	TSharedPtr<class FShooterFriends> GetShooterFriends(){ return ShooterFriends; }
 
@@ -10,6 +10,7 @@
 #include "SlateExtras.h"
 #include "GenericPlatformChunkInstall.h"
 #include "Online/ShooterOnlineGameSettings.h"
+#include "Online/ShooterFriendsCache.h"
 #include "SShooterConfirmationDialog.h"
 #include "ShooterMenuItemWidgetStyle.h"
 
@@ -185,9 +186,6 @@ void FShooterMainMenu::Construct(TWeakObjectPtr<UShooterGameInstance> _GameInsta
 		{
 			// JOIN menu option
 			MenuHelper::AddMenuItemSP(RootMenuItem, LOCTEXT("FindCustom", "FIND CUSTOM"), this, &FShooterMainMenu::OnJoinServer);
-
-			// Server list widget that will be called up if appropriate
-			MenuHelper::AddCustomMenuItem(JoinServerItem,SAssignNew(ServerListWidget,SShooterServerList).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
 		}
 
 #if QUICKMATCH_SUPPORTED
@@ -253,9 +251,6 @@ void FShooterMainMenu::Construct(TWeakObjectPtr<UShooterGameInstance> _GameInsta
 			// submenu under "join"
 			MenuHelper::AddMenuItemSP(MenuItem, LOCTEXT("Server", "SERVER"), this, &FShooterMainMenu::OnJoinServer);
 			JoinMapOption = MenuHelper::AddMenuOption(MenuItem, LOCTEXT("SELECTED_LEVEL", "Map"), JoinMapList);
-
-			// Server list widget that will be called up if appropriate
-			MenuHelper::AddCustomMenuItem(JoinServerItem,SAssignNew(ServerListWidget,SShooterServerList).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
 		}
 
 #else
@@ -285,20 +280,17 @@ void FShooterMainMenu::Construct(TWeakObjectPtr<UShooterGameInstance> _GameInsta
 		MenuHelper::AddMenuItemSP(MenuItem, LOCTEXT("Server", "SERVER"), this, &FShooterMainMenu::OnJoinServer);
 		JoinLANItem = MenuHelper::AddMenuOptionSP(MenuItem, LOCTEXT("LanMatch", "LAN"), OnOffList, this, &FShooterMainMenu::LanMatchChanged);
 		JoinLANItem->SelectedMultiChoice = bIsLanMatch;
-
-		// Server list widget that will be called up if appropriate
-		MenuHelper::AddCustomMenuItem(JoinServerItem,SAssignNew(ServerListWidget,SShooterServerList).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
 #endif
 
+		// server list, leaderboard, demo list and the options are built the first time they are shown
+
 		// Leaderboards
 #if !SHOOTER_CONSOLE_UI
 		MenuHelper::AddMenuItemSP(RootMenuItem, LOCTEXT("Leaderboards", "LEADERBOARDS"), this, &FShooterMainMenu::OnShowLeaderboard);
-		MenuHelper::AddCustomMenuItem(LeaderboardItem,SAssignNew(LeaderboardWidget,SShooterLeaderboard).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
 
 		// Demos
 		{
 			MenuHelper::AddMenuItemSP(RootMenuItem, LOCTEXT("Demos", "DEMOS"), this, &FShooterMainMenu::OnShowDemoBrowser);
-			MenuHelper::AddCustomMenuItem(DemoBrowserItem,SAssignNew(DemoListWidget,SShooterDemoList).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
 		}
 #endif
 
@@ -333,6 +325,12 @@ void FShooterMainMenu::AddMenuToGameViewport()
 		UGameViewportClient* const GVC = GEngine->GameViewport;
 		GVC->AddViewportWidgetContent(MenuWidgetContainer.ToSharedRef());
 	}
+
+	// read friends while in the menu, so the in-game friends and recently met menus don't wait for them
+	if (GameInstance.IsValid() && GameInstance->GetFriendsCache() && GetPlayerOwnerControllerId() != -1)
+	{
+		GameInstance->GetFriendsCache()->RequestFriends(GetPlayerOwnerControllerId());
+	}
 }
 
 void FShooterMainMenu::RemoveMenuFromGameViewport()
@@ -675,11 +673,13 @@ FReply FShooterMainMenu::OnSplitScreenPlay()
 
 				FSlateApplication::Get().SetKeyboardFocus(MenuWidget);	
 
+				BuildServerList();
 				MenuWidget->NextMenu = JoinServerItem->SubMenu;
 				ServerListWidget->BeginServerSearch(bIsLanMatch, TEXT("ANY"));
 				ServerListWidget->UpdateServerList();
 				MenuWidget->EnterSubMenu();
 #else
+				BuildServerList();
 				SplitScreenLobbyWidget->NextMenu = JoinServerItem->SubMenu;
 				ServerListWidget->BeginServerSearch(bIsLanMatch, TEXT("ANY"));
 				ServerListWidget->UpdateServerList();
@@ -1146,6 +1146,7 @@ void FShooterMainMenu::OnUserCanPlayOnlineJoin(const FUniqueNetId& UserId, EUser
 		AddMenuToGameViewport();
 		FSlateApplication::Get().SetKeyboardFocus(MenuWidget);
 
+		BuildServerList();
 		MenuWidget->NextMenu = JoinServerItem->SubMenu;
 		ServerListWidget->BeginServerSearch(bIsLanMatch, TEXT("ANY"));
 		ServerListWidget->UpdateServerList();
@@ -1161,6 +1162,7 @@ void FShooterMainMenu::OnUserCanPlayOnlineJoin(const FUniqueNetId& UserId, EUser
 		SplitScreenLobbyWidget->SetIsJoining( true );
 #endif
 #else
+		BuildServerList();
 		MenuWidget->NextMenu = JoinServerItem->SubMenu;
 		//FString SelectedMapFilterName = JoinMapOption->MultiChoice[JoinMapOption->SelectedMultiChoice].ToString();
 
@@ -1175,8 +1177,21 @@ void FShooterMainMenu::OnUserCanPlayOnlineJoin(const FUniqueNetId& UserId, EUser
 	}
 }
 
+void FShooterMainMenu::BuildServerList()
+{
+	if (!ServerListWidget.IsValid())
+	{
+		MenuHelper::AddCustomMenuItem(JoinServerItem,SAssignNew(ServerListWidget,SShooterServerList).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
+	}
+}
+
 void FShooterMainMenu::OnShowLeaderboard()
 {
+	if (!LeaderboardWidget.IsValid())
+	{
+		MenuHelper::AddCustomMenuItem(LeaderboardItem,SAssignNew(LeaderboardWidget,SShooterLeaderboard).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
+	}
+
 	MenuWidget->NextMenu = LeaderboardItem->SubMenu;
 	LeaderboardWidget->ReadStats();
 	MenuWidget->EnterSubMenu();
@@ -1184,6 +1199,11 @@ void FShooterMainMenu::OnShowLeaderboard()
 
 void FShooterMainMenu::OnShowDemoBrowser()
 {
+	if (!DemoListWidget.IsValid())
+	{
+		MenuHelper::AddCustomMenuItem(DemoBrowserItem,SAssignNew(DemoListWidget,SShooterDemoList).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
+	}
+
 	MenuWidget->NextMenu = DemoBrowserItem->SubMenu;
 	DemoListWidget->BuildDemoList();
 	MenuWidget->EnterSubMenu();
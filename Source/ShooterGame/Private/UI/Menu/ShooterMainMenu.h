@@ -181,6 +181,9 @@ protected:
 	/** Join server */
 	void OnJoinServer();
 
+	/** Builds the server list the first time it's shown */
+	void BuildServerList();
+
 	/** Show leaderboard */
 	void OnShowLeaderboard();
 
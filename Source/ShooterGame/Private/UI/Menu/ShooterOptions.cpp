@@ -14,7 +14,49 @@ void FShooterOptions::Construct(ULocalPlayer* _PlayerOwner)
 
 	PlayerOwner = _PlayerOwner;
 	MinSensitivity = 1;
-	
+
+	TArray<FText> OnOffList;
+	OnOffList.Add(LOCTEXT("Off","OFF"));
+	OnOffList.Add(LOCTEXT("On","ON"));
+
+	/** Options menu root item */
+	TSharedPtr<FShooterMenuItem> OptionsRoot = FShooterMenuItem::CreateRoot();
+
+	/** Cheats menu root item */
+	TSharedPtr<FShooterMenuItem> CheatsRoot = FShooterMenuItem::CreateRoot();
+
+	CheatsItem = MenuHelper::AddMenuItem(CheatsRoot,LOCTEXT("Cheats", "CHEATS"));
+	MenuHelper::AddMenuOptionSP(CheatsItem, LOCTEXT("InfiniteAmmo", "INFINITE AMMO"), OnOffList, this, &FShooterOptions::InfiniteAmmoOptionChanged);
+	MenuHelper::AddMenuOptionSP(CheatsItem, LOCTEXT("InfiniteClip", "INFINITE CLIP"), OnOffList, this, &FShooterOptions::InfiniteClipOptionChanged);
+	MenuHelper::AddMenuOptionSP(CheatsItem, LOCTEXT("FreezeMatchTimer", "FREEZE MATCH TIMER"), OnOffList, this, &FShooterOptions::FreezeTimerOptionChanged);
+	MenuHelper::AddMenuOptionSP(CheatsItem, LOCTEXT("HealthRegen", "HP REGENERATION"), OnOffList, this, &FShooterOptions::HealthRegenOptionChanged);
+
+	// the option lists are built the first time the options menu is shown
+	OptionsItem = MenuHelper::AddMenuItem(OptionsRoot,LOCTEXT("Options", "OPTIONS"));
+	OptionsItem->OnBuildSubMenu.BindSP(this, &FShooterOptions::BuildOptionsMenu);
+
+	UserSettings = CastChecked<UShooterGameUserSettings>(GEngine->GetGameUserSettings());
+	ResolutionOpt = UserSettings->GetScreenResolution();
+	bFullScreenOpt = UserSettings->GetFullscreenMode();
+	GraphicsQualityOpt = UserSettings->GetGraphicsQuality();
+
+	UShooterPersistentUser* PersistentUser = GetPersistentUser();
+	if(PersistentUser)
+	{
+		bInvertYAxisOpt = PersistentUser->GetInvertedYAxis();
+		SensitivityOpt = PersistentUser->GetAimSensitivity();
+		GammaOpt = PersistentUser->GetGamma();
+	}
+	else
+	{
+		bInvertYAxisOpt = false;
+		SensitivityOpt = 1.0f;
+		GammaOpt = 2.2f;
+	}
+}
+
+void FShooterOptions::BuildOptionsMenu()
+{
 	TArray<FText> ResolutionList;
 	TArray<FText> OnOffList;
 	TArray<FText> SensitivityList;
@@ -62,19 +104,6 @@ void FShooterOptions::Construct(ULocalPlayer* _PlayerOwner)
 		GammaList.Add(FText::AsNumber(i));
 	}
 
-	/** Options menu root item */
-	TSharedPtr<FShooterMenuItem> OptionsRoot = FShooterMenuItem::CreateRoot();
-
-	/** Cheats menu root item */
-	TSharedPtr<FShooterMenuItem> CheatsRoot = FShooterMenuItem::CreateRoot();
-
-	CheatsItem = MenuHelper::AddMenuItem(CheatsRoot,LOCTEXT("Cheats", "CHEATS"));
-	MenuHelper::AddMenuOptionSP(CheatsItem, LOCTEXT("InfiniteAmmo", "INFINITE AMMO"), OnOffList, this, &FShooterOptions::InfiniteAmmoOptionChanged);
-	MenuHelper::AddMenuOptionSP(CheatsItem, LOCTEXT("InfiniteClip", "INFINITE CLIP"), OnOffList, this, &FShooterOptions::InfiniteClipOptionChanged);
-	MenuHelper::AddMenuOptionSP(CheatsItem, LOCTEXT("FreezeMatchTimer", "FREEZE MATCH TIMER"), OnOffList, this, &FShooterOptions::FreezeTimerOptionChanged);
-	MenuHelper::AddMenuOptionSP(CheatsItem, LOCTEXT("HealthRegen", "HP REGENERATION"), OnOffList, this, &FShooterOptions::HealthRegenOptionChanged);
-
-	OptionsItem = MenuHelper::AddMenuItem(OptionsRoot,LOCTEXT("Options", "OPTIONS"));
 #if PLATFORM_DESKTOP
 	VideoResolutionOption = MenuHelper::AddMenuOptionSP(OptionsItem,LOCTEXT("Resolution", "RESOLUTION"), ResolutionList, this, &FShooterOptions::VideoResolutionOptionChanged);
 	GraphicsQualityOption = MenuHelper::AddMenuOptionSP(OptionsItem,LOCTEXT("Quality", "QUALITY"),LowHighList, this, &FShooterOptions::GraphicsQualityOptionChanged);
@@ -88,24 +117,7 @@ void FShooterOptions::Construct(ULocalPlayer* _PlayerOwner)
 	//Do not allow to set aim sensitivity to 0
 	AimSensitivityOption->MinMultiChoiceIndex = MinSensitivity;
 
-	UserSettings = CastChecked<UShooterGameUserSettings>(GEngine->GetGameUserSettings());
-	ResolutionOpt = UserSettings->GetScreenResolution();
-	bFullScreenOpt = UserSettings->GetFullscreenMode();
-	GraphicsQualityOpt = UserSettings->GetGraphicsQuality();
-
-	UShooterPersistentUser* PersistentUser = GetPersistentUser();
-	if(PersistentUser)
-	{
-		bInvertYAxisOpt = PersistentUser->GetInvertedYAxis();
-		SensitivityOpt = PersistentUser->GetAimSensitivity();
-		GammaOpt = PersistentUser->GetGamma();
-	}
-	else
-	{
-		bInvertYAxisOpt = false;
-		SensitivityOpt = 1.0f;
-		GammaOpt = 2.2f;
-	}
+	UpdateOptions();
 }
 
 void FShooterOptions::OnApplySettings()
@@ -148,7 +160,10 @@ void FShooterOptions::RevertChanges()
 {
 	FSlateApplication::Get().PlaySound(OptionsStyle->DiscardChangesSound, GetOwnerUserIndex());
 	UpdateOptions();
-	GEngine->DisplayGamma =  2.2f + 2.0f * (-0.5f + GammaOption->SelectedMultiChoice / 100.0f);
+	if (GammaOption.IsValid())
+	{
+		GEngine->DisplayGamma =  2.2f + 2.0f * (-0.5f + GammaOption->SelectedMultiChoice / 100.0f);
+	}
 }
 
 int32 FShooterOptions::GetCurrentResolutionIndex(FIntPoint CurrentRes)
@@ -250,6 +265,13 @@ void FShooterOptions::UpdateOptions()
 		GammaOpt = PersistentUser->GetGamma();
 	} 
 
+	if (!InvertYAxisOption.IsValid())
+	{
+		// options menu hasn't been built yet, only apply gamma of the profile
+		GammaOptionChanged(NULL, GetCurrentGammaIndex());
+		return;
+	}
+
 	InvertYAxisOption->SelectedMultiChoice =  GetCurrentMouseYAxisInvertedIndex();
 	AimSensitivityOption->SelectedMultiChoice = GetCurrentMouseSensitivityIndex();
 	GammaOption->SelectedMultiChoice = GetCurrentGammaIndex();
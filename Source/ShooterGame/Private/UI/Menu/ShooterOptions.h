@@ -48,6 +48,9 @@ protected:
 	/** User settings pointer */
 	UShooterGameUserSettings* UserSettings;
 
+	/** builds the option lists of the options menu, the first time it's shown */
+	void BuildOptionsMenu();
+
 	/** video resolution option changed handler */
 	void VideoResolutionOptionChanged(TSharedPtr<FShooterMenuItem> MenuItem, int32 MultiOptionIndex);
 
@@ -5,6 +5,7 @@
 #include "ShooterTypes.h"
 #include "ShooterStyle.h"
 #include "ShooterOptionsWidgetStyle.h"
+#include "Online/ShooterFriendsCache.h"
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
@@ -76,6 +77,10 @@ void FShooterRecentlyMet::UpdateRecentlyMet(int32 NewOwnerIndex)
 	MenuHelper::ClearSubMenu(RecentlyMetItem);
 	MaxRecentlyMetIndex = 0;
 
+	// friends come from the cache shared with the friends menu
+	UShooterGameInstance* const GI = Cast<UShooterGameInstance>(PlayerOwner->GetGameInstance());
+	const FShooterFriendsCache* const FriendsCache = GI ? GI->GetFriendsCache() : nullptr;
+
 	AShooterGameState* const MyGameState = Cast<AShooterGameState>(PlayerOwner->GetWorld()->GameState);
 	if (MyGameState != nullptr)
 	{
@@ -87,7 +92,11 @@ void FShooterRecentlyMet::UpdateRecentlyMet(int32 NewOwnerIndex)
 			FString Username = PlayerState->GetHumanReadableName();
 			if (Username != LocalUsername && PlayerState->bIsABot == false)
 			{
-				TSharedPtr<FShooterMenuItem> UserItem = MenuHelper::AddMenuItem(RecentlyMetItem, FText::FromString(Username));
+				TSharedPtr<FUniqueNetId> UserId = PlayerState->UniqueId.GetUniqueNetId();
+				const bool bIsFriend = FriendsCache && UserId.IsValid() && FriendsCache->IsFriend(LocalUserNum, *UserId);
+				const FText UserText = bIsFriend ? FText::Format(LOCTEXT("RecentlyMetFriend", "{0} (FRIEND)"), FText::FromString(Username)) : FText::FromString(Username);
+
+				TSharedPtr<FShooterMenuItem> UserItem = MenuHelper::AddMenuItem(RecentlyMetItem, UserText);
 				UserItem->OnControllerDownInputPressed.BindRaw(this, &FShooterRecentlyMet::IncrementRecentlyMetCounter);
 				UserItem->OnControllerUpInputPressed.BindRaw(this, &FShooterRecentlyMet::DecrementRecentlyMetCounter);
 				UserItem->OnControllerFacebuttonDownPressed.BindRaw(this, &FShooterRecentlyMet::ViewSelectedUsersProfile);
@@ -6,6 +6,7 @@
 #include "ShooterStyle.h"
 #include "ShooterGameLoadingScreen.h"
 #include "ShooterGameInstance.h"
+#include "ShooterDemoCatalog.h"
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
@@ -17,6 +18,7 @@ void SShooterDemoList::Construct(const FArguments& InArgs)
 	StatusText			= FString();
 	
 	const int32 BoxWidth = 125;
+	const int32 SmallBoxWidth = 60;
 
 	ChildSlot
 	.VAlign(VAlign_Fill)
@@ -39,8 +41,11 @@ void SShooterDemoList::Construct(const FArguments& InArgs)
 				.OnMouseButtonDoubleClick(this,&SShooterDemoList::OnListItemDoubleClicked)
 				.HeaderRow(
 					SNew(SHeaderRow)
-					+ SHeaderRow::Column("DemoName").FixedWidth(BoxWidth*2).DefaultLabel(NSLOCTEXT("DemoList", "DemoNameColumn", "Demo Name"))
-					+ SHeaderRow::Column("Date").FixedWidth(BoxWidth*2).DefaultLabel(NSLOCTEXT("DemoList", "DateColumn", "Date"))
+					+ SHeaderRow::Column("DemoName").FixedWidth(BoxWidth - 25).DefaultLabel(NSLOCTEXT("DemoList", "DemoNameColumn", "Demo Name"))
+					+ SHeaderRow::Column("Map").FixedWidth(BoxWidth - 15).DefaultLabel(NSLOCTEXT("DemoList", "MapColumn", "Map"))
+					+ SHeaderRow::Column("Date").FixedWidth(BoxWidth + 35).DefaultLabel(NSLOCTEXT("DemoList", "DateColumn", "Date"))
+					+ SHeaderRow::Column("Duration").FixedWidth(SmallBoxWidth).DefaultLabel(NSLOCTEXT("DemoList", "DurationColumn", "Length"))
+					+ SHeaderRow::Column("Players").FixedWidth(SmallBoxWidth).DefaultLabel(NSLOCTEXT("DemoList", "PlayersColumn", "Players"))
 					+ SHeaderRow::Column("Size").HAlignHeader(HAlign_Left).HAlignCell(HAlign_Right).DefaultLabel(NSLOCTEXT("DemoList", "SizeColumn", "Size")))
 			]
 		]
@@ -62,53 +67,94 @@ void SShooterDemoList::Construct(const FArguments& InArgs)
 	BuildDemoList();
 }
 
-/** Updates the list until it's completely populated 
-  * While this function is currently a blocking call, it's designed to eventually allow 
-  * the demos to come from the cloud and download asynchronously
+/** Applies changes found by the demo catalog until it's done refreshing
+  * Stats of demo files are gathered on the catalog's worker thread, entries show up here
+  * in batches as they are found.
   */
 void SShooterDemoList::UpdateBuildDemoListStatus()
 {
-	check(bBuildingDemoList); // should not be called otherwise
+	FShooterDemoCatalog::FUpdate Update;
+	FShooterDemoCatalog::Get().PollUpdate(Update);
 
-	bool bFinished = true;
+	// Sort demo names by date
+	struct FCompareDateTime
+	{
+		FORCEINLINE bool operator()( const TSharedPtr<FDemoEntry> & A, const TSharedPtr<FDemoEntry> & B ) const
+		{
+			return A->DateTime.GetTicks() > B->DateTime.GetTicks();
+		}
+	};
 
-	const FString DemoPath = FPaths::GameSavedDir() + TEXT( "Demos/" );
-	const FString WildCardPath = DemoPath + TEXT( "*.demo" );
+	for ( int32 i = 0; i < Update.Changed.Num(); i++ )
+	{
+		const FShooterDemoInfo& Info = Update.Changed[i];
 
-	TArray<FString> FileNames;
-	IFileManager::Get().FindFiles( FileNames, *WildCardPath, true, false );
+		// changed demos get a new entry, rows are generated once per entry
+		TSharedPtr<FDemoEntry>& DemoEntry = DemoEntries.FindOrAdd( Info.DemoName );
+		const bool bWasSelected = DemoEntry.IsValid() && DemoEntry == SelectedItem;
+		if ( DemoEntry.IsValid() )
+		{
+			DemoList.Remove( DemoEntry );
+		}
+		DemoEntry = MakeShareable( new FDemoEntry() );
 
-	for ( int32 i = 0; i < FileNames.Num(); i++ )
-	{
-		TSharedPtr<FDemoEntry> NewDemoEntry = MakeShareable( new FDemoEntry() );
+		const float Size = (float)Info.Size / 1024;
 
-		float Size = (float)IFileManager::Get().FileSize( *( DemoPath + FileNames[i] ) ) / 1024;
+		DemoEntry->DemoName		= Info.DemoName;
+		DemoEntry->DateTime		= Info.TimeStamp;
+		DemoEntry->Date			= Info.TimeStamp.ToString( TEXT( "%m/%d/%Y %h:%M %A" ) );	// UTC time
+		DemoEntry->Size			= Size >= 1024.0f ? FString::Printf( TEXT("%2.2f MB" ), Size / 1024.0f ) : FString::Printf( TEXT("%i KB" ), (int)Size );
+		DemoEntry->MapName		= Info.MapName;
+		DemoEntry->Duration		= Info.Duration > 0 ? FString::Printf( TEXT("%i:%02i"), Info.Duration / 60, Info.Duration % 60 ) : FString();
+		DemoEntry->NumPlayers	= Info.NumPlayers > 0 ? FString::FromInt( Info.NumPlayers ) : FString();
 
-		NewDemoEntry->DemoName		= FileNames[i];
-		NewDemoEntry->DateTime		= IFileManager::Get().GetTimeStamp( *( DemoPath + FileNames[i] ) );
-		NewDemoEntry->Date			= NewDemoEntry->DateTime.ToString( TEXT( "%m/%d/%Y %h:%M %A" ) );	// UTC time
-		NewDemoEntry->Size			= Size >= 1024.0f ? FString::Printf( TEXT("%2.2f MB" ), Size / 1024.0f ) : FString::Printf( TEXT("%i KB" ), (int)Size );
-		NewDemoEntry->ResultsIndex	= i;
+		// keep list sorted, newer demos first
+		int32 InsertIndex = DemoList.Num();
+		for ( int32 Min = 0; Min < InsertIndex; )
+		{
+			const int32 Mid = ( Min + InsertIndex ) / 2;
+			if ( FCompareDateTime()( DemoEntry, DemoList[Mid] ) )
+			{
+				InsertIndex = Mid;
+			}
+			else
+			{
+				Min = Mid + 1;
+			}
+		}
+		DemoList.Insert( DemoEntry, InsertIndex );
 
-		DemoList.Add( NewDemoEntry );
+		if ( bWasSelected )
+		{
+			SelectedItem = DemoEntry;
+			DemoListWidget->SetSelection( DemoEntry, ESelectInfo::OnNavigation );
+		}
 	}
 
-	// Sort demo names by date
-	struct FCompareDateTime
+	for ( int32 i = 0; i < Update.Removed.Num(); i++ )
 	{
-		FORCEINLINE bool operator()( const TSharedPtr<FDemoEntry> & A, const TSharedPtr<FDemoEntry> & B ) const
+		TSharedPtr<FDemoEntry> DemoEntry;
+		if ( DemoEntries.RemoveAndCopyValue( Update.Removed[i], DemoEntry ) )
 		{
-			return A->DateTime.GetTicks() > B->DateTime.GetTicks();
+			DemoList.Remove( DemoEntry );
+			if ( SelectedItem == DemoEntry )
+			{
+				SelectedItem.Reset();
+			}
 		}
-	};
-
-	Sort( DemoList.GetData(), DemoList.Num(), FCompareDateTime() );
+	}
 
-	//StatusText = "";
-	StatusText = LOCTEXT("DemoSelectionInfo","Press ENTER to Play. Press DEL to delete.").ToString();
+	if ( Update.Changed.Num() > 0 || Update.Removed.Num() > 0 )
+	{
+		DemoListWidget->RequestListRefresh();
+		if ( !SelectedItem.IsValid() && DemoList.Num() > 0 )
+		{
+			DemoListWidget->SetSelection( DemoList[0], ESelectInfo::OnNavigation );
+		}
+	}
 
-	if ( bFinished )
-	{		
+	if ( bBuildingDemoList && Update.bFinished )
+	{
 		OnBuildDemoListFinished();
 	}
 }
@@ -129,23 +175,25 @@ void SShooterDemoList::Tick( const FGeometry& AllottedGeometry, const double InC
 {
 	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
 
-	if ( bBuildingDemoList )
-	{
-		UpdateBuildDemoListStatus();
-	}
+	// also picks up demos recorded or removed while the list is open
+	UpdateBuildDemoListStatus();
 }
 
 /** Populates the demo list */
 void SShooterDemoList::BuildDemoList()
 {
 	bBuildingDemoList = true;
-	DemoList.Empty();
+	StatusText = LOCTEXT("DemoListScanning","Looking for demos...").ToString();
+
+	// entries already listed are updated in place
+	FShooterDemoCatalog::Get().RequestRefresh( DemoList.Num() == 0 );
 }
 
 /** Called when demo list building is finished */
 void SShooterDemoList::OnBuildDemoListFinished()
 {
 	bBuildingDemoList = false;
+	StatusText = LOCTEXT("DemoSelectionInfo","Press ENTER to Play. Press DEL to delete.").ToString();
 
 	int32 SelectedItemIndex = DemoList.IndexOfByKey(SelectedItem);
 
@@ -159,12 +207,6 @@ void SShooterDemoList::OnBuildDemoListFinished()
 
 void SShooterDemoList::PlayDemo()
 {
-	if (bBuildingDemoList)
-	{
-		// We're still building the list
-		return;
-	}
-
 	if (SelectedItem.IsValid())
 	{
 		UShooterGameInstance* const GI = Cast<UShooterGameInstance>(PlayerOwner->GetGameInstance());
@@ -183,12 +225,6 @@ void SShooterDemoList::PlayDemo()
 
 void SShooterDemoList::DeleteDemo()
 {
-	if (bBuildingDemoList)
-	{
-		// We're still building the list
-		return;
-	}
-
 	if (SelectedItem.IsValid())
 	{
 		UShooterGameInstance* const GI = Cast<UShooterGameInstance>(PlayerOwner->GetGameInstance());
@@ -217,8 +253,7 @@ FReply SShooterDemoList::OnDemoDeleteConfirm()
 {
 	if (SelectedItem.IsValid())
 	{
-		const FString DemoPath = FPaths::GameSavedDir() + TEXT( "Demos/" );
-		const FString DemoName = DemoPath + SelectedItem->DemoName;
+		const FString DemoName = FShooterDemoCatalog::GetDemoDir() + SelectedItem->DemoName;
 
 		if ( IFileManager::Get().Delete( *DemoName ) )
 		{
@@ -295,11 +330,6 @@ void SShooterDemoList::MoveSelection(int32 MoveBy)
 
 FReply SShooterDemoList::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyboardEvent) 
 {
-	if (bBuildingDemoList) // lock input
-	{
-		return FReply::Handled();
-	}
-
 	FReply Result = FReply::Unhandled();
 	const FKey Key = InKeyboardEvent.GetKey();
 	if (Key == EKeys::Enter || Key == EKeys::Gamepad_FaceButton_Bottom)
@@ -315,7 +345,7 @@ FReply SShooterDemoList::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent&
 		FSlateApplication::Get().SetKeyboardFocus(SharedThis(this));
 	}
 	//hit space bar or left gamepad face button to search for demos again / refresh the list, only when not searching already
-	else if (Key == EKeys::SpaceBar || Key == EKeys::Gamepad_FaceButton_Left)
+	else if ((Key == EKeys::SpaceBar || Key == EKeys::Gamepad_FaceButton_Left) && !bBuildingDemoList)
 	{
 		// Refresh demo list
 		BuildDemoList();
@@ -355,10 +385,22 @@ TSharedRef<ITableRow> SShooterDemoList::MakeListViewWidget(TSharedPtr<FDemoEntry
 			{
 				ItemText = Item->DemoName;// + "extra stuff here";
 			}
+			else if (ColumnName == "Map")
+			{
+				ItemText = Item->MapName;
+			}
 			else if (ColumnName == "Date")
 			{
 				ItemText = Item->Date;
 			}
+			else if (ColumnName == "Duration")
+			{
+				ItemText = Item->Duration;
+			}
+			else if (ColumnName == "Players")
+			{
+				ItemText = Item->NumPlayers;
+			}
 			else if (ColumnName == "Size")
 			{
 				ItemText = Item->Size;
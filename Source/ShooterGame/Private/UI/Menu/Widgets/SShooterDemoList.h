@@ -13,7 +13,9 @@ struct FDemoEntry
 	FDateTime	DateTime;
 	FString		Date;
 	FString		Size;
-	int32		ResultsIndex;
+	FString		MapName;
+	FString		Duration;
+	FString		NumPlayers;
 };
 
 //class declare
@@ -52,7 +54,7 @@ public:
 	/** selection changed handler */
 	void EntrySelectionChanged(TSharedPtr<FDemoEntry> InItem, ESelectInfo::Type SelectInfo);
 
-	/** Updates the list until it's completely populated */
+	/** Applies changes found by the demo catalog, until it's done refreshing */
 	void UpdateBuildDemoListStatus();
 
 	/** Populates the demo list */
@@ -90,9 +92,12 @@ protected:
 	/** Whether we're building the demo list or not */
 	bool bBuildingDemoList;
 
-	/** action bindings array */
+	/** action bindings array, newest demo first */
 	TArray< TSharedPtr<FDemoEntry> > DemoList;
 
+	/** entries of DemoList keyed by file name */
+	TMap< FString, TSharedPtr<FDemoEntry> > DemoEntries;
+
 	/** action bindings list slate widget */
 	TSharedPtr< SListView< TSharedPtr<FDemoEntry> > > DemoListWidget; 
 
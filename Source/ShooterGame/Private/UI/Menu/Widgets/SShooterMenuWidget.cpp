@@ -303,6 +303,7 @@ void SShooterMenuWidget::BuildAndShowMenu()
 	// Set up right side and launch animation if there is any submenu
 	if (CurrentMenu.Num() > 0 && CurrentMenu.IsValidIndex(SelectedIndex) && CurrentMenu[SelectedIndex]->bVisible)
 	{
+		CurrentMenu[SelectedIndex]->BuildSubMenu();
 		NextMenu = CurrentMenu[SelectedIndex]->SubMenu;
 		if (NextMenu.Num() > 0)
 		{
@@ -562,6 +563,7 @@ void SShooterMenuWidget::MenuGoBack(bool bSilent)
 
 void SShooterMenuWidget::ConfirmMenuItem()
 {
+	CurrentMenu[SelectedIndex]->BuildSubMenu();
 	if (CurrentMenu[SelectedIndex]->OnConfirmMenuItem.IsBound())
 	{
 		CurrentMenu[SelectedIndex]->OnConfirmMenuItem.Execute();
@@ -777,6 +779,7 @@ FReply SShooterMenuWidget::ButtonClicked(int32 ButtonIndex)
 		SelectedIndex = ButtonIndex;
 		MenuItem = CurrentMenu[SelectedIndex]->Widget;
 		MenuItem->SetMenuItemActive(true);
+		CurrentMenu[SelectedIndex]->BuildSubMenu();
 		NextMenu = CurrentMenu[SelectedIndex]->SubMenu;
 		bSubMenuChanging = true;
 		FSlateApplication::Get().PlaySound(MenuStyle->MenuItemChangeSound, GetOwnerUserIndex());
@@ -9,6 +9,78 @@
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
+int32 GShooterServerListStandInSessions = 0;
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleVariableRef CVarShooterServerListStandInSessions(
+	TEXT("shooter.ServerListStandInSessions"),
+	GShooterServerListStandInSessions,
+	TEXT("When non zero, server searches from the menu list this many generated sessions instead of querying the online subsystem.\n")
+	TEXT("Used to test the server list with many servers. Stand-in sessions go through the same result handling, but can't be joined.\n")
+	TEXT("Default is 0."),
+	ECVF_Default
+	);
+#endif
+
+/** search results turned into list entries per tick, so large result sets don't hitch the menu */
+static const int32 MaxEntriesPerTick = 256;
+
+struct FCompareServerEntry
+{
+	EServerListSort::Type SortMode;
+
+	FCompareServerEntry(EServerListSort::Type InSortMode)
+		: SortMode(InSortMode)
+	{
+	}
+
+	FORCEINLINE bool operator()(const TSharedPtr<FServerEntry>& A, const TSharedPtr<FServerEntry>& B) const
+	{
+		if (SortMode == EServerListSort::Players && A->CurrentPlayers != B->CurrentPlayers)
+		{
+			return A->CurrentPlayers > B->CurrentPlayers;
+		}
+		return A->Ping < B->Ping;
+	}
+};
+
+/** id used to recognize a session across updates of the search results, empty if it has no session info */
+static FString GetSessionId(const FOnlineSessionSearchResult& Result)
+{
+	return Result.Session.SessionInfo.IsValid() ? Result.Session.SessionInfo->GetSessionId().ToString() : FString();
+}
+
+/** set the result an entry joins, and the ping and player counts it displays from it */
+static void SetEntryResult(FServerEntry& Entry, const FOnlineSessionSearchResult& Result)
+{
+	Entry.Ping = Result.PingInMs;
+	Entry.CurrentPlayers = Result.Session.SessionSettings.NumPublicConnections 
+		+ Result.Session.SessionSettings.NumPrivateConnections 
+		- Result.Session.NumOpenPublicConnections 
+		- Result.Session.NumOpenPrivateConnections;
+	Entry.MaxPlayers = Result.Session.SessionSettings.NumPublicConnections
+		+ Result.Session.SessionSettings.NumPrivateConnections;
+	Entry.SearchResult = Result;
+}
+
+/** index to insert Entry at to keep List sorted, after entries comparing equal */
+static int32 FindSortedIndex(const TArray< TSharedPtr<FServerEntry> >& List, const TSharedPtr<FServerEntry>& Entry, const FCompareServerEntry& Compare)
+{
+	int32 InsertIndex = List.Num();
+	for (int32 Min = 0; Min < InsertIndex; )
+	{
+		const int32 Mid = (Min + InsertIndex) / 2;
+		if (Compare(Entry, List[Mid]))
+		{
+			InsertIndex = Mid;
+		}
+		else
+		{
+			Min = Mid + 1;
+		}
+	}
+	return InsertIndex;
+}
+
 void SShooterServerList::Construct(const FArguments& InArgs)
 {
 	PlayerOwner = InArgs._PlayerOwner;
@@ -16,6 +88,11 @@ void SShooterServerList::Construct(const FArguments& InArgs)
 	MapFilterName = "Any";
 	bSearchingForServers = false;
 	bLANMatchSearch = false;
+	bStandInSearch = false;
+	NumResultsAdded = 0;
+	bResultsFinal = false;
+	SearchStartTime = 0.0;
+	SortMode = EServerListSort::Ping;
 	StatusText = FString();
 	BoxWidth = 125;
 
@@ -43,8 +120,8 @@ void SShooterServerList::Construct(const FArguments& InArgs)
 					+ SHeaderRow::Column("ServerName").FixedWidth(BoxWidth*2) .DefaultLabel(NSLOCTEXT("ServerList", "ServerNameColumn", "Server Name"))
 					+ SHeaderRow::Column("GameType") .DefaultLabel(NSLOCTEXT("ServerList", "GameTypeColumn", "Game Type"))
 					+ SHeaderRow::Column("Map").DefaultLabel(NSLOCTEXT("ServerList", "MapNameColumn", "Map"))
-					+ SHeaderRow::Column("Players") .DefaultLabel(NSLOCTEXT("ServerList", "PlayersColumn", "Players"))
-					+ SHeaderRow::Column("Ping") .DefaultLabel(NSLOCTEXT("ServerList", "NetworkPingColumn", "Ping")))
+					+ SHeaderRow::Column("Players") .DefaultLabel(NSLOCTEXT("ServerList", "PlayersColumn", "Players")).SortMode(this, &SShooterServerList::GetColumnSortMode, EServerListSort::Players)
+					+ SHeaderRow::Column("Ping") .DefaultLabel(NSLOCTEXT("ServerList", "NetworkPingColumn", "Ping")).SortMode(this, &SShooterServerList::GetColumnSortMode, EServerListSort::Ping))
 			]
 		]
 		+SVerticalBox::Slot()
@@ -78,90 +155,230 @@ void SShooterServerList::UpdateSearchStatus()
 {
 	check(bSearchingForServers); // should not be called otherwise
 
+	const int32 NumEntriesBefore = AllServers.Num();
+
 	bool bFinishSearch = true;
-	AShooterGameSession* ShooterSession = GetGameSession();
-	if (ShooterSession)
+	if (bStandInSearch)
+	{
+		StatusText = LOCTEXT("Searching","SEARCHING...").ToString();
+		bFinishSearch = AddNewSearchResults(StandInResults);
+	}
+	else
 	{
-		int32 CurrentSearchIdx, NumSearchResults;
-		EOnlineAsyncTaskState::Type SearchState = ShooterSession->GetSearchResultStatus(CurrentSearchIdx, NumSearchResults);
+		AShooterGameSession* ShooterSession = GetGameSession();
+		if (ShooterSession)
+		{
+			int32 CurrentSearchIdx, NumSearchResults;
+			EOnlineAsyncTaskState::Type SearchState = ShooterSession->GetSearchResultStatus(CurrentSearchIdx, NumSearchResults);
 
-		UE_LOG(LogOnlineGame, Log, TEXT("ShooterSession->GetSearchResultStatus: %s"), EOnlineAsyncTaskState::ToString(SearchState) );
+			UE_LOG(LogOnlineGame, Verbose, TEXT("ShooterSession->GetSearchResultStatus: %s"), EOnlineAsyncTaskState::ToString(SearchState) );
 
-		switch(SearchState)
-		{
-			case EOnlineAsyncTaskState::InProgress:
-				StatusText = LOCTEXT("Searching","SEARCHING...").ToString();
-				bFinishSearch = false;
-				break;
-
-			case EOnlineAsyncTaskState::Done:
-				// copy the results
-				{
-					ServerList.Empty();
-					const TArray<FOnlineSessionSearchResult> & SearchResults = ShooterSession->GetSearchResults();
-					check(SearchResults.Num() == NumSearchResults);
-					if (NumSearchResults == 0)
+			switch(SearchState)
+			{
+				case EOnlineAsyncTaskState::InProgress:
+					StatusText = LOCTEXT("Searching","SEARCHING...").ToString();
+					// LAN hosts are added to the results as they answer, list them right away
+					AddNewSearchResults(ShooterSession->GetSearchResults());
+					bFinishSearch = false;
+					break;
+
+				case EOnlineAsyncTaskState::Done:
+					if (!bResultsFinal)
 					{
+						ResolveFinalResults(ShooterSession->GetSearchResults());
+					}
+					// add the rest of the results, a few at a time
+					bFinishSearch = AddNewSearchResults(ShooterSession->GetSearchResults());
+					break;
+
+				case EOnlineAsyncTaskState::Failed:
+					// intended fall-through
+				case EOnlineAsyncTaskState::NotStarted:
+					StatusText = "";
+					// intended fall-through
+				default:
+					break;
+			}
+		}
+	}
+
+	if (AllServers.Num() != NumEntriesBefore)
+	{
+		RefreshListWidget();
+	}
+
+	if (bFinishSearch)
+	{
+		OnServerSearchFinished();
+	}
+}
+
+bool SShooterServerList::AddNewSearchResults(const TArray<FOnlineSessionSearchResult>& SearchResults)
+{
+	const int32 NumToAdd = FMath::Min(SearchResults.Num() - NumResultsAdded, MaxEntriesPerTick);
+	for (int32 IdxResult = NumResultsAdded; IdxResult < NumResultsAdded + NumToAdd; ++IdxResult)
+	{
+		const FOnlineSessionSearchResult& Result = SearchResults[IdxResult];
+
+		const FString SessionId = GetSessionId(Result);
+		if (!SessionId.IsEmpty())
+		{
+			bool bAlreadyListed = false;
+			ListedSessionIds.Add(SessionId, &bAlreadyListed);
+			if (bAlreadyListed)
+			{
+				continue;
+			}
+		}
+
+		TSharedPtr<FServerEntry> NewServerEntry = MakeShareable(new FServerEntry());
+
+		NewServerEntry->ServerName = Result.Session.OwningUserName;
+		SetEntryResult(*NewServerEntry, Result);
+		NewServerEntry->SessionId = SessionId;
+	
+		Result.Session.SessionSettings.Get(SETTING_GAMEMODE, NewServerEntry->GameType);
+		Result.Session.SessionSettings.Get(SETTING_MAPNAME, NewServerEntry->MapName);
+
+		AddServerEntry(NewServerEntry);
+	}
+	NumResultsAdded += FMath::Max(NumToAdd, 0);
+
+	return NumResultsAdded >= SearchResults.Num();
+}
+
+void SShooterServerList::ResolveFinalResults(const TArray<FOnlineSessionSearchResult>& SearchResults)
+{
+	bResultsFinal = true;
+	if (NumResultsAdded == 0)
+	{
+		return;
+	}
+
+	TMap<FString, int32> FinalIndices;
+	for (int32 IdxResult = 0; IdxResult < SearchResults.Num(); ++IdxResult)
+	{
+		const FString SessionId = GetSessionId(SearchResults[IdxResult]);
+		if (!SessionId.IsEmpty())
+		{
+			FinalIndices.Add(SessionId, IdxResult);
+		}
+	}
+
+	// keep entries still in the results, updating them from the final result. The rest is dropped and listed again if it's still there
+	for (int32 i = AllServers.Num() - 1; i >= 0; --i)
+	{
+		const TSharedPtr<FServerEntry> Entry = AllServers[i];
+		const int32* FinalIndex = Entry->SessionId.IsEmpty() ? NULL : FinalIndices.Find(Entry->SessionId);
+		if (FinalIndex)
+		{
+			SetEntryResult(*Entry, SearchResults[*FinalIndex]);
+		}
+		else
+		{
+			AllServers.RemoveAt(i);
+			ServerList.Remove(Entry);
+			ListedSessionIds.Remove(Entry->SessionId);
+			if (SelectedItem == Entry)
+			{
+				SelectedItem.Reset();
+			}
+		}
+	}
+
+	// ping and player counts may have changed
+	const FCompareServerEntry Compare(SortMode);
+	AllServers.Sort(Compare);
+	ServerList.Sort(Compare);
+
+	// go over the final results from the start, sessions listed already are skipped by id
+	NumResultsAdded = 0;
+	RefreshListWidget();
+}
+
+void SShooterServerList::CreateStandInResults(int32 NumSessions)
+{
+	static const TCHAR* StandInMapNames[] = { TEXT("Sanctuary"), TEXT("Highrise") };
+	static const TCHAR* StandInGameTypes[] = { TEXT("FFA"), TEXT("TDM") };
+
+	StandInResults.Reset(NumSessions);
+	for (int32 Idx = 0; Idx < NumSessions; ++Idx)
+	{
+		// seeded by index, so every search lists the same sessions
+		FRandomStream RandomStream(Idx);
+
+		// no session info, so the result isn't valid for joining
+		FOnlineSessionSearchResult& Result = StandInResults[StandInResults.AddDefaulted()];
+		Result.Session.OwningUserName = FString::Printf(TEXT("StandIn%d"), Idx);
+		Result.Session.SessionSettings.Set(SETTING_GAMEMODE, FString(StandInGameTypes[RandomStream.RandHelper(ARRAY_COUNT(StandInGameTypes))]), EOnlineDataAdvertisementType::ViaOnlineService);
+		Result.Session.SessionSettings.Set(SETTING_MAPNAME, FString(StandInMapNames[RandomStream.RandHelper(ARRAY_COUNT(StandInMapNames))]), EOnlineDataAdvertisementType::ViaOnlineService);
+		Result.Session.SessionSettings.NumPublicConnections = 8;
+		Result.Session.NumOpenPublicConnections = Result.Session.SessionSettings.NumPublicConnections - RandomStream.RandRange(0, Result.Session.SessionSettings.NumPublicConnections);
+		Result.PingInMs = RandomStream.RandRange(5, 300);
+	}
+}
+
+void SShooterServerList::AddServerEntry(const TSharedPtr<FServerEntry>& Entry)
+{
+	/** Only filter maps if a specific map is specified */
+	Entry->bPassesFilter = MapFilterName == "Any" || Entry->MapName == MapFilterName;
+
+	const FCompareServerEntry Compare(SortMode);
+	AllServers.Insert(Entry, FindSortedIndex(AllServers, Entry, Compare));
+	if (Entry->bPassesFilter)
+	{
+		ServerList.Insert(Entry, FindSortedIndex(ServerList, Entry, Compare));
+	}
+}
+
+void SShooterServerList::ToggleSortMode()
+{
+	SortMode = (SortMode == EServerListSort::Ping) ? EServerListSort::Players : EServerListSort::Ping;
+
+	const FCompareServerEntry Compare(SortMode);
+	AllServers.Sort(Compare);
+	ServerList.Sort(Compare);
+
+	RefreshListWidget();
+	if (SelectedItem.IsValid())
+	{
+		ServerListWidget->RequestScrollIntoView(SelectedItem);
+	}
+}
+
+EColumnSortMode::Type SShooterServerList::GetColumnSortMode(EServerListSort::Type ColumnSortMode) const
+{
+	if (SortMode != ColumnSortMode)
+	{
+		return EColumnSortMode::None;
+	}
+	return (SortMode == EServerListSort::Ping) ? EColumnSortMode::Ascending : EColumnSortMode::Descending;
+}
+
+void SShooterServerList::SetSearchFinishedStatus()
+{
+	if (AllServers.Num() == 0)
+	{
 #if PLATFORM_PS4
-						StatusText = LOCTEXT("NoServersFound","NO SERVERS FOUND, PRESS SQUARE TO TRY AGAIN").ToString();
+		StatusText = LOCTEXT("NoServersFound","NO SERVERS FOUND, PRESS SQUARE TO TRY AGAIN").ToString();
 #elif PLATFORM_XBOXONE
-						StatusText = LOCTEXT("NoServersFound","NO SERVERS FOUND, PRESS X TO TRY AGAIN").ToString();
+		StatusText = LOCTEXT("NoServersFound","NO SERVERS FOUND, PRESS X TO TRY AGAIN").ToString();
 #else
-						StatusText = LOCTEXT("NoServersFound","NO SERVERS FOUND, PRESS SPACE TO TRY AGAIN").ToString();
+		StatusText = LOCTEXT("NoServersFound","NO SERVERS FOUND, PRESS SPACE TO TRY AGAIN").ToString();
 #endif
-					}
-					else
-					{
+	}
+	else
+	{
 #if PLATFORM_PS4
-						StatusText = LOCTEXT("ServersRefresh","PRESS SQUARE TO REFRESH SERVER LIST").ToString();
+		StatusText = LOCTEXT("ServersRefresh","PRESS SQUARE TO REFRESH SERVER LIST").ToString();
 #elif PLATFORM_XBOXONE
-						StatusText = LOCTEXT("ServersRefresh","PRESS X TO REFRESH SERVER LIST").ToString();
+		StatusText = LOCTEXT("ServersRefresh","PRESS X TO REFRESH SERVER LIST").ToString();
 #else
-						StatusText = LOCTEXT("ServersRefresh","PRESS SPACE TO REFRESH SERVER LIST").ToString();
+		StatusText = LOCTEXT("ServersRefresh","PRESS SPACE TO REFRESH SERVER LIST").ToString();
 #endif
-					}
-
-					for (int32 IdxResult = 0; IdxResult < NumSearchResults; ++IdxResult)
-					{
-						TSharedPtr<FServerEntry> NewServerEntry = MakeShareable(new FServerEntry());
-
-						const FOnlineSessionSearchResult& Result = SearchResults[IdxResult];
-
-						NewServerEntry->ServerName = Result.Session.OwningUserName;
-						NewServerEntry->Ping = FString::FromInt(Result.PingInMs);
-						NewServerEntry->CurrentPlayers = FString::FromInt(Result.Session.SessionSettings.NumPublicConnections 
-							+ Result.Session.SessionSettings.NumPrivateConnections 
-							- Result.Session.NumOpenPublicConnections 
-							- Result.Session.NumOpenPrivateConnections);
-						NewServerEntry->MaxPlayers = FString::FromInt(Result.Session.SessionSettings.NumPublicConnections
-							+ Result.Session.SessionSettings.NumPrivateConnections);
-						NewServerEntry->SearchResultsIndex = IdxResult;
-					
-						Result.Session.SessionSettings.Get(SETTING_GAMEMODE, NewServerEntry->GameType);
-						Result.Session.SessionSettings.Get(SETTING_MAPNAME, NewServerEntry->MapName);
-
-						ServerList.Add(NewServerEntry);
-					}
-				}
-				break;
-
-			case EOnlineAsyncTaskState::Failed:
-				// intended fall-through
-			case EOnlineAsyncTaskState::NotStarted:
-				StatusText = "";
-				// intended fall-through
-			default:
-				break;
-		}
-	}
-
-	if (bFinishSearch)
-	{		
-		OnServerSearchFinished();
 	}
 }
 
-
 FString SShooterServerList::GetBottomText() const
 {
 	 return StatusText;
@@ -190,7 +407,21 @@ void SShooterServerList::BeginServerSearch(bool bLANMatch, const FString& InMapF
 	bLANMatchSearch = bLANMatch;
 	MapFilterName = InMapFilterName;
 	bSearchingForServers = true;
+	AllServers.Empty();
 	ServerList.Empty();
+	SelectedItem.Reset();
+	NumResultsAdded = 0;
+	bResultsFinal = false;
+	ListedSessionIds.Empty();
+	StandInResults.Empty();
+	SearchStartTime = FPlatformTime::Seconds();
+
+	bStandInSearch = GShooterServerListStandInSessions > 0;
+	if (bStandInSearch)
+	{
+		CreateStandInResults(GShooterServerListStandInSessions);
+		return;
+	}
 
 	UShooterGameInstance* const GI = Cast<UShooterGameInstance>(PlayerOwner->GetGameInstance());
 	if (GI)
@@ -204,24 +435,29 @@ void SShooterServerList::OnServerSearchFinished()
 {
 	bSearchingForServers = false;
 
+	UE_LOG(LogOnlineGame, Log, TEXT("Server list: %d servers listed, %d after filter, in %.1f ms"), AllServers.Num(), ServerList.Num(), (FPlatformTime::Seconds() - SearchStartTime) * 1000.0);
+
+	SetSearchFinishedStatus();
 	UpdateServerList();
 }
 
 void SShooterServerList::UpdateServerList()
 {
-	/** Only filter maps if a specific map is specified */
-	if (MapFilterName != "Any")
+	// entries are kept sorted and filtered as they are added, just rebuild the visible list from the cached filter results
+	ServerList.Reset();
+	for (int32 i = 0; i < AllServers.Num(); ++i)
 	{
-		for (int32 i = 0; i < ServerList.Num(); ++i)
+		if (AllServers[i]->bPassesFilter)
 		{
-			/** Only filter maps if a specific map is specified */
-			if (ServerList[i]->MapName != MapFilterName)
-			{
-				ServerList.RemoveAt(i);
-			}
+			ServerList.Add(AllServers[i]);
 		}
 	}
 
+	RefreshListWidget();
+}
+
+void SShooterServerList::RefreshListWidget()
+{
 	int32 SelectedItemIndex = ServerList.IndexOfByKey(SelectedItem);
 
 	ServerListWidget->RequestListRefresh();
@@ -230,7 +466,6 @@ void SShooterServerList::UpdateServerList()
 		ServerListWidget->UpdateSelectionSet();
 		ServerListWidget->SetSelection(ServerList[SelectedItemIndex > -1 ? SelectedItemIndex : 0],ESelectInfo::OnNavigation);
 	}
-
 }
 
 void SShooterServerList::ConnectToServer()
@@ -246,9 +481,8 @@ void SShooterServerList::ConnectToServer()
 		return;
 	}
 #endif
-	if (SelectedItem.IsValid())
+	if (SelectedItem.IsValid() && SelectedItem->SearchResult.IsValid())
 	{
-		int ServerToJoin = SelectedItem->SearchResultsIndex;
 
 		if (GEngine && GEngine->GameViewport)
 		{
@@ -258,7 +492,7 @@ void SShooterServerList::ConnectToServer()
 		UShooterGameInstance* const GI = Cast<UShooterGameInstance>(PlayerOwner->GetGameInstance());
 		if (GI)
 		{
-			GI->JoinSession(PlayerOwner.Get(), ServerToJoin);
+			GI->JoinSession(PlayerOwner.Get(), SelectedItem->SearchResult);
 		}
 	}
 }
@@ -300,11 +534,6 @@ void SShooterServerList::MoveSelection(int32 MoveBy)
 
 FReply SShooterServerList::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent) 
 {
-	if (bSearchingForServers) // lock input
-	{
-		return FReply::Handled();
-	}
-
 	FReply Result = FReply::Unhandled();
 	const FKey Key = InKeyEvent.GetKey();
 	
@@ -325,10 +554,15 @@ FReply SShooterServerList::OnKeyDown(const FGeometry& MyGeometry, const FKeyEven
 		FSlateApplication::Get().SetKeyboardFocus(SharedThis(this));
 	}
 	//hit space bar to search for servers again / refresh the list, only when not searching already
-	else if (Key == EKeys::SpaceBar || Key == EKeys::Gamepad_FaceButton_Left)
+	else if ((Key == EKeys::SpaceBar || Key == EKeys::Gamepad_FaceButton_Left) && !bSearchingForServers)
 	{
 		BeginServerSearch(bLANMatchSearch, "Any");
 	}
+	else if (Key == EKeys::Tab || Key == EKeys::Gamepad_RightShoulder)
+	{
+		ToggleSortMode();
+		Result = FReply::Handled();
+	}
 	return Result;
 }
 
@@ -363,12 +597,11 @@ TSharedRef<ITableRow> SShooterServerList::MakeListViewWidget(TSharedPtr<FServerE
 			}
 			else if (ColumnName == "Players")
 			{
-				const FText PlayersOnServer = FText::Format( FText::FromString("{0}/{1}"), FText::FromString(Item->CurrentPlayers), FText::FromString(Item->MaxPlayers) );
-				ItemText = PlayersOnServer.ToString();
+				ItemText = FString::Printf(TEXT("%d/%d"), Item->CurrentPlayers, Item->MaxPlayers);
 			}
 			else if (ColumnName == "Ping")
 			{
-				ItemText = Item->Ping;
+				ItemText = FString::FromInt(Item->Ping);
 			} 
 			return SNew(STextBlock)
 				.Text(ItemText)
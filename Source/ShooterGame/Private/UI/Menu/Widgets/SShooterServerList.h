@@ -10,14 +10,33 @@
 struct FServerEntry
 {
 	FString ServerName;
-	FString CurrentPlayers;
-	FString MaxPlayers;
 	FString GameType;
 	FString MapName;
-	FString Ping;
-	int32 SearchResultsIndex;
+	int32 CurrentPlayers;
+	int32 MaxPlayers;
+	int32 Ping;
+
+	/** session to join, not valid for stand-in sessions */
+	FOnlineSessionSearchResult SearchResult;
+
+	/** id of the session, empty when the result has no session info */
+	FString SessionId;
+
+	/** cached result of the map filter */
+	bool bPassesFilter;
 };
 
+namespace EServerListSort
+{
+	enum Type
+	{
+		/** lowest ping first */
+		Ping,
+		/** most players first */
+		Players,
+	};
+}
+
 //class declare
 class SShooterServerList : public SShooterMenuWidget
 {
@@ -70,9 +89,33 @@ public:
 	/** Called when server search is finished */
 	void OnServerSearchFinished();
 
+	/** add search results received since last update, returns false if they are not all in yet */
+	bool AddNewSearchResults(const TArray<FOnlineSessionSearchResult>& SearchResults);
+
+	/** match entries listed while the search was in progress against the final results, which may be reordered or deduplicated */
+	void ResolveFinalResults(const TArray<FOnlineSessionSearchResult>& SearchResults);
+
+	/** generate search results for stand-in sessions, for testing the list with many servers */
+	void CreateStandInResults(int32 NumSessions);
+
+	/** add entry to the sorted lists */
+	void AddServerEntry(const TSharedPtr<FServerEntry>& Entry);
+
+	/** switch between sorting by ping and by players */
+	void ToggleSortMode();
+
+	/** sort indicator of column sorting by ColumnSortMode */
+	EColumnSortMode::Type GetColumnSortMode(EServerListSort::Type ColumnSortMode) const;
+
+	/** set status text once all results are in */
+	void SetSearchFinishedStatus();
+
 	/** fill/update server list, should be called before showing this control */
 	void UpdateServerList();
 
+	/** refresh list widget after entries changed, keeping selection */
+	void RefreshListWidget();
+
 	/** connect to chosen server */
 	void ConnectToServer();
 
@@ -96,7 +139,31 @@ protected:
 	/** Whether we're searching for servers */
 	bool bSearchingForServers;
 
-	/** action bindings array */
+	/** Whether the current search uses stand-in sessions instead of the online subsystem */
+	bool bStandInSearch;
+
+	/** search results turned into entries so far */
+	int32 NumResultsAdded;
+
+	/** have the entries been matched against the final search results? */
+	bool bResultsFinal;
+
+	/** ids of the sessions listed in the current search */
+	TSet<FString> ListedSessionIds;
+
+	/** generated results of the current stand-in search */
+	TArray<FOnlineSessionSearchResult> StandInResults;
+
+	/** when the current search started, for logging */
+	double SearchStartTime;
+
+	/** current sort order of the lists */
+	EServerListSort::Type SortMode;
+
+	/** all entries of the current search, sorted */
+	TArray< TSharedPtr<FServerEntry> > AllServers;
+
+	/** entries passing the map filter, sorted. Source of the list widget */
 	TArray< TSharedPtr<FServerEntry> > ServerList;
 
 	/** action bindings list slate widget */
@@ -60,12 +60,18 @@ public:
 	/** multi-choice option changed, parameters are menu item itself and new multi-choice index  */
 	DECLARE_DELEGATE_TwoParams(FOnOptionChanged, TSharedPtr<FShooterMenuItem>, int32);
 
+	/** build sub menu delegate */
+	DECLARE_DELEGATE(FOnBuildSubMenu);
+
 	/** delegate, which is executed by SShooterMenuWidget if user confirms this menu item */
 	FOnConfirmMenuItem OnConfirmMenuItem;
 
 	/** multi-choice option changed, parameters are menu item itself and new multi-choice index */
 	FOnOptionChanged OnOptionChanged;
 
+	/** delegate, which is executed by SShooterMenuWidget the first time the sub menu is shown, lets expensive sub menus be built on demand */
+	FOnBuildSubMenu OnBuildSubMenu;
+
 	/** delegate, which is executed by SShooterMenuWidget if user presses FacebuttonLeft */
 	FOnControllerFacebuttonLeftPressed OnControllerFacebuttonLeftPressed;
 
@@ -146,6 +152,17 @@ public:
 		}
 	}
 
+	/** builds the sub menu if it's built on demand and hasn't been built yet */
+	void BuildSubMenu()
+	{
+		if (OnBuildSubMenu.IsBound())
+		{
+			FOnBuildSubMenu Build = OnBuildSubMenu;
+			OnBuildSubMenu.Unbind();
+			Build.Execute();
+		}
+	}
+
 	/** create special root item */
 	static TSharedRef<FShooterMenuItem> CreateRoot()
 	{
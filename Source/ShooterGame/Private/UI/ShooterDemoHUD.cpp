@@ -60,6 +60,28 @@ void AShooterDemoHUD::DrawHUD()
 	TileItemDemoPos.BlendMode = SE_BLEND_Translucent;
 	Canvas->DrawItem( TileItemDemoPos );
 
+	// Draw seek target until the seek is done
+	const AShooterDemoSpectator* DemoSpectator = Cast<AShooterDemoSpectator>( PlayerOwner );
+
+	if ( DemoSpectator && DemoSpectator->IsSeeking() )
+	{
+		const float SeekPosX = SizeX * ( DemoSpectator->GetSeekTargetTime() / DemoNetDriver->DemoTotalTime );
+
+		FCanvasTileItem TileItemSeekPos( FVector2D( X + SeekPosX - TickSizeX * 0.5f, Y + ( SizeY - TickSizeY ) * 0.5f ), FVector2D( TickSizeX, TickSizeY ), FColor( 250, 200, 50, 255 ) );
+		TileItemSeekPos.BlendMode = SE_BLEND_Translucent;
+		Canvas->DrawItem( TileItemSeekPos );
+
+		const FString SeekString = TEXT( "SEEKING" );
+
+		const FText SeekText = FText::FromString( SeekString );
+
+		float TextSizeX, TextSizeY;
+		Canvas->StrLen( GEngine->GetSmallFont(), SeekString, TextSizeX, TextSizeY );
+
+		FCanvasTextItem TextItem( FVector2D( X + SizeX * 0.5f - TextSizeX * 0.5f, Y - TextSizeY - 4 ), SeekText, GEngine->GetSmallFont(), FLinearColor::White );
+		Canvas->DrawItem( TextItem );
+	}
+
 	{
 		FText PlaybackText = FText::FromString( FString( TEXT( "PAUSED" ) ) );
 
@@ -4,9 +4,15 @@
 #include "SShooterScoreboardWidget.h"
 #include "SChatWidget.h"
 #include "Engine/ViewportSplitScreen.h"
+#include "ShooterStats.h"
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
+DECLARE_CYCLE_STAT(TEXT("HUD Player 1"), STAT_ShooterHUDPlayer1, STATGROUP_ShooterHUD);
+DECLARE_CYCLE_STAT(TEXT("HUD Player 2"), STAT_ShooterHUDPlayer2, STATGROUP_ShooterHUD);
+DECLARE_CYCLE_STAT(TEXT("HUD Player 3"), STAT_ShooterHUDPlayer3, STATGROUP_ShooterHUD);
+DECLARE_CYCLE_STAT(TEXT("HUD Player 4"), STAT_ShooterHUDPlayer4, STATGROUP_ShooterHUD);
+
 const float AShooterHUD::MinHudScale = 0.5f;
 
 AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -19,6 +25,15 @@ AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(Ob
 	LastKillTime = - KillFadeOutTime;
 	LastEnemyHitTime = -LastEnemyHitDisplayTime;
 
+	CenteredKillMessageSize = FVector2D(-1.0f, -1.0f);
+	InteractTextSize = FVector2D(0.0f, 0.0f);
+	InteractAmmoTextSize = FVector2D(0.0f, 0.0f);
+	LastCanvasLayout = FVector4(0.0f, 0.0f, 0.0f, 0.0f);
+	LastScaleUI = 0.0f;
+	LayoutVersion = 0;
+	DeathMessagesVersion = 0;
+	WarmupInfoSeconds = INDEX_NONE;
+
 	OnPlayerTalkingStateChangedDelegate = FOnPlayerTalkingStateChangedDelegate::CreateUObject(this, &AShooterHUD::OnPlayerTalkingStateChanged);
 
 	static ConstructorHelpers::FObjectFinder<UTexture2D> HitTextureOb(TEXT("/Game/UI/HUD/HitIndicator"));
@@ -124,70 +139,57 @@ FString AShooterHUD::GetTimeString(float TimeSeconds)
 void AShooterHUD::DrawInteract()
 {
 	AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetOwningPawn());
-	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(PlayerOwner);
-	AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyPC->PlayerState);
 
 	AActor* PointingAtObject = NULL;
 
 	if (MyPawn->CanInteract(&PointingAtObject))
 	{
-		//Get the Object's name, the first stored tag.
-		FString ObjectText = FString();
-		ObjectText = PointingAtObject->Tags[0].ToString();
-
-
 		AShooterWeaponPickup* PointingAtPickup = Cast<AShooterWeaponPickup>(PointingAtObject);
 		AShooterWeapon* PointingAtWeapon = PointingAtPickup->WeaponPickup;
-
-		float TextXL;
-		float TextYL;
-		//const float TextOffsetX = 200;
-		//const float TextOffsetY = 250;
-		const float TextOffsetX = -100;
-		const float TextOffsetY = 100;
-		Canvas->TextSize(NormalFont, ObjectText, TextXL, TextYL, ScaleUI, ScaleUI);
-
-		//Where to draw the "interact" prompt
-		/*const float TextPosX = Canvas->ClipX - Canvas->OrgX - ((TextOffsetX + TextXL) / 2.0f + 2 * Offset) * ScaleUI;
-		const float TextPosY = Canvas->ClipY - Canvas->OrgY - ((TextOffsetY + TextYL) / 2 + Offset) * ScaleUI;*/
-
-		const float TextPosX = (Canvas->ClipX - (TextXL- TextOffsetX) * ScaleUI) / 2;
-		const float TextPosY = Canvas->ClipY - (Offset + TextYL + TextOffsetY) * ScaleUI;
 		AShooterWeapon* PawnWeapon = MyPawn->FindWeapon(PointingAtPickup->WeaponType);
-		//if the player already has this weapon
-		if (PawnWeapon)
-		{
-			//Draw the weapon name dark
-			Canvas->SetDrawColor(HUDDark);
-		}
-		else
+		const int32 PawnAmmo = PawnWeapon ? PawnWeapon->GetCurrentAmmo() : INDEX_NONE;
+		const int32 PickupAmmo = PointingAtWeapon->GetCurrentAmmo();
+		const bool bShowAmmo = PawnWeapon && PawnAmmo < PawnWeapon->GetMaxAmmo() && PickupAmmo > 0;
+
+		if (InteractElement.NeedsRebuild(LayoutVersion, (UPTRINT)PointingAtObject, ((int64)(uint32)PawnAmmo << 32) | (uint32)PickupAmmo))
 		{
-			//draw it white
-			Canvas->SetDrawColor(FColor::White);
-		}
+			FShooterHUDDrawList& DrawList = InteractElement.DrawList;
 
-		//Draw the interact prompt
-		
-		Canvas->DrawText(NormalFont, ObjectText, TextPosX, TextPosY, ScaleUI*2, ScaleUI*2, ShadowedFont);
+			// texts only change with the focused object, layout and ammo changes reuse the measured sizes
+			if (InteractTextObject.Get() != PointingAtObject)
+			{
+				InteractTextObject = PointingAtObject;
 
-		//Ammo string
-		FString AmmoText = FString();
+				//Get the Object's name, the first stored tag.
+				InteractText = FText::FromName(PointingAtObject->Tags[0]);
+				InteractTextSize = MeasureText(NormalFont, InteractText);
+				InteractAmmoTextSize = MeasureText(NormalFont, LOCTEXT("InteractAmmo", "Ammo"));
+			}
 
-		AmmoText = FName(TEXT("Ammo")).ToString();
+			const FText& ObjectText = InteractText;
+			const float TextOffsetX = -100;
+			const float TextOffsetY = 100;
+			const FVector2D TextSize = InteractTextSize * ScaleUI;
 
-		float AmmoTextXL;
-		float AmmoTextYL;
+			//Where to draw the "interact" prompt
+			const float TextPosX = (Canvas->ClipX - (TextSize.X - TextOffsetX) * ScaleUI) / 2;
+			const float TextPosY = Canvas->ClipY - (Offset + TextSize.Y + TextOffsetY) * ScaleUI;
 
-		Canvas->TextSize(NormalFont, AmmoText, AmmoTextXL, AmmoTextYL, ScaleUI, ScaleUI);
+			//Draw the weapon name dark if the player already has this weapon
+			AddText(DrawList, NormalFont, ObjectText, TextPosX, TextPosY, ScaleUI * 2, PawnWeapon ? FLinearColor(HUDDark) : FLinearColor::White);
 
-		const float AmmoTextPosX = TextPosX + TextXL + AmmoTextXL + 35;
-		const float AmmoTextPosY = TextPosY;
+			if (bShowAmmo)
+			{
+				const FText AmmoText = LOCTEXT("InteractAmmo", "Ammo");
+				const FVector2D AmmoTextSize = InteractAmmoTextSize * ScaleUI;
 
-		if (PawnWeapon && PawnWeapon->GetCurrentAmmo() < PawnWeapon->GetMaxAmmo() && PointingAtWeapon->GetCurrentAmmo() > 0)
-		{
-			Canvas->SetDrawColor(FColor::White);
-			Canvas->DrawText(NormalFont, AmmoText, AmmoTextPosX, AmmoTextPosY, ScaleUI * 2, ScaleUI * 2, ShadowedFont);
+				const float AmmoTextPosX = TextPosX + TextSize.X + AmmoTextSize.X + 35;
+				const float AmmoTextPosY = TextPosY;
+				AddText(DrawList, NormalFont, AmmoText, AmmoTextPosX, AmmoTextPosY, ScaleUI * 2, FLinearColor::White);
+			}
 		}
+
+		AddElement(InteractElement);
 	}
 }
 
@@ -198,110 +200,90 @@ void AShooterHUD::DrawWeaponHUD()
 	if (MyWeapon)
 	{
 		//PRIMARY WEAPON
-		const float PriWeapOffsetY = 65;
-		const float PriWeaponBoxWidth = 150;
-		
-		Canvas->SetDrawColor(FColor::White);
-		const float PriWeapBgPosY =  Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + PrimaryWeapBg.VL + Offset) * ScaleUI;
-
-		//John
-		//Draw weapon text
-		float TextXL;
-		float TextYL;
-		const float PriWeapTextOffsetX = 0;
-		const float PriWeapTextOffsetY = 30;
-
-		FString PriWeaponText = FString();
-		PriWeaponText = MyWeapon->Tags[0].ToString();
-
-		Canvas->TextSize(NormalFont, PriWeaponText, TextXL, TextYL, ScaleUI, ScaleUI);
+		const int32 PriAmmoInClip = MyWeapon->GetCurrentAmmoInClip();
+		const int32 PriAmmo = MyWeapon->GetCurrentAmmo();
+		if (PrimaryWeaponElement.NeedsRebuild(LayoutVersion, (UPTRINT)MyWeapon, ((int64)PriAmmoInClip << 32) | (uint32)PriAmmo))
+		{
+			FShooterHUDDrawList& DrawList = PrimaryWeaponElement.DrawList;
 
-		//Weapon draw position
-		const float PriWeapPosX = Canvas->ClipX - Canvas->OrgX - ((PriWeaponBoxWidth + MyWeapon->PrimaryIcon.UL) / 2.0f + 2 * Offset) * ScaleUI;
-		const float PriWeapPosY =  Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + (PrimaryWeapBg.VL + MyWeapon->PrimaryIcon.VL) / 2 + Offset) * ScaleUI;
+			const float PriWeapOffsetY = 65;
+			const float PriWeaponBoxWidth = 150;
 
-		Canvas->SetDrawColor(HUDDark);
-		//Draw the weapon name
+			const float PriWeapBgPosY =  Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + PrimaryWeapBg.VL + Offset) * ScaleUI;
 
-		Canvas->DrawText(NormalFont, PriWeaponText, PriWeapPosX-PriWeapTextOffsetX, PriWeapPosY-PriWeapTextOffsetY, ScaleUI*1.5, ScaleUI*1.5, ShadowedFont);
+			//John
+			//Draw weapon text
+			const float PriWeapTextOffsetX = 0;
+			const float PriWeapTextOffsetY = 30;
 
-		Canvas->SetDrawColor(FColor::White);
+			const FText PriWeaponText = FText::FromName(MyWeapon->Tags[0]);
 
+			//Weapon draw position
+			const float PriWeapPosX = Canvas->ClipX - Canvas->OrgX - ((PriWeaponBoxWidth + MyWeapon->PrimaryIcon.UL) / 2.0f + 2 * Offset) * ScaleUI;
+			const float PriWeapPosY =  Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + (PrimaryWeapBg.VL + MyWeapon->PrimaryIcon.VL) / 2 + Offset) * ScaleUI;
 
-		//Clip draw position
-		const float ClipWidth = MyWeapon->PrimaryClipIcon.UL +  MyWeapon->PrimaryClipIconOffset * (MyWeapon->AmmoIconsCount-1);
-		const float BoxWidth = 65.0f;
-		const float PriClipPosX = PriWeapPosX - (BoxWidth + ClipWidth) * ScaleUI;
-		const float PriClipPosY =  Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + (PrimaryWeapBg.VL + MyWeapon->PrimaryClipIcon.VL) / 2 + Offset) * ScaleUI;
+			//Draw the weapon name
+			AddText(DrawList, NormalFont, PriWeaponText, PriWeapPosX - PriWeapTextOffsetX, PriWeapPosY - PriWeapTextOffsetY, ScaleUI * 1.5f, HUDDark);
 
-		const float LeftCornerWidth = 60;
+			//Clip draw position
+			const float ClipWidth = MyWeapon->PrimaryClipIcon.UL +  MyWeapon->PrimaryClipIconOffset * (MyWeapon->AmmoIconsCount-1);
+			const float BoxWidth = 65.0f;
+			const float PriClipPosX = PriWeapPosX - (BoxWidth + ClipWidth) * ScaleUI;
+			const float PriClipPosY =  Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + (PrimaryWeapBg.VL + MyWeapon->PrimaryClipIcon.VL) / 2 + Offset) * ScaleUI;
 
-		FCanvasTileItem TileItem(FVector2D( PriClipPosX - Offset * ScaleUI, PriWeapBgPosY ), PrimaryWeapBg.Texture->Resource, 
-			FVector2D( LeftCornerWidth * ScaleUI, PrimaryWeapBg.VL * ScaleUI ),	 FLinearColor::White);
-		MakeUV(PrimaryWeapBg, TileItem.UV0, TileItem.UV1, PrimaryWeapBg.U, PrimaryWeapBg.V, LeftCornerWidth, PrimaryWeapBg.VL);  
-		TileItem.BlendMode = SE_BLEND_Translucent;
-		Canvas->DrawItem( TileItem );
-
-		const float RestWidth =  Canvas->ClipX - PriClipPosX - LeftCornerWidth * ScaleUI;
-		TileItem.Position = FVector2D(PriClipPosX - (Offset - LeftCornerWidth) * ScaleUI, PriWeapBgPosY);
-		TileItem.Size = FVector2D(RestWidth, PrimaryWeapBg.VL * ScaleUI);
-		MakeUV(PrimaryWeapBg, TileItem.UV0, TileItem.UV1, PrimaryWeapBg.U + PrimaryWeapBg.UL - RestWidth / ScaleUI, PrimaryWeapBg.V, RestWidth / ScaleUI, PrimaryWeapBg.VL);  
-		Canvas->DrawItem( TileItem );
-
-		//Drawing primary weapon icon, ammo in the clip and total spare ammo numbers
-		Canvas->DrawIcon(MyWeapon->PrimaryIcon, PriWeapPosX, PriWeapPosY, ScaleUI);
-
-		const float TextOffset = 12;
-		float SizeX, SizeY;
-		float TopTextHeight;
-		FString Text = FString::FromInt(MyWeapon->GetCurrentAmmoInClip());
-
-		FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
-		TextItem.EnableShadow( FLinearColor::Black );
-		Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-
-		const float TopTextScale = 0.73f; // of 51pt font
-		const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
-		const float TopTextPosY = Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + PrimaryWeapBg.VL + Offset - TextOffset / 2.0f) * ScaleUI; 
-		TextItem.Text = FText::FromString( Text );
-		TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
-		TextItem.FontRenderInfo = ShadowedFont;
-		Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
-		TopTextHeight = SizeY * TopTextScale;
-		Text = FString::FromInt(MyWeapon->GetCurrentAmmo() - MyWeapon->GetCurrentAmmoInClip());
-		Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-
-		const float BottomTextScale = 0.49f; // of 51pt font
-		const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * BottomTextScale) / 2.0f) * ScaleUI; 
-		const float BottomTextPosY = TopTextPosY + (TopTextHeight - 0.8f * TextOffset) * ScaleUI;
-		TextItem.Text = FText::FromString( Text );
-		TextItem.Scale = FVector2D( BottomTextScale*ScaleUI, BottomTextScale * ScaleUI );
-		TextItem.FontRenderInfo = ShadowedFont;
-		Canvas->DrawItem( TextItem, BottomTextPosX, BottomTextPosY );
-
-		// Drawing clip icons
-		Canvas->SetDrawColor(FColor::White);
-
-		const float AmmoPerIcon = MyWeapon->GetAmmoPerClip() / MyWeapon->AmmoIconsCount;
-		for (int32 i = 0; i < MyWeapon->AmmoIconsCount; i++)
-		{
-			if ((i+1) * AmmoPerIcon > MyWeapon->GetCurrentAmmoInClip())
+			//draw background in two parts to match number of clip icons
+			const float LeftCornerWidth = 60;
+			AddIconPart(DrawList, PrimaryWeapBg, FVector2D(PriClipPosX - Offset * ScaleUI, PriWeapBgPosY), FVector2D(LeftCornerWidth * ScaleUI, PrimaryWeapBg.VL * ScaleUI),
+				PrimaryWeapBg.U, PrimaryWeapBg.V, LeftCornerWidth, PrimaryWeapBg.VL, FLinearColor::White);
+
+			const float RestWidth =  Canvas->ClipX - PriClipPosX - LeftCornerWidth * ScaleUI;
+			AddIconPart(DrawList, PrimaryWeapBg, FVector2D(PriClipPosX - (Offset - LeftCornerWidth) * ScaleUI, PriWeapBgPosY), FVector2D(RestWidth, PrimaryWeapBg.VL * ScaleUI),
+				PrimaryWeapBg.U + PrimaryWeapBg.UL - RestWidth / ScaleUI, PrimaryWeapBg.V, RestWidth / ScaleUI, PrimaryWeapBg.VL, FLinearColor::White);
+
+			//Drawing primary weapon icon, ammo in the clip and total spare ammo numbers
+			AddIcon(DrawList, MyWeapon->PrimaryIcon, PriWeapPosX, PriWeapPosY, ScaleUI, FLinearColor::White);
+
+			const float TextOffset = 12;
+			FText Text = FText::FromString(FString::FromInt(PriAmmoInClip));
+			FVector2D TextSize = MeasureText(BigFont, Text);
+
+			const float TopTextScale = 0.73f; // of 51pt font
+			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + TextSize.X * TopTextScale) / 2.0f)  * ScaleUI;
+			const float TopTextPosY = Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + PrimaryWeapBg.VL + Offset - TextOffset / 2.0f) * ScaleUI; 
+			AddText(DrawList, BigFont, Text, TopTextPosX, TopTextPosY, TopTextScale * ScaleUI, HUDDark);
+			const float TopTextHeight = TextSize.Y * TopTextScale;
+
+			Text = FText::FromString(FString::FromInt(PriAmmo - PriAmmoInClip));
+			TextSize = MeasureText(BigFont, Text);
+
+			const float BottomTextScale = 0.49f; // of 51pt font
+			const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + TextSize.X * BottomTextScale) / 2.0f) * ScaleUI; 
+			const float BottomTextPosY = TopTextPosY + (TopTextHeight - 0.8f * TextOffset) * ScaleUI;
+			AddText(DrawList, BigFont, Text, BottomTextPosX, BottomTextPosY, BottomTextScale * ScaleUI, HUDDark);
+
+			// Drawing clip icons
+			const float AmmoPerIcon = MyWeapon->GetAmmoPerClip() / MyWeapon->AmmoIconsCount;
+			for (int32 i = 0; i < MyWeapon->AmmoIconsCount; i++)
 			{
-				const float UsedPerIcon = (i+1) * AmmoPerIcon - MyWeapon->GetCurrentAmmoInClip();
-				float PercentLeftInIcon = 0;
-				if (UsedPerIcon < AmmoPerIcon)
+				FColor IconColor = FColor::White;
+				if ((i+1) * AmmoPerIcon > PriAmmoInClip)
 				{
-					PercentLeftInIcon = (AmmoPerIcon - UsedPerIcon) / AmmoPerIcon;
+					const float UsedPerIcon = (i+1) * AmmoPerIcon - PriAmmoInClip;
+					float PercentLeftInIcon = 0;
+					if (UsedPerIcon < AmmoPerIcon)
+					{
+						PercentLeftInIcon = (AmmoPerIcon - UsedPerIcon) / AmmoPerIcon;
+					}
+					const int32 Color = 128 + 128 * PercentLeftInIcon;
+					IconColor = FColor(Color, Color, Color, Color);
 				}
-				const int32 Color = 128 + 128 * PercentLeftInIcon;
-				Canvas->SetDrawColor(Color, Color, Color, Color);
-			}
 
-			const float ClipOffset = MyWeapon->PrimaryClipIconOffset * ScaleUI * i;
-			Canvas->DrawIcon(MyWeapon->PrimaryClipIcon, PriClipPosX + ClipOffset, PriClipPosY, ScaleUI);
+				const float ClipOffset = MyWeapon->PrimaryClipIconOffset * ScaleUI * i;
+				AddIcon(DrawList, MyWeapon->PrimaryClipIcon, PriClipPosX + ClipOffset, PriClipPosY, ScaleUI, IconColor);
+			}
 		}
-		Canvas->SetDrawColor(HUDDark);
-		//
+
+		AddElement(PrimaryWeaponElement);
 
 		//SECONDARY WEAPON
 		AShooterWeapon* SecondaryWeapon = NULL;
@@ -313,101 +295,89 @@ void AShooterHUD::DrawWeaponHUD()
 				break;
 			}
 		}
-		//TODO: Draw secondary weapon text
 		if (SecondaryWeapon)
 		{
-			Canvas->SetDrawColor(FColor::White);
-			//offsets
-			const float SecWeapOffsetY = 0;
-			const float SecWeaponBoxWidth = 120;
+			const int32 SecAmmoInClip = SecondaryWeapon->GetCurrentAmmoInClip();
+			const int32 SecAmmo = SecondaryWeapon->GetCurrentAmmo();
+			if (SecondaryWeaponElement.NeedsRebuild(LayoutVersion, (UPTRINT)SecondaryWeapon, ((int64)SecAmmoInClip << 32) | (uint32)SecAmmo))
+			{
+				FShooterHUDDrawList& DrawList = SecondaryWeaponElement.DrawList;
 
-			//background positioning
-			const float SecWeapBgPosX = Canvas->ClipX - Canvas->OrgX - (SecondaryWeapBg.UL + Offset) * ScaleUI;
-			const float SecWeapBgPosY =  Canvas->ClipY - Canvas->OrgY - (SecondaryWeapBg.VL + Offset) * ScaleUI;
+				//offsets
+				const float SecWeapOffsetY = 0;
+				const float SecWeaponBoxWidth = 120;
 
-			//weapon draw position
-			const float SecWeapPosX = Canvas->ClipX - Canvas->OrgX - ((SecWeaponBoxWidth + SecondaryWeapon->SecondaryIcon.UL) / 2.0f + 2 * Offset) * ScaleUI;
-			const float SecWeapPosY =  Canvas->ClipY - Canvas->OrgY - (SecWeapOffsetY + (SecondaryWeapBg.VL + SecondaryWeapon->SecondaryIcon.VL) / 2.0f + Offset) * ScaleUI;
+				//background positioning
+				const float SecWeapBgPosY =  Canvas->ClipY - Canvas->OrgY - (SecondaryWeapBg.VL + Offset) * ScaleUI;
 
-			//John
-			//Secondary Weapon Text
+				//weapon draw position
+				const float SecWeapPosX = Canvas->ClipX - Canvas->OrgX - ((SecWeaponBoxWidth + SecondaryWeapon->SecondaryIcon.UL) / 2.0f + 2 * Offset) * ScaleUI;
+				const float SecWeapPosY =  Canvas->ClipY - Canvas->OrgY - (SecWeapOffsetY + (SecondaryWeapBg.VL + SecondaryWeapon->SecondaryIcon.VL) / 2.0f + Offset) * ScaleUI;
 
-			const float SecWeapTextOffsetX = 150;
-			const float SecWeapTextOffsetY = 125;
+				//John
+				//Secondary Weapon Text
+				const float SecWeapTextOffsetX = 150;
+				const float SecWeapTextOffsetY = 125;
 
-			FString SecWeaponText = FString();
-			SecWeaponText = SecondaryWeapon->Tags[0].ToString();
+				const FText SecWeaponText = FText::FromName(SecondaryWeapon->Tags[0]);
+				const FVector2D SecWeaponTextSize = MeasureText(NormalFont, SecWeaponText) * ScaleUI;
 
-			Canvas->TextSize(NormalFont, SecWeaponText, TextXL, TextYL, ScaleUI, ScaleUI);
+				const float SecWeapTextPosX = Canvas->ClipX - Canvas->OrgX - ((SecWeapTextOffsetX + SecWeaponTextSize.X) / 2.0f + 2 * Offset) * ScaleUI;
+				const float SecWeapTextPosY = Canvas->ClipY - Canvas->OrgY - ((SecWeapOffsetY + SecWeapTextOffsetY + SecWeaponTextSize.Y) / 2.0f + Offset) * ScaleUI;
 
-			const float SecWeapTextPosX = Canvas->ClipX - Canvas->OrgX - ((SecWeapTextOffsetX + TextXL) / 2.0f + 2 * Offset) * ScaleUI;
-			const float SecWeapTextPosY = Canvas->ClipY - Canvas->OrgY - ((SecWeapOffsetY + SecWeapTextOffsetY + TextYL) / 2.0f + Offset) * ScaleUI;
+				//Draw the weapon name
+				AddText(DrawList, NormalFont, SecWeaponText, SecWeapTextPosX, SecWeapTextPosY, ScaleUI, HUDDark);
 
-			Canvas->SetDrawColor(HUDDark);
-			//Draw the weapon name
-			Canvas->DrawText(NormalFont, SecWeaponText, SecWeapTextPosX, SecWeapTextPosY, ScaleUI, ScaleUI, ShadowedFont);
+				//secondary clip draw position
+				const float SecClipWidth = SecondaryWeapon->SecondaryClipIcon.UL +  SecondaryWeapon->SecondaryClipIconOffset * (SecondaryWeapon->AmmoIconsCount-1);
+				const float BoxWidth = 45.0f;
+				const float SecClipPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + BoxWidth + SecClipWidth + 2 * Offset) * ScaleUI;
+				const float SecClipPosY =  Canvas->ClipY - Canvas->OrgY - (SecWeapOffsetY + (SecondaryWeapBg.VL + SecondaryWeapon->SecondaryClipIcon.VL) / 2.0f + Offset) * ScaleUI;
 
-			Canvas->SetDrawColor(FColor::White);
+				//draw background in two parts to match number of clip icons
+				const float LeftCornerWidth = 38;
+				AddIconPart(DrawList, SecondaryWeapBg, FVector2D(SecClipPosX - Offset * ScaleUI, SecWeapBgPosY), FVector2D(LeftCornerWidth * ScaleUI, SecondaryWeapBg.VL * ScaleUI),
+					SecondaryWeapBg.U, SecondaryWeapBg.V, LeftCornerWidth, SecondaryWeapBg.VL, FLinearColor::White);
 
-			//secondary clip draw position
-			const float SecClipWidth = SecondaryWeapon->SecondaryClipIcon.UL +  SecondaryWeapon->SecondaryClipIconOffset * (SecondaryWeapon->AmmoIconsCount-1);
-			const float BoxWidth = 45.0f;
-			const float SecClipPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + BoxWidth + SecClipWidth + 2 * Offset) * ScaleUI;
-			const float SecClipPosY =  Canvas->ClipY - Canvas->OrgY - (SecWeapOffsetY + (SecondaryWeapBg.VL + SecondaryWeapon->SecondaryClipIcon.VL) / 2.0f + Offset) * ScaleUI;
+				const float RestWidth =  Canvas->ClipX - SecClipPosX - LeftCornerWidth * ScaleUI;
+				AddIconPart(DrawList, SecondaryWeapBg, FVector2D(SecClipPosX - (Offset - LeftCornerWidth) * ScaleUI, SecWeapBgPosY), FVector2D(RestWidth, SecondaryWeapBg.VL * ScaleUI),
+					SecondaryWeapBg.U + SecondaryWeapBg.UL - RestWidth / ScaleUI, SecondaryWeapBg.V, RestWidth / ScaleUI, SecondaryWeapBg.VL, FLinearColor::White);
 
-			//draw background in two parts to match number of clip icons
-			const float LeftCornerWidth = 38;
-			FCanvasTileItem TileItem(FVector2D(  SecClipPosX - Offset * ScaleUI, SecWeapBgPosY ), SecondaryWeapBg.Texture->Resource, 
-			FVector2D( LeftCornerWidth * ScaleUI, SecondaryWeapBg.VL * ScaleUI ), FLinearColor::White);
-			MakeUV(SecondaryWeapBg, TileItem.UV0, TileItem.UV1, SecondaryWeapBg.U, SecondaryWeapBg.V, LeftCornerWidth, SecondaryWeapBg.VL);  
-			TileItem.BlendMode = SE_BLEND_Translucent;
-			Canvas->DrawItem(TileItem);
-
-			const float RestWidth =  Canvas->ClipX - SecClipPosX - LeftCornerWidth * ScaleUI;
-			TileItem.Position = FVector2D(SecClipPosX - (Offset - LeftCornerWidth) * ScaleUI, SecWeapBgPosY);
-			TileItem.Size = FVector2D(RestWidth, SecondaryWeapBg.VL * ScaleUI);
-			MakeUV(SecondaryWeapBg, TileItem.UV0, TileItem.UV1, SecondaryWeapBg.U + SecondaryWeapBg.UL - RestWidth / ScaleUI, SecondaryWeapBg.V, RestWidth / ScaleUI, SecondaryWeapBg.VL);  
-			Canvas->DrawItem(TileItem);
-
-			/** Drawing secondary clip **/
-			const float AmmoPerIcon = SecondaryWeapon->GetAmmoPerClip() / SecondaryWeapon->AmmoIconsCount;
-			for (int32 i = 0; i < SecondaryWeapon->AmmoIconsCount; i++)
-			{
-				if ((i+1) * AmmoPerIcon > SecondaryWeapon->GetCurrentAmmoInClip())
+				/** Drawing secondary clip **/
+				const float AmmoPerIcon = SecondaryWeapon->GetAmmoPerClip() / SecondaryWeapon->AmmoIconsCount;
+				for (int32 i = 0; i < SecondaryWeapon->AmmoIconsCount; i++)
 				{
-					const float UsedPerIcon = (i+1) * AmmoPerIcon - SecondaryWeapon->GetCurrentAmmoInClip();
-					float PercentLeftInIcon = 0;
-					if (UsedPerIcon < AmmoPerIcon)
+					FColor IconColor = FColor::White;
+					if ((i+1) * AmmoPerIcon > SecAmmoInClip)
 					{
-						PercentLeftInIcon = (AmmoPerIcon - UsedPerIcon) / AmmoPerIcon;
+						const float UsedPerIcon = (i+1) * AmmoPerIcon - SecAmmoInClip;
+						float PercentLeftInIcon = 0;
+						if (UsedPerIcon < AmmoPerIcon)
+						{
+							PercentLeftInIcon = (AmmoPerIcon - UsedPerIcon) / AmmoPerIcon;
+						}
+						const int32 Color = 128 + 128 * PercentLeftInIcon;
+						IconColor = FColor(Color, Color, Color, Color);
 					}
-					const int32 Color = 128 + 128 * PercentLeftInIcon;
-					Canvas->SetDrawColor(Color, Color, Color, Color);
-				}
-
-				const float ClipOffset = SecondaryWeapon->SecondaryClipIconOffset * ScaleUI * i;
-				Canvas->DrawIcon(SecondaryWeapon->SecondaryClipIcon, SecClipPosX + ClipOffset, SecClipPosY, ScaleUI);
-			}
 
-			//Drawing secondary weapon icon, ammo in the clip and total ammo numbers
-			Canvas->SetDrawColor(FColor::White);
-			Canvas->DrawIcon(SecondaryWeapon->SecondaryIcon, SecWeapPosX, SecWeapPosY, ScaleUI);
+					const float ClipOffset = SecondaryWeapon->SecondaryClipIconOffset * ScaleUI * i;
+					AddIcon(DrawList, SecondaryWeapon->SecondaryClipIcon, SecClipPosX + ClipOffset, SecClipPosY, ScaleUI, IconColor);
+				}
 
-			const float TextOffset = 10;
-			float SizeX, SizeY;
-			float TopTextHeight;
-			FString Text = FString::FromInt(SecondaryWeapon->GetCurrentAmmo());
+				//Drawing secondary weapon icon, ammo in the clip and total ammo numbers
+				AddIcon(DrawList, SecondaryWeapon->SecondaryIcon, SecWeapPosX, SecWeapPosY, ScaleUI, FLinearColor::White);
 
-			Canvas->StrLen(BigFont,Text, SizeX, SizeY);
-			const float TopTextScale = 0.53f; // of 51pt font
-			TopTextHeight = SizeY * TopTextScale;
+				const FText Text = FText::FromString(FString::FromInt(SecAmmo));
+				const FVector2D TextSize = MeasureText(BigFont, Text);
+				const float TopTextScale = 0.53f; // of 51pt font
+				const float TopTextHeight = TextSize.Y * TopTextScale;
 
-			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
-			const float TopTextPosY = SecWeapBgPosY + (SecondaryWeapBg.VL - TopTextHeight) / 2.0f * ScaleUI; 
+				const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (BoxWidth + TextSize.X * TopTextScale) / 2.0f)  * ScaleUI;
+				const float TopTextPosY = SecWeapBgPosY + (SecondaryWeapBg.VL - TopTextHeight) / 2.0f * ScaleUI; 
+				AddText(DrawList, BigFont, Text, TopTextPosX, TopTextPosY, TopTextScale * ScaleUI, HUDDark);
+			}
 
-			TextItem.Text = FText::FromString( Text );
-			TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
-			Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
+			AddElement(SecondaryWeaponElement);
 		}
 		// END OF SECONDARY WEAPON
 	}
@@ -416,113 +386,113 @@ void AShooterHUD::DrawWeaponHUD()
 void AShooterHUD::DrawHealth()
 {
 	AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetOwningPawn());
-	Canvas->SetDrawColor(FColor::White);
-	const float HealthPosX = (Canvas->ClipX - HealthBarBg.UL * ScaleUI) / 2;
-	const float HealthPosY = Canvas->ClipY - (Offset + HealthBarBg.VL) * ScaleUI;
-	Canvas->DrawIcon(HealthBarBg, HealthPosX, HealthPosY, ScaleUI);
-	const float HealthAmount =  FMath::Min(1.0f,MyPawn->Health / MyPawn->GetMaxHealth());
-
-	FCanvasTileItem TileItem(FVector2D(HealthPosX,HealthPosY), HealthBar.Texture->Resource, 
-							 FVector2D(HealthBar.UL * HealthAmount  * ScaleUI, HealthBar.VL * ScaleUI), FLinearColor::White);
-	MakeUV(HealthBar, TileItem.UV0, TileItem.UV1, HealthBar.U, HealthBar.V, HealthBar.UL * HealthAmount, HealthBar.VL);  
-	TileItem.BlendMode = SE_BLEND_Translucent;
-	Canvas->DrawItem(TileItem);
-
-	Canvas->DrawIcon(HealthIcon,HealthPosX + Offset * ScaleUI, HealthPosY + (HealthBar.VL - HealthIcon.VL) / 2.0f * ScaleUI, ScaleUI);
+	if (HealthElement.NeedsRebuild(LayoutVersion, FMath::RoundToInt(MyPawn->Health * 100.0f), FMath::RoundToInt(MyPawn->GetMaxHealth() * 100.0f)))
+	{
+		FShooterHUDDrawList& DrawList = HealthElement.DrawList;
+
+		const float HealthPosX = (Canvas->ClipX - HealthBarBg.UL * ScaleUI) / 2;
+		const float HealthPosY = Canvas->ClipY - (Offset + HealthBarBg.VL) * ScaleUI;
+		AddIcon(DrawList, HealthBarBg, HealthPosX, HealthPosY, ScaleUI, FLinearColor::White);
+		const float HealthAmount =  FMath::Min(1.0f,MyPawn->Health / MyPawn->GetMaxHealth());
+
+		AddIconPart(DrawList, HealthBar, FVector2D(HealthPosX, HealthPosY), FVector2D(HealthBar.UL * HealthAmount * ScaleUI, HealthBar.VL * ScaleUI),
+			HealthBar.U, HealthBar.V, HealthBar.UL * HealthAmount, HealthBar.VL, FLinearColor::White);
+
+		AddIcon(DrawList, HealthIcon, HealthPosX + Offset * ScaleUI, HealthPosY + (HealthBar.VL - HealthIcon.VL) / 2.0f * ScaleUI, ScaleUI, FLinearColor::White);
+	}
+
+	AddElement(HealthElement);
 }
 
 void AShooterHUD::DrawMatchTimerAndPosition()
 {
 	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GetWorld()->GameState);
-	Canvas->SetDrawColor(FColor::White);
 	const float TimerPosX = Canvas->ClipX - Canvas->OrgX - (TimePlaceBg.UL + Offset) * ScaleUI;
 	const float TimerPosY = Canvas->OrgY + Offset * ScaleUI;
-	if (MyGameState && MatchState == EShooterMatchState::Playing)
+	const float TextScale = 0.57f;
+
+	const bool bShowBackground = MyGameState && MatchState == EShooterMatchState::Playing;
+	const bool bShowTimer = MyGameState && MyGameState->RemainingTime > 0 && MyGameState->GetMatchState() == MatchState::InProgress;
+	if (TimerElement.NeedsRebuild(LayoutVersion, bShowTimer ? MyGameState->RemainingTime : INDEX_NONE, bShowBackground))
 	{
-		Canvas->DrawIcon(TimePlaceBg, TimerPosX, TimerPosY,	ScaleUI);
-		Canvas->DrawIcon(TimerIcon, TimerPosX + Offset * ScaleUI, TimerPosY + ((TimePlaceBg.VL - TimerIcon.VL ) / 2) * ScaleUI, ScaleUI);
+		FShooterHUDDrawList& DrawList = TimerElement.DrawList;
+
+		if (bShowBackground)
+		{
+			AddIcon(DrawList, TimePlaceBg, TimerPosX, TimerPosY, ScaleUI, FLinearColor::White);
+			AddIcon(DrawList, TimerIcon, TimerPosX + Offset * ScaleUI, TimerPosY + ((TimePlaceBg.VL - TimerIcon.VL ) / 2) * ScaleUI, ScaleUI, FLinearColor::White);
+		}
+
+		// match timer
+		if (bShowTimer)
+		{
+			const FText Text = FText::FromString(GetTimeString(MyGameState->RemainingTime));
+			const FVector2D TextSize = MeasureText(BigFont, Text);
+			AddText(DrawList, BigFont, Text, TimerPosX + Offset * 1.5f * ScaleUI + TimerIcon.UL * ScaleUI,
+				TimerPosY + (TimePlaceBg.VL * ScaleUI - TextSize.Y * TextScale * ScaleUI) / 2, TextScale * ScaleUI, HUDDark);
+		}
 	}
-	// match timer
+
+	AddElement(TimerElement);
+
 	if (MyGameState && MyGameState->RemainingTime > 0)
 	{
-		FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
-		TextItem.EnableShadow( FLinearColor::Black );
-		float SizeX, SizeY;
-		float TextScale = 0.57f;
-		FString Text;
-		TextItem.FontRenderInfo = ShadowedFont;
-		TextItem.Scale = FVector2D( TextScale*ScaleUI, TextScale*ScaleUI );
 		if (MyGameState->GetMatchState() == MatchState::WaitingToStart)
 		{
+			if (WarmupInfoSeconds != MyGameState->RemainingTime)
+			{
+				WarmupInfoSeconds = MyGameState->RemainingTime;
+				WarmupInfoText = FText::FromString(LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(WarmupInfoSeconds));
+			}
+
+			FCanvasTextItem TextItem( FVector2D::ZeroVector, WarmupInfoText, BigFont, HUDLight );
 			TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
-			Text = LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime);
-			TextItem.SetColor( HUDLight );
-			TextItem.Text = FText::FromString( Text );			
 			AddMatchInfoString(TextItem);
 		}
-		else if (MyGameState->GetMatchState() == MatchState::InProgress)
-		{
-			Text = GetTimeString(MyGameState->RemainingTime);
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-
-			TextItem.SetColor( HUDDark );
-			TextItem.Text = FText::FromString( Text );
-			TextItem.Position = FVector2D( TimerPosX + Offset * 1.5f * ScaleUI + TimerIcon.UL * ScaleUI,
-				TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
-			Canvas->DrawItem(TextItem);
-		}
 
-		float BoxWidth = 45.0f * ScaleUI;
-		Text = FString();
 		AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(PlayerOwner);
-		if (MyPC && MyGameState && MatchState == EShooterMatchState::Playing)
+		AShooterPlayerState* MyPlayerState = MyPC ? Cast<AShooterPlayerState>(MyPC->PlayerState) : NULL;
+		if (MyPlayerState && MatchState == EShooterMatchState::Playing)
 		{
-			AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyPC->PlayerState);
-			if (MyPlayerState)
+			int32 MyPos = 0;
+			int32 NumRanked = 0;
+			if (MyGameState->NumTeams > 1) // team based game
 			{
-				if (MyGameState->NumTeams > 1) // team based game
+				int32 MyTeam = MyPlayerState->GetTeamNum();
+				MyPos = FMath::Max(1, MyGameState->TeamScores.Num());
+				for (int32 i=0; i < MyGameState->TeamScores.Num(); i++)
 				{
-					int32 MyTeam = MyPlayerState->GetTeamNum();
-					int32 MyPos = FMath::Max(1, MyGameState->TeamScores.Num());
-					for (int32 i=0; i < MyGameState->TeamScores.Num(); i++)
-					{
-						if (MyGameState->TeamScores.Num() > MyTeam &&
-							MyGameState->TeamScores[MyTeam] >= MyGameState->TeamScores[i] && MyTeam != i)
-						{
-							MyPos--;
-						}
-					}
-					int32 NumTeams = 0;
-					for (int32 i=0; i < MyGameState->NumTeams; i++)
+					if (MyGameState->TeamScores.Num() > MyTeam &&
+						MyGameState->TeamScores[MyTeam] >= MyGameState->TeamScores[i] && MyTeam != i)
 					{
-						RankedPlayerMap PlayerStateMap;
-						MyGameState->GetRankedMap(i,PlayerStateMap);
-						if(PlayerStateMap.Num() > 0)
-						{
-							NumTeams++;
-						}
+						MyPos--;
 					}
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, NumTeams);
-				}
-				else // free for all
-				{
-					RankedPlayerMap PlayerStateMap;
-					MyGameState->GetRankedMap(0,PlayerStateMap);
-					const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
-					int32 MyPos = MyRank ? *MyRank + 1 : 0;
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, PlayerStateMap.Num());
 				}
-				Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-				Canvas->DrawIcon(PlaceIcon,
-					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (SizeX * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
-					TimerPosY + (TimePlaceBg.VL - PlaceIcon.VL) / 2.0f * ScaleUI, ScaleUI);
-
-				TextItem.Text = FText::FromString( Text);
-				TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
-				TextItem.FontRenderInfo = ShadowedFont;
-				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + SizeX * TextScale * ScaleUI),
-					TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+				NumRanked = MyGameState->GetNumRankedTeams();
+			}
+			else // free for all
+			{
+				const int32 MyRank = MyGameState->GetPlayerRank(MyPlayerState);
+				MyPos = MyRank != INDEX_NONE ? MyRank + 1 : 0;
+				NumRanked = MyGameState->GetRankedPlayers(0).Num();
+			}
+
+			if (PlaceElement.NeedsRebuild(LayoutVersion, MyPos, NumRanked))
+			{
+				FShooterHUDDrawList& DrawList = PlaceElement.DrawList;
+
+				const float BoxWidth = 45.0f * ScaleUI;
+				const FText Text = FText::FromString(FString::Printf(TEXT("%d/%d"), MyPos, NumRanked));
+				const FVector2D TextSize = MeasureText(BigFont, Text);
+				AddIcon(DrawList, PlaceIcon,
+					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (TextSize.X * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
+					TimerPosY + (TimePlaceBg.VL - PlaceIcon.VL) / 2.0f * ScaleUI, ScaleUI, FLinearColor::White);
+
+				AddText(DrawList, BigFont, Text, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + TextSize.X * TextScale * ScaleUI),
+					TimerPosY + (TimePlaceBg.VL * ScaleUI - TextSize.Y * TextScale * ScaleUI) / 2, TextScale * ScaleUI, HUDDark);
 			}
+
+			AddElement(PlaceElement);
 		}
 	}
 }
@@ -535,43 +505,31 @@ void AShooterHUD::DrawKills()
 	if (!MyPlayerState)
 		return;
 
-	Canvas->SetDrawColor(FColor::White);
-	float KillsPosX = Canvas->OrgX + Offset * ScaleUI;
-	float KillsPosY = Canvas->OrgY + Offset * ScaleUI;
-	Canvas->DrawIcon(KillsBg, KillsPosX, KillsPosY,	ScaleUI);
-
-	Canvas->DrawIcon(KillsIcon, KillsPosX + Offset * ScaleUI, KillsPosY + ((KillsBg.VL - KillsIcon.VL ) / 2) * ScaleUI, ScaleUI);
-	float TextScale = 0.57f;
-	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
-	TextItem.EnableShadow( FLinearColor::Black );
+	if (KillsElement.NeedsRebuild(LayoutVersion, MyPlayerState->GetKills()))
+	{
+		FShooterHUDDrawList& DrawList = KillsElement.DrawList;
 
-	float SizeX, SizeY;
-	FString Text = LOCTEXT("Kills", "KILLS:").ToString();
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+		float KillsPosX = Canvas->OrgX + Offset * ScaleUI;
+		float KillsPosY = Canvas->OrgY + Offset * ScaleUI;
+		AddIcon(DrawList, KillsBg, KillsPosX, KillsPosY, ScaleUI, FLinearColor::White);
 
-	TextItem.Text = FText::FromString( Text );
-	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-	TextItem.FontRenderInfo = ShadowedFont;
-	TextItem.SetColor(HUDDark);
-	Canvas->DrawItem( TextItem, KillsPosX + Offset * ScaleUI + KillsIcon.UL * 1.5f * ScaleUI,
-		KillsPosY + (KillsBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+		AddIcon(DrawList, KillsIcon, KillsPosX + Offset * ScaleUI, KillsPosY + ((KillsBg.VL - KillsIcon.VL ) / 2) * ScaleUI, ScaleUI, FLinearColor::White);
+		float TextScale = 0.57f;
 
-	if (MyPlayerState)
-	{
-		Text = FString::FromInt(MyPlayerState->GetKills());
-	}
-	else 
-	{
-		Text = FString("0");
+		FText Text = LOCTEXT("Kills", "KILLS:");
+		FVector2D TextSize = MeasureText(BigFont, Text);
+		AddText(DrawList, BigFont, Text, KillsPosX + Offset * ScaleUI + KillsIcon.UL * 1.5f * ScaleUI,
+			KillsPosY + (KillsBg.VL * ScaleUI - TextSize.Y * TextScale * ScaleUI) / 2, TextScale * ScaleUI, HUDDark);
+
+		Text = FText::FromString(FString::FromInt(MyPlayerState->GetKills()));
+		TextScale = 0.88f;
+		float BoxWidth = 135.0f * ScaleUI;
+		TextSize = MeasureText(BigFont, Text);
+		AddText(DrawList, BigFont, Text, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + TextSize.X * TextScale * ScaleUI) /2,
+			KillsPosY + (KillsBg.VL* ScaleUI - TextSize.Y * TextScale * ScaleUI) / 2, TextScale * ScaleUI, HUDDark);
 	}
-	TextScale = 0.88f;
-	float BoxWidth = 135.0f * ScaleUI;
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-	TextItem.Text = FText::FromString( Text );
-	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-	Canvas->DrawItem( TextItem, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + SizeX * TextScale * ScaleUI) /2,
-		KillsPosY + (KillsBg.VL* ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
 
+	AddElement(KillsElement);
 }
 
 void AShooterHUD::NotifyOutOfAmmo()
@@ -586,6 +544,8 @@ void AShooterHUD::NotifyEnemyHit()
 
 void AShooterHUD::DrawHUD()
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(DrawHUD);
+
 	Super::DrawHUD();
 	if (Canvas == nullptr)
 	{
@@ -612,12 +572,17 @@ void AShooterHUD::DrawHUD()
 		}
 	}
 
+	// HUD CPU time is tracked separately for each splitscreen viewport
+	const TStatId ViewportStatIds[] = { GET_STATID(STAT_ShooterHUDPlayer1), GET_STATID(STAT_ShooterHUDPlayer2), GET_STATID(STAT_ShooterHUDPlayer3), GET_STATID(STAT_ShooterHUDPlayer4) };
+	FScopeCycleCounter HUDCycleCounter(ViewportStatIds[FMath::Clamp<int32>(SSPlayerIndex, 0, ARRAY_COUNT(ViewportStatIds) - 1)]);
 
 	// Empty the info item array
-	InfoItems.Empty();
+	InfoItems.Reset();
 	float TextScale = 1.0f;
 	// enforce min
 	ScaleUI = FMath::Max(ScaleUI, MinHudScale);
+
+	UpdateLayoutVersion();
 	
 	AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetOwningPawn());
 	if (MyPawn && MyPawn->IsAlive() && MyPawn->Health < MyPawn->GetMaxHealth() * MyPawn->GetLowHealthPercentage())
@@ -629,7 +594,7 @@ void AShooterHUD::DrawHUD()
 
 		float AlphaValue = ( 1.0f / 255.0f ) * ( EffectAlpha * EffectValue );
 
-		// Full screen low health overlay
+		// Full screen low health overlay, drawn right away since it ignores the safe zone (and is below everything else anyway)
 		Canvas->PopSafeZoneTransform();
 		FCanvasTileItem TileItem( FVector2D( 0, 0 ), LowHealthOverlayTexture->Resource, FVector2D( Canvas->ClipX, Canvas->ClipY ), FLinearColor( 1.0f, 0.0f, 0.0f, AlphaValue ) );
 		TileItem.BlendMode = SE_BLEND_Translucent;
@@ -640,26 +605,32 @@ void AShooterHUD::DrawHUD()
 	// net mode
 	if (GetNetMode() != NM_Standalone)
 	{
-		FString NetModeDesc = (GetNetMode() == NM_Client) ? TEXT("Client") : TEXT("Server");
+		FNamedOnlineSession* Session = NULL;
 		IOnlineSubsystem * OnlineSubsystem = IOnlineSubsystem::Get();
 		if(OnlineSubsystem)
 		{
 			IOnlineSessionPtr SessionSubsystem = OnlineSubsystem->GetSessionInterface();
 			if(SessionSubsystem.IsValid())
 			{
-				FNamedOnlineSession * Session = SessionSubsystem->GetNamedSession(GameSessionName);
-				if(Session)
-				{
-					NetModeDesc += TEXT("\nSession: ");
-					NetModeDesc += Session->SessionInfo->GetSessionId().ToString();
-				}
+				Session = SessionSubsystem->GetNamedSession(GameSessionName);
 			}
-
 		}
 
-		NetModeDesc += FString::Printf( TEXT( "\nVersion: %i, %s, %s" ), GEngineNetVersion, UTF8_TO_TCHAR(__DATE__), UTF8_TO_TCHAR(__TIME__) );
+		if (NetModeElement.NeedsRebuild(LayoutVersion, GetNetMode(), (UPTRINT)Session))
+		{
+			FString NetModeDesc = (GetNetMode() == NM_Client) ? TEXT("Client") : TEXT("Server");
+			if(Session)
+			{
+				NetModeDesc += TEXT("\nSession: ");
+				NetModeDesc += Session->SessionInfo->GetSessionId().ToString();
+			}
+
+			NetModeDesc += FString::Printf( TEXT( "\nVersion: %i, %s, %s" ), GEngineNetVersion, UTF8_TO_TCHAR(__DATE__), UTF8_TO_TCHAR(__TIME__) );
 
-		DrawDebugInfoString(NetModeDesc, Canvas->OrgX + Offset*ScaleUI, Canvas->OrgY + 5*Offset*ScaleUI, true, true, HUDLight);
+			DrawDebugInfoString(NetModeElement.DrawList, NetModeDesc, Canvas->OrgX + Offset*ScaleUI, Canvas->OrgY + 5*Offset*ScaleUI, true, true, HUDLight);
+		}
+
+		AddElement(NetModeElement);
 	}
 
 	DrawMatchTimerAndPosition();
@@ -683,13 +654,8 @@ void AShooterHUD::DrawHUD()
 		else
 		{
 			// respawn
-			FString Text = LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN").ToString();
-			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
-			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
+			FCanvasTextItem TextItem( FVector2D::ZeroVector, LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN"), BigFont, HUDLight );
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-			TextItem.FontRenderInfo = ShadowedFont;
-			TextItem.SetColor(HUDLight);
 			AddMatchInfoString(TextItem);
 		}
 
@@ -704,17 +670,10 @@ void AShooterHUD::DrawHUD()
 		const float CurrentTime = GetWorld()->GetTimeSeconds();
 		if (CurrentTime - NoAmmoNotifyTime >= 0 && CurrentTime - NoAmmoNotifyTime <= NoAmmoFadeOutTime)
 		{
-			FString Text = FString();
-
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - NoAmmoNotifyTime) / NoAmmoFadeOutTime);
-			Text = LOCTEXT("NoAmmo", "NO AMMO").ToString();
 			
-			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
-			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
+			FCanvasTextItem TextItem( FVector2D::ZeroVector, LOCTEXT("NoAmmo", "NO AMMO"), BigFont, FLinearColor(0.75f, 0.125f, 0.125f, Alpha ) );
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-			TextItem.FontRenderInfo = ShadowedFont;
-			TextItem.SetColor(FLinearColor(0.75f, 0.125f, 0.125f, Alpha ));
 			AddMatchInfoString(TextItem);			
 		}
 	}
@@ -722,18 +681,19 @@ void AShooterHUD::DrawHUD()
 	// Render the info messages such as wating to respawn - these will be drawn below any 'killed player' message.
 	ShowInfoItems(MessageOffset , ScaleUI, 1.0f);
 
+	FlushFrameDrawList();
 }
 
 
 
-void AShooterHUD::DrawDebugInfoString(const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor)
+void AShooterHUD::DrawDebugInfoString(FShooterHUDDrawList& DrawList, const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor)
 {
 #if !UE_BUILD_SHIPPING
-	float SizeX, SizeY;
-	Canvas->StrLen(NormalFont, Text, SizeX, SizeY);
+	const FText DebugText = FText::FromString(Text);
+	const FVector2D TextSize = MeasureText(NormalFont, DebugText);
 
-	const float UsePosX = bAlignLeft ? PosX : PosX - SizeX;
-	const float UsePosY = bAlignTop ? PosY : PosY - SizeY;
+	const float UsePosX = bAlignLeft ? PosX : PosX - TextSize.X;
+	const float UsePosY = bAlignTop ? PosY : PosY - TextSize.Y;
 
 	const float BoxPadding = 5.0f;
 
@@ -743,15 +703,15 @@ void AShooterHUD::DrawDebugInfoString(const FString& Text, float PosX, float Pos
 	// hack in the *2.f scaling for Y since UCanvas::StrLen doesn't take into account newlines
 	const float SCALE_Y = 3.0f;
 
-	FCanvasTileItem TileItem( FVector2D( X, Y ), FVector2D( (SizeX + BoxPadding * SCALE_Y) * ScaleUI, (SizeY * SCALE_Y + BoxPadding * SCALE_Y) * ScaleUI ), DrawColor );
-	TileItem.BlendMode = SE_BLEND_Translucent;
-	Canvas->DrawItem( TileItem );
+	FShooterHUDTile& Tile = DrawList.Tiles[DrawList.Tiles.AddDefaulted()];
+	Tile.Texture = NULL;
+	Tile.Position = FVector2D(X, Y);
+	Tile.Size = FVector2D((TextSize.X + BoxPadding * SCALE_Y) * ScaleUI, (TextSize.Y * SCALE_Y + BoxPadding * SCALE_Y) * ScaleUI);
+	Tile.UV0 = FVector2D(0.0f, 0.0f);
+	Tile.UV1 = FVector2D(1.0f, 1.0f);
+	Tile.Color = DrawColor;
 
-	FCanvasTextItem TextItem( FVector2D( UsePosX, UsePosY), FText::FromString( Text ), NormalFont, TextColor );
-	TextItem.EnableShadow( FLinearColor::Black );
-	TextItem.FontRenderInfo = ShadowedFont;
-	TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
-	Canvas->DrawItem( TextItem );
+	AddText(DrawList, NormalFont, DebugText, UsePosX, UsePosY, ScaleUI, TextColor);
 #endif
 }
 
@@ -783,7 +743,6 @@ void AShooterHUD::DrawCrosshair()
 			}
 			float CenterX = Canvas->ClipX / 2;
 			float CenterY = Canvas->ClipY / 2;
-			Canvas->SetDrawColor(255,255,255,192);
 
 			FCanvasIcon* CurrentCrosshair[5];
  			for (int32 i=0; i< 5; i++)
@@ -804,49 +763,41 @@ void AShooterHUD::DrawCrosshair()
 			//Draw laser dot
 			if (Pawn->IsTargeting() && MyWeapon->UseLaserDot)
 			{
-				Canvas->SetDrawColor(255,0,0,192);
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Center],
+				AddIcon(FrameDrawList, *CurrentCrosshair[EShooterCrosshairDirection::Center],
 					CenterX - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).UL*ScaleUI / 2.0f,
-					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).VL*ScaleUI / 2.0f, ScaleUI);
+					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).VL*ScaleUI / 2.0f, ScaleUI, FColor(255,0,0,192));
 			}
 			//Draw regular crosshair
 			else
 			{
-				FColor PrevColor = Canvas->DrawColor;
+				const FLinearColor CrosshairColor = MyWeapon->CanHit() ? FColor::Red : FColor(255,255,255,192);
 
-				if (MyWeapon->CanHit())
-				{
-					Canvas->SetDrawColor(FColor::Red);
-				}
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Center], 
+				AddIcon(FrameDrawList, *CurrentCrosshair[EShooterCrosshairDirection::Center], 
 					CenterX - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).UL*ScaleUI / 2.0f, 
-					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).VL*ScaleUI / 2.0f, ScaleUI);
+					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).VL*ScaleUI / 2.0f, ScaleUI, CrosshairColor);
 
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Left],
+				AddIcon(FrameDrawList, *CurrentCrosshair[EShooterCrosshairDirection::Left],
 					CenterX - 1 - (*CurrentCrosshair[EShooterCrosshairDirection::Left]).UL * ScaleUI - CrossSpread * ScaleUI, 
-					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Left]).VL*ScaleUI / 2.0f, ScaleUI);
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Right], 
+					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Left]).VL*ScaleUI / 2.0f, ScaleUI, CrosshairColor);
+				AddIcon(FrameDrawList, *CurrentCrosshair[EShooterCrosshairDirection::Right], 
 					CenterX + CrossSpread * ScaleUI, 
-					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Right]).VL * ScaleUI / 2.0f, ScaleUI);
+					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Right]).VL * ScaleUI / 2.0f, ScaleUI, CrosshairColor);
 
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Top], 
+				AddIcon(FrameDrawList, *CurrentCrosshair[EShooterCrosshairDirection::Top], 
 					CenterX - (*CurrentCrosshair[EShooterCrosshairDirection::Top]).UL * ScaleUI / 2.0f,
-					CenterY - 1 - (*CurrentCrosshair[EShooterCrosshairDirection::Top]).VL * ScaleUI - CrossSpread * ScaleUI, ScaleUI);
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Bottom],
+					CenterY - 1 - (*CurrentCrosshair[EShooterCrosshairDirection::Top]).VL * ScaleUI - CrossSpread * ScaleUI, ScaleUI, CrosshairColor);
+				AddIcon(FrameDrawList, *CurrentCrosshair[EShooterCrosshairDirection::Bottom],
 					CenterX - (*CurrentCrosshair[EShooterCrosshairDirection::Bottom]).UL * ScaleUI / 2.0f,
-					CenterY + CrossSpread * ScaleUI, ScaleUI);
-
-				Canvas->SetDrawColor(PrevColor);
+					CenterY + CrossSpread * ScaleUI, ScaleUI, CrosshairColor);
 			}
 
 			if (CurrentTime - LastEnemyHitTime >= 0 && CurrentTime - LastEnemyHitTime <= LastEnemyHitDisplayTime)
 			{
 				const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - LastEnemyHitTime) / LastEnemyHitDisplayTime);
-				Canvas->SetDrawColor(255,255,255,255*Alpha);
 
-				Canvas->DrawIcon(HitNotifyCrosshair, 
+				AddIcon(FrameDrawList, HitNotifyCrosshair, 
 					CenterX - HitNotifyCrosshair.UL*ScaleUI / 2.0f, 
-					CenterY - HitNotifyCrosshair.VL*ScaleUI / 2.0f, ScaleUI);
+					CenterY - HitNotifyCrosshair.VL*ScaleUI / 2.0f, ScaleUI, FColor(255,255,255,255*Alpha));
 			}
 		}
 	}
@@ -858,82 +809,67 @@ void AShooterHUD::DrawDeathMessages()
 	{
 		return;
 	}
-	
-	float OffsetX = 20;
-	float OffsetY = 20;
-
-	Canvas->SetDrawColor(FColor::White);
-	float DeathMsgsPosX = Canvas->OrgX + Offset * ScaleUI;
-	float DeathMsgsPosY = Canvas->ClipY - (OffsetY + DeathMessagesBg.VL) * ScaleUI;
-	FVector Scale(ScaleUI, ScaleUI, 0.f);
-	// hardcoded value to make sure the box is big enough to hold 16 W's for both players' names
-	Scale.X *= 1.85;
-	Canvas->DrawScaledIcon(DeathMessagesBg, DeathMsgsPosX, DeathMsgsPosY, Scale);
-
-	const FColor BlueTeamColor = FColor(70, 70, 152, 255);
-	const FColor RedTeamColor = FColor(152, 70, 70, 255);
-	const FColor OwnerColor = HUDLight;
-
-	const FString KilledText = LOCTEXT("killed"," killed ").ToString();
-	FVector2D KilledTextSize(0.0f, 0.0f);
-
-	const float GameTime = GetWorld()->GetTimeSeconds();
-	const float LinePadding = 6.0f;
-	const float BoxPadding = 2.0f;
-	const float MaxLineX = 300.0f;
-	const float InitialX = Offset * 2.0f * ScaleUI;
-	const float InitialY = DeathMsgsPosY + (DeathMessagesBg.VL - Offset * 2.5f) * ScaleUI ;
-
-	// draw messages
-	float CurrentY = InitialY;
-
-	Canvas->StrLen(NormalFont, KilledText, KilledTextSize.X, KilledTextSize.Y);
-
-	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark );
-	TextItem.EnableShadow( FLinearColor::Black );
-	for (int32 i = DeathMessages.Num() - 1; i >= 0; i--)
+
+	if (DeathMessagesElement.NeedsRebuild(LayoutVersion, DeathMessagesVersion))
 	{
-		const FDeathMessage& Message = DeathMessages[i];
-		float CurrentX = InitialX;
-		FVector2D KillerSize(0.0f, 0.0f);
-		FVector2D VictimNameSize(0.0f, 0.0f);
-		float TextScale = 1.00f;
-		Canvas->StrLen(NormalFont, Message.KillerDesc, KillerSize.X, KillerSize.Y);
-		TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-		TextItem.FontRenderInfo = ShadowedFont;
-		TextItem.SetColor(Message.bKillerIsOwner == true ? HUDLight : ( Message.KillerTeamNum == 0 ? RedTeamColor : BlueTeamColor));
-
-		TextItem.Text = FText::FromString( Message.KillerDesc );
-		Canvas->DrawItem(TextItem, CurrentX, CurrentY);
-		CurrentX += KillerSize.X * TextScale * ScaleUI;
-		
-		if (Message.DamageType.IsValid())
-		{
-			Canvas->SetDrawColor(FColor::White);
-			float ItemSizeY = KilledTextSize.Y * TextScale * ScaleUI;
-			Canvas->DrawIcon(Message.DamageType->KillIcon,
-				CurrentX + (OffsetX / 4.0f) * ScaleUI, 
-				CurrentY + (ItemSizeY - Message.DamageType->KillIcon.VL * ScaleUI) / 2.0f, ScaleUI);
-			CurrentX += (Message.DamageType->KillIcon.UL + OffsetX / 2.0f) * ScaleUI;
-		}
-		else
+		FShooterHUDDrawList& DrawList = DeathMessagesElement.DrawList;
+
+		float OffsetX = 20;
+		float OffsetY = 20;
+
+		float DeathMsgsPosX = Canvas->OrgX + Offset * ScaleUI;
+		float DeathMsgsPosY = Canvas->ClipY - (OffsetY + DeathMessagesBg.VL) * ScaleUI;
+		FVector2D Scale(ScaleUI, ScaleUI);
+		// hardcoded value to make sure the box is big enough to hold 16 W's for both players' names
+		Scale.X *= 1.85;
+		AddScaledIcon(DrawList, DeathMessagesBg, DeathMsgsPosX, DeathMsgsPosY, Scale, FLinearColor::White);
+
+		const FColor BlueTeamColor = FColor(70, 70, 152, 255);
+		const FColor RedTeamColor = FColor(152, 70, 70, 255);
+
+		const FText KilledText = LOCTEXT("killed"," killed ");
+		const FVector2D KilledTextSize = MeasureText(NormalFont, KilledText);
+
+		const float LinePadding = 6.0f;
+		const float InitialX = Offset * 2.0f * ScaleUI;
+		const float InitialY = DeathMsgsPosY + (DeathMessagesBg.VL - Offset * 2.5f) * ScaleUI ;
+
+		// draw messages
+		float CurrentY = InitialY;
+
+		for (int32 i = DeathMessages.Num() - 1; i >= 0; i--)
 		{
-			TextItem.Text = FText::FromString( KilledText );
-			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-			TextItem.FontRenderInfo = ShadowedFont;
-			TextItem.SetColor(HUDDark);
-			Canvas->DrawItem( TextItem, CurrentX, CurrentY );
+			const FDeathMessage& Message = DeathMessages[i];
+			float CurrentX = InitialX;
+			float TextScale = 1.00f;
+
+			const FText KillerText = FText::FromString(Message.KillerDesc);
+			const FVector2D KillerSize = MeasureText(NormalFont, KillerText);
+			AddText(DrawList, NormalFont, KillerText, CurrentX, CurrentY, TextScale * ScaleUI,
+				Message.bKillerIsOwner == true ? HUDLight : ( Message.KillerTeamNum == 0 ? RedTeamColor : BlueTeamColor));
+			CurrentX += KillerSize.X * TextScale * ScaleUI;
+		
+			if (Message.DamageType.IsValid())
+			{
+				float ItemSizeY = KilledTextSize.Y * TextScale * ScaleUI;
+				AddIcon(DrawList, Message.DamageType->KillIcon,
+					CurrentX + (OffsetX / 4.0f) * ScaleUI, 
+					CurrentY + (ItemSizeY - Message.DamageType->KillIcon.VL * ScaleUI) / 2.0f, ScaleUI, FLinearColor::White);
+				CurrentX += (Message.DamageType->KillIcon.UL + OffsetX / 2.0f) * ScaleUI;
+			}
+			else
+			{
+				AddText(DrawList, NormalFont, KilledText, CurrentX, CurrentY, TextScale * ScaleUI, HUDDark);
+				CurrentX += KilledTextSize.X * TextScale * ScaleUI;
+			}
 
-			CurrentX += KilledTextSize.X * TextScale * ScaleUI;
+			AddText(DrawList, NormalFont, FText::FromString(Message.VictimDesc), CurrentX, CurrentY, TextScale * ScaleUI,
+				Message.bVictimIsOwner == true ? HUDLight : (Message.VictimTeamNum == 0 ? RedTeamColor : BlueTeamColor));
+			CurrentY -= (KilledTextSize.Y + LinePadding) * TextScale * ScaleUI;
 		}
-			
-		TextItem.SetColor(Message.bVictimIsOwner == true ? HUDLight : (Message.VictimTeamNum == 0 ? RedTeamColor : BlueTeamColor));		
-
-		Canvas->StrLen(NormalFont, Message.VictimDesc, VictimNameSize.X, VictimNameSize.Y);
-		TextItem.Text = FText::FromString( Message.VictimDesc );
-		Canvas->DrawItem( TextItem, CurrentX, CurrentY );
-		CurrentY -= (KilledTextSize.Y + LinePadding) * TextScale * ScaleUI;
 	}
+
+	AddElement(DeathMessagesElement);
 }
 
 void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState, class AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType)
@@ -965,10 +901,12 @@ void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState,
 			NewMessage.HideTime = GetWorld()->GetTimeSeconds() + MessageDuration;
 
 			DeathMessages.Add(NewMessage);
+			DeathMessagesVersion++;
 			if (KillerPlayerState == MyPlayerState && VictimPlayerState != MyPlayerState)
 			{
 				LastKillTime = GetWorld()->GetTimeSeconds();
 				CenteredKillMessage = FText::FromString(NewMessage.VictimDesc);
+				CenteredKillMessageSize = FVector2D(-1.0f, -1.0f);
 			}
 		}
 	}
@@ -1045,11 +983,10 @@ void AShooterHUD::DrawHitIndicator()
 		{
 			const float TimeModifier = FMath::Max(0.0f, 1 - (CurrentTime - HitNotifyData[i].HitTime) / HitNotifyDisplayTime);
 			const float Alpha = TimeModifier * HitNotifyData[i].HitPercentage;
-			Canvas->SetDrawColor(255, 255, 255, FMath::Clamp(FMath::TruncToInt(Alpha * 255 * 1.5f), 0, 255));
-			Canvas->DrawIcon(HitNotifyIcon[i], 
+			AddIcon(FrameDrawList, HitNotifyIcon[i], 
 				StartX + (HitNotifyIcon[i].U - HitNotifyTexture->GetSizeX() / 2 + Offsets[i].X) * ScaleUI,
 				StartY + (HitNotifyIcon[i].V - HitNotifyTexture->GetSizeY() / 2 + Offsets[i].Y) * ScaleUI,
-				ScaleUI);
+				ScaleUI, FColor(255, 255, 255, FMath::Clamp(FMath::TruncToInt(Alpha * 255 * 1.5f), 0, 255)));
 		}
 	}
 }
@@ -1188,12 +1125,12 @@ void AShooterHUD::SetChatVisibilty( const EVisibility RequiredVisibility )
 	ChatWidget->SetEntryVisibility(RequiredVisibility);
 }
 
-void AShooterHUD::AddChatLine(const FString& ChatString, bool bWantFocus)
+void AShooterHUD::AddChatLine(const FString& ChatString, bool bWantFocus, FName SenderName)
 {
 	TryCreateChatWidget();
 	if( ChatWidget.IsValid() == true )
 	{
-		ChatWidget->AddChatLine(ChatString, bWantFocus);
+		ChatWidget->AddChatLine(ChatString, bWantFocus, SenderName);
 	}
 }
 
@@ -1208,6 +1145,104 @@ void AShooterHUD::MakeUV(FCanvasIcon& Icon, FVector2D& UV0, FVector2D& UV1, uint
 	}
 }
 
+void AShooterHUD::UpdateLayoutVersion()
+{
+	const FVector4 CanvasLayout(Canvas->ClipX, Canvas->ClipY, Canvas->OrgX, Canvas->OrgY);
+	if (CanvasLayout != LastCanvasLayout || ScaleUI != LastScaleUI)
+	{
+		LastCanvasLayout = CanvasLayout;
+		LastScaleUI = ScaleUI;
+		LayoutVersion++;
+	}
+}
+
+void AShooterHUD::AddIcon(FShooterHUDDrawList& DrawList, const FCanvasIcon& Icon, float X, float Y, float Scale, const FLinearColor& Color) const
+{
+	AddScaledIcon(DrawList, Icon, X, Y, FVector2D(Scale, Scale), Color);
+}
+
+void AShooterHUD::AddScaledIcon(FShooterHUDDrawList& DrawList, const FCanvasIcon& Icon, float X, float Y, const FVector2D& Scale, const FLinearColor& Color) const
+{
+	AddIconPart(DrawList, Icon, FVector2D(X, Y), FVector2D(Icon.UL * Scale.X, Icon.VL * Scale.Y), Icon.U, Icon.V, Icon.UL, Icon.VL, Color);
+}
+
+void AShooterHUD::AddIconPart(FShooterHUDDrawList& DrawList, const FCanvasIcon& Icon, const FVector2D& Position, const FVector2D& Size, float U, float V, float UL, float VL, const FLinearColor& Color) const
+{
+	if (Icon.Texture == NULL)
+	{
+		return;
+	}
+
+	const float Width = Icon.Texture->GetSurfaceWidth();
+	const float Height = Icon.Texture->GetSurfaceHeight();
+
+	FShooterHUDTile& Tile = DrawList.Tiles[DrawList.Tiles.AddDefaulted()];
+	Tile.Texture = Icon.Texture;
+	Tile.Position = Position;
+	Tile.Size = Size;
+	Tile.UV0 = FVector2D(U / Width, V / Height);
+	Tile.UV1 = FVector2D((U + UL) / Width, (V + VL) / Height);
+	Tile.Color = Color;
+}
+
+void AShooterHUD::AddText(FShooterHUDDrawList& DrawList, UFont* Font, const FText& Text, float X, float Y, float Scale, const FLinearColor& Color) const
+{
+	FShooterHUDText& Item = DrawList.Texts[DrawList.Texts.AddDefaulted()];
+	Item.Text = Text;
+	Item.Font = Font;
+	Item.Position = FVector2D(X, Y);
+	Item.Scale = Scale;
+	Item.Color = Color;
+}
+
+FVector2D AShooterHUD::MeasureText(UFont* Font, const FText& Text) const
+{
+	FVector2D Size(0.0f, 0.0f);
+	Canvas->StrLen(Font, Text.ToString(), Size.X, Size.Y);
+	return Size;
+}
+
+void AShooterHUD::AddElement(const FShooterHUDElement& Element)
+{
+	FrameDrawList.Append(Element.DrawList);
+}
+
+void AShooterHUD::FlushFrameDrawList()
+{
+	// all tiles first so consecutive ones from the same texture end up in one batch, texts on top of them
+	for (int32 i = 0; i < FrameDrawList.Tiles.Num(); i++)
+	{
+		const FShooterHUDTile& Tile = FrameDrawList.Tiles[i];
+		if (Tile.Texture)
+		{
+			FCanvasTileItem TileItem(Tile.Position, Tile.Texture->Resource, Tile.Size, Tile.UV0, Tile.UV1, Tile.Color);
+			TileItem.BlendMode = SE_BLEND_Translucent;
+			Canvas->DrawItem(TileItem);
+		}
+		else
+		{
+			FCanvasTileItem TileItem(Tile.Position, Tile.Size, Tile.Color);
+			TileItem.BlendMode = SE_BLEND_Translucent;
+			Canvas->DrawItem(TileItem);
+		}
+	}
+
+	FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDLight);
+	TextItem.EnableShadow(FLinearColor::Black);
+	TextItem.FontRenderInfo = ShadowedFont;
+	for (int32 i = 0; i < FrameDrawList.Texts.Num(); i++)
+	{
+		const FShooterHUDText& Text = FrameDrawList.Texts[i];
+		TextItem.Text = Text.Text;
+		TextItem.Font = Text.Font;
+		TextItem.Scale = FVector2D(Text.Scale, Text.Scale);
+		TextItem.SetColor(Text.Color);
+		Canvas->DrawItem(TextItem, Text.Position);
+	}
+
+	FrameDrawList.Reset();
+}
+
 bool AShooterHUD::TryCreateChatWidget()
 {
 	bool bCreated = false;
@@ -1248,12 +1283,11 @@ float AShooterHUD::ShowInfoItems(float YOffset, float ScaleUI, float TextScale)
 
 	for (int32 iItem = 0; iItem < InfoItems.Num() ; iItem++)
 	{
-		float X = 0.0f;
-		float SizeX, SizeY; 
-		Canvas->StrLen(InfoItems[iItem].Font, InfoItems[iItem].Text.ToString(), SizeX, SizeY);
-		X = CanvasCentre - ( SizeX * InfoItems[iItem].Scale.X)/2.0f;
-		Canvas->DrawItem(InfoItems[iItem], X, Y);
-		Y += SizeY * InfoItems[iItem].Scale.Y;
+		const FCanvasTextItem& Item = InfoItems[iItem];
+		const FVector2D Size = MeasureText(Item.Font, Item.Text);
+		const float X = CanvasCentre - (Size.X * Item.Scale.X) / 2.0f;
+		AddText(FrameDrawList, Item.Font, Item.Text, X, Y, Item.Scale.X, Item.Color);
+		Y += Size.Y * Item.Scale.Y;
 	}
 	return Y;
 }
@@ -1267,24 +1301,23 @@ float AShooterHUD::DrawRecentlyKilledPlayer()
 		const float CurrentTime = GetWorld()->GetTimeSeconds();
 		if (CurrentTime - LastKillTime >= 0 && CurrentTime - LastKillTime <= KillFadeOutTime)
 		{
-			FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark);
-			TextItem.EnableShadow(FLinearColor::Black);
-			float SizeX, SizeY;
 			float TextScale = 0.71f;
-			FString Text = CenteredKillMessage.ToString();
+
+			// the message only changes on a kill, measure it once
+			if (CenteredKillMessageSize.X < 0.0f)
+			{
+				CenteredKillMessageSize = MeasureText(BigFont, CenteredKillMessage);
+			}
+			const float SizeX = CenteredKillMessageSize.X;
+			const float SizeY = CenteredKillMessageSize.Y;
 
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - LastKillTime) / KillFadeOutTime);
-			TextItem.Font = BigFont;
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-			Canvas->SetDrawColor(255, 255, 255, 255 * Alpha);
-			Canvas->DrawIcon(KilledIcon, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f,
-				DrawPos - (Offset * 4 - SizeY / 2 * TextScale + KilledIcon.VL / 2) * ScaleUI, ScaleUI);
-			TextItem.SetColor(FColor(HUDLight.R, HUDLight.G, HUDLight.B, HUDLight.A*Alpha));
-			TextItem.Text = FText::FromString(Text);
-			TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
+			AddIcon(FrameDrawList, KilledIcon, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f,
+				DrawPos - (Offset * 4 - SizeY / 2 * TextScale + KilledIcon.VL / 2) * ScaleUI, ScaleUI, FColor(255, 255, 255, 255 * Alpha));
 			LastYPos = (DrawPos - (Offset * 4 * ScaleUI)) + SizeY;
-			Canvas->DrawItem(TextItem, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f + KilledIcon.UL * ScaleUI,
-				DrawPos - ( Offset * 4 * ScaleUI));
+			AddText(FrameDrawList, BigFont, CenteredKillMessage,
+				Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f + KilledIcon.UL * ScaleUI,
+				DrawPos - ( Offset * 4 * ScaleUI), TextScale * ScaleUI, FColor(HUDLight.R, HUDLight.G, HUDLight.B, HUDLight.A*Alpha));
 		}
 	}
 	return LastYPos;
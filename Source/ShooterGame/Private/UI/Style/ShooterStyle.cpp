@@ -3,23 +3,66 @@
 #include "ShooterGame.h"
 #include "ShooterStyle.h"
 #include "SlateGameResources.h"
+#include "AssetRegistryModule.h"
+#include "Engine/StreamableManager.h"
 
 TSharedPtr< FSlateStyleSet > FShooterStyle::ShooterStyleInstance = NULL;
+TSharedPtr< FStreamableManager > FShooterStyle::StyleAssetLoader = NULL;
+double FShooterStyle::StyleAssetsRequestTime = 0.0;
 
 void FShooterStyle::Initialize()
+{
+	if ( ShooterStyleInstance.IsValid() || StyleAssetLoader.IsValid() )
+	{
+		return;
+	}
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	TArray<FAssetData> StyleAssets;
+	AssetRegistryModule.Get().GetAssetsByPath(TEXT("/Game/UI/Styles"), StyleAssets, true);
+
+	TArray<FStringAssetReference> AssetsToLoad;
+	for (int32 i = 0; i < StyleAssets.Num(); i++)
+	{
+		AssetsToLoad.Add(FStringAssetReference(StyleAssets[i].ObjectPath.ToString()));
+	}
+
+	// the registry may still be scanning in the editor, the style set finds the assets itself then
+	if (AssetsToLoad.Num() == 0)
+	{
+		return;
+	}
+
+	StyleAssetsRequestTime = FPlatformTime::Seconds();
+	StyleAssetLoader = MakeShareable(new FStreamableManager());
+	StyleAssetLoader->RequestAsyncLoad(AssetsToLoad, FStreamableDelegate::CreateStatic(&FShooterStyle::OnStyleAssetsLoaded));
+}
+
+void FShooterStyle::OnStyleAssetsLoaded()
 {
 	if ( !ShooterStyleInstance.IsValid() )
 	{
-		ShooterStyleInstance = Create();
-		FSlateStyleRegistry::RegisterSlateStyle( *ShooterStyleInstance );
+		UE_LOG(LogShooter, Log, TEXT("Style assets streamed in after %.1f ms"), (FPlatformTime::Seconds() - StyleAssetsRequestTime) * 1000.0);
+		CreateInstance();
 	}
 }
 
+void FShooterStyle::CreateInstance()
+{
+	ShooterStyleInstance = Create();
+	FSlateStyleRegistry::RegisterSlateStyle( *ShooterStyleInstance );
+}
+
 void FShooterStyle::Shutdown()
 {
-	FSlateStyleRegistry::UnRegisterSlateStyle( *ShooterStyleInstance );
-	ensure( ShooterStyleInstance.IsUnique() );
-	ShooterStyleInstance.Reset();
+	if ( ShooterStyleInstance.IsValid() )
+	{
+		FSlateStyleRegistry::UnRegisterSlateStyle( *ShooterStyleInstance );
+		ensure( ShooterStyleInstance.IsUnique() );
+		ShooterStyleInstance.Reset();
+	}
+	StyleAssetLoader.Reset();
 }
 
 FName FShooterStyle::GetStyleSetName()
@@ -113,5 +156,10 @@ void FShooterStyle::ReloadTextures()
 
 const ISlateStyle& FShooterStyle::Get()
 {
+	if ( !ShooterStyleInstance.IsValid() )
+	{
+		// used before the style assets streamed in, the ones still missing are loaded by the style set
+		CreateInstance();
+	}
 	return *ShooterStyleInstance;
 }
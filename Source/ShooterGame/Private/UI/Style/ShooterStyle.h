@@ -5,10 +5,18 @@
 #include "SlateBasics.h"
 #include "SlateExtras.h"
 
+/**
+ * Slate style of the game.
+ *
+ * The widget style assets are streamed in by a background request started from Initialize, and the style set is
+ * created once they are in. When the style is used before that, the assets that are still missing are loaded
+ * right away.
+ */
 class FShooterStyle
 {
 public:
 
+	/** starts streaming the style assets in */
 	static void Initialize();
 
 	static void Shutdown();
@@ -16,7 +24,7 @@ public:
 	/** reloads textures used by slate renderer */
 	static void ReloadTextures();
 
-	/** @return The Slate style set for the Shooter game */
+	/** @return The Slate style set for the Shooter game, created on first use */
 	static const ISlateStyle& Get();
 
 	static FName GetStyleSetName();
@@ -25,7 +33,19 @@ private:
 
 	static TSharedRef< class FSlateStyleSet > Create();
 
+	/** creates and registers the style set */
+	static void CreateInstance();
+
+	/** [delegate] style assets streamed in */
+	static void OnStyleAssetsLoaded();
+
 private:
 
 	static TSharedPtr< class FSlateStyleSet > ShooterStyleInstance;
+
+	/** streams the style assets in */
+	static TSharedPtr< struct FStreamableManager > StyleAssetLoader;
+
+	/** time the style assets were requested */
+	static double StyleAssetsRequestTime;
 };
\ No newline at end of file
@@ -21,6 +21,7 @@ void SChatWidget::Construct(const FArguments& InArgs, const FLocalPlayerContext&
 	ChatFadeTime = 10.0;
 	LastChatLineTime = -1.0;
 	bVisibiltyNeedsFocus = true;
+	ChatHistory.Reserve(MaxChatLines);
 
 	//some constant values
 	const int32 PaddingValue = 2;
@@ -105,15 +106,27 @@ FSlateColor SChatWidget::GetStyleColor( const FLinearColor& InColor ) const
 	return FSlateColor( ReturnColor );
 }
 
-void SChatWidget::AddChatLine(const FString& ChatString, bool SetFocus)
+void SChatWidget::AddChatLine(const FString& ChatString, bool SetFocus, FName SenderName)
 {
-	ChatHistory.Add(MakeShareable(new FChatLine(ChatString)));
+	FText ChatText = FText::FromString(ChatString);
+	if (SenderName != NAME_None)
+	{
+		ChatText = FText::Format(NSLOCTEXT("ChatWidget", "ChatLineFormat", "{0}: {1}"), FText::FromName(SenderName), ChatText);
+	}
+
+	// drop the oldest lines, their row widgets are released with them
+	if (ChatHistory.Num() >= MaxChatLines)
+	{
+		ChatHistory.RemoveAt(0, ChatHistory.Num() - MaxChatLines + 1, false);
+	}
+
+	TSharedPtr<FChatLine> NewLine = MakeShareable(new FChatLine(SenderName, ChatText));
+	ChatHistory.Add(NewLine);
 
 	if(ChatHistoryListView.IsValid())
 	{
-		FChatLine* LastLine  = ChatHistory[ChatHistory.Num() - 1].Get();
-		UE_LOG(LogOnline, Warning, TEXT("request scroll last=%s"), *LastLine->ChatString);
-		ChatHistoryListView->RequestScrollIntoView(ChatHistory[ChatHistory.Num() - 1]);
+		ChatHistoryListView->RequestListRefresh();
+		ChatHistoryListView->RequestScrollIntoView(NewLine);
 	}
 	
 	FSlateApplication::Get().PlaySound(ChatStyle->RxMessgeSound);
@@ -151,7 +164,8 @@ void SChatWidget::OnChatTextCommitted(const FText& InText, ETextCommit::Type InC
 			if(ChatEditBox.IsValid())
 			{
 				// Add the string so we see it too (we will ignore our own strings in the receive function)
-				AddChatLine( InText.ToString(), true );
+				const APlayerState* MyPlayerState = GetPlayerController()->PlayerState;
+				AddChatLine( InText.ToString(), true, MyPlayerState ? FName(*MyPlayerState->PlayerName) : NAME_None );
 
 				// Clear the text
 				ChatEditBox->SetText(FText());
@@ -226,7 +240,7 @@ TSharedRef<ITableRow> SChatWidget::GenerateChatRow(TSharedPtr<FChatLine> ChatLin
 		SNew(STableRow< TSharedPtr< FChatLine> >, OwnerTable )
 		[
 			SNew(STextBlock)
-			.Text(ChatLine->ChatString)
+			.Text(ChatLine->ChatText)
 			.Font(FShooterStyle::Get().GetFontStyle("ShooterGame.ChatFont"))
 			.ColorAndOpacity(this, &SChatWidget::GetChatLineColor)
 			.WrapTextAt(CHAT_BOX_WIDTH - CHAT_BOX_PADDING)
@@ -44,8 +44,9 @@ public:
 	 *
 	 * @param	ChatString		String to add.
 	 * @param	SetFocus		Should the window be given focus
+	 * @param	SenderName		Name of the player that sent the line, if any
 	 */
-	void AddChatLine(const FString &ChatString, bool SetFocus);
+	void AddChatLine(const FString &ChatString, bool SetFocus, FName SenderName = NAME_None);
 
 	TSharedRef<class SWidget> AsWidget();
 
@@ -54,15 +55,22 @@ protected:
 	// Struct to hold chat lines.
 	struct FChatLine
 	{
-		// Source string of this chat message.
-		FString ChatString;
+		// Player that sent this chat message, names are interned so repeated senders don't copy strings.
+		FName SenderName;
 
-		FChatLine(const FString& InChatString)
-			: ChatString(InChatString)
+		// Display text of this chat message, formatted once when the line is added.
+		FText ChatText;
+
+		FChatLine(FName InSenderName, const FText& InChatText)
+			: SenderName(InSenderName)
+			, ChatText(InChatText)
 		{
 		}
 	};
 
+	/** Number of lines kept in the history, older lines are dropped. */
+	static const int32 MaxChatLines = 64;
+
 	/** Update function. Allows us to focus keyboard. */
 	void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime);
 
@@ -112,7 +120,7 @@ protected:
 	/** The chat history list view. */
 	TSharedPtr< SListView< TSharedPtr< FChatLine> > > ChatHistoryListView;
 
-	/** The array of chat history. */
+	/** The chat history, oldest line first. Bounded by MaxChatLines, only visible lines get row widgets. */
 	TArray< TSharedPtr< FChatLine> > ChatHistory;
 
 	/** Should this chatbox be kept visible. */
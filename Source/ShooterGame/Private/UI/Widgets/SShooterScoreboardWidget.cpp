@@ -15,6 +15,140 @@
 
 #define	NORM_PADDING	(FMargin(5))
 
+/** player row, values are pushed by the scoreboard when they change instead of being polled */
+class SShooterScoreboardRow : public STableRow< TSharedPtr<FScoreboardEntry> >
+{
+public:
+	SLATE_BEGIN_ARGS(SShooterScoreboardRow){}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable, TSharedPtr<FScoreboardEntry> InEntry, TSharedRef<SShooterScoreboardWidget> InScoreboard)
+	{
+		Entry = InEntry;
+		Scoreboard = InScoreboard;
+
+		const FShooterScoreboardStyle* ScoreboardStyle = InScoreboard->ScoreboardStyle;
+
+		// Make the padding here slightly smaller than NORM_PADDING, to fit in more players
+		const FMargin Pad = FMargin(5,1);
+
+		TSharedPtr<SHorizontalBox> PlayerRow;
+		//Speaker Icon display
+		SAssignNew(PlayerRow, SHorizontalBox)
+		+ SHorizontalBox::Slot().Padding(Pad+FMargin(2,0,0,0)).AutoWidth()
+		[
+			SAssignNew(SpeakerIcon, SImage)
+			.Image(FShooterStyle::Get().GetBrush("ShooterGame.Speaker"))
+		];
+
+		//first autosized row with player name
+		PlayerRow->AddSlot() .Padding(Pad)
+		[
+			SAssignNew(NameBorder, SBorder)
+			.Padding(Pad)
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Center)
+			.BorderImage(&ScoreboardStyle->ItemBorderBrush)
+			[
+				SAssignNew(NameText, STextBlock)
+				.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
+			]
+		];
+		//attributes rows (kills, deaths, score/captures)
+		for (uint8 ColIdx = 0; ColIdx < InScoreboard->Columns.Num(); ColIdx++)
+		{
+			TSharedPtr<SBorder> StatBorder;
+			TSharedPtr<STextBlock> StatText;
+			PlayerRow->AddSlot()
+			.Padding(Pad) .AutoWidth() .HAlign(HAlign_Center) .VAlign(VAlign_Center)
+			[
+				SAssignNew(StatBorder, SBorder)
+				.Padding(Pad)
+				.VAlign(VAlign_Center)
+				.HAlign(HAlign_Center)
+				.BorderImage(&ScoreboardStyle->ItemBorderBrush)
+				[
+					SNew(SBox)
+					.WidthOverride(InScoreboard->ScoreBoxWidth)
+					.HAlign(HAlign_Center)
+					[
+						SAssignNew(StatText, STextBlock)
+						.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
+					]
+				]
+			];
+			StatBorders.Add(StatBorder);
+			StatTexts.Add(StatText);
+		}
+
+		static const FTableRowStyle RowStyle = FTableRowStyle()
+			.SetEvenRowBackgroundBrush(*FStyleDefaults::GetNoBrush())
+			.SetEvenRowBackgroundHoveredBrush(*FStyleDefaults::GetNoBrush())
+			.SetOddRowBackgroundBrush(*FStyleDefaults::GetNoBrush())
+			.SetOddRowBackgroundHoveredBrush(*FStyleDefaults::GetNoBrush());
+
+		STableRow< TSharedPtr<FScoreboardEntry> >::Construct(
+			STableRow< TSharedPtr<FScoreboardEntry> >::FArguments()
+			.Style(&RowStyle)
+			.ShowSelection(false)
+			.Content()
+			[
+				PlayerRow.ToSharedRef()
+			],
+			InOwnerTable);
+
+		Refresh();
+	}
+
+	/** update widgets from entry */
+	void Refresh()
+	{
+		TSharedPtr<SShooterScoreboardWidget> PinnedScoreboard = Scoreboard.Pin();
+		if (!PinnedScoreboard.IsValid())
+		{
+			return;
+		}
+
+		const FSlateColor BorderColor = PinnedScoreboard->GetScoreboardBorderColor(Entry->TeamPlayer, Entry->bIsSelected);
+
+		SpeakerIcon->SetVisibility(Entry->bIsTalking ? EVisibility::Visible : EVisibility::Hidden);
+		NameBorder->SetBorderBackgroundColor(BorderColor);
+		NameText->SetText(FText::FromString(Entry->PlayerName));
+		NameText->SetColorAndOpacity(PinnedScoreboard->GetPlayerColor(Entry->bIsOwner));
+
+		for (int32 ColIdx = 0; ColIdx < StatTexts.Num() && ColIdx < Entry->Values.Num(); ColIdx++)
+		{
+			StatBorders[ColIdx]->SetBorderBackgroundColor(BorderColor);
+			StatTexts[ColIdx]->SetText(FText::AsNumber(Entry->Values[ColIdx]));
+			StatTexts[ColIdx]->SetColorAndOpacity(PinnedScoreboard->GetColumnColor(Entry->bIsOwner, ColIdx));
+		}
+	}
+
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override
+	{
+		TSharedPtr<SShooterScoreboardWidget> PinnedScoreboard = Scoreboard.Pin();
+		if (PinnedScoreboard.IsValid())
+		{
+			return PinnedScoreboard->OnMouseOverPlayer(MyGeometry, MouseEvent, Entry->TeamPlayer);
+		}
+		return FReply::Unhandled();
+	}
+
+private:
+
+	/** entry shown in the row */
+	TSharedPtr<FScoreboardEntry> Entry;
+
+	/** owning scoreboard */
+	TWeakPtr<SShooterScoreboardWidget> Scoreboard;
+
+	TSharedPtr<SImage> SpeakerIcon;
+	TSharedPtr<SBorder> NameBorder;
+	TSharedPtr<STextBlock> NameText;
+	TArray<TSharedPtr<SBorder> > StatBorders;
+	TArray<TSharedPtr<STextBlock> > StatTexts;
+};
+
 void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 {
 	ScoreboardStyle = &FShooterStyle::Get().GetWidgetStyle<FShooterScoreboardStyle>("DefaultShooterScoreboardStyle");
@@ -27,7 +161,11 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 	ScoreboardStartTime = FPlatformTime::Seconds();
 	MatchState = InArgs._MatchState.Get();
 
-	UpdatePlayerStateMaps();
+	PlayerStateMapsVersion = INDEX_NONE;
+	RankingStamp = 0;
+	GridMatchState = MatchState;
+	RowHeight = 30.0f;
+	MaxVisibleRows = 16;
 	
 	Columns.Add(FColumnData(LOCTEXT("KillsColumn", "Kills").ToString(),
 		ScoreboardStyle->KillStatColor,
@@ -106,7 +244,7 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 	[
 		SAssignNew(ScoreboardData, SVerticalBox)
 	];
-	UpdateScoreboardGrid();
+	UpdatePlayerStateMaps();
 
 	SBorder::Construct(
 		SBorder::FArguments()
@@ -184,26 +322,54 @@ FString SShooterScoreboardWidget::GetMatchOutcomeText() const
 void SShooterScoreboardWidget::UpdateScoreboardGrid()
 {
 	ScoreboardData->ClearChildren();
-	for (uint8 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
+	GridMatchState = MatchState;
+
+	const int32 NumTeams = PlayerStateMaps.Num();
+	TeamLists.Reset();
+	TeamTotalsRows.Reset();
+	TeamTotalTexts.Reset();
+	TeamTotals.Reset();
+	TeamLists.SetNum(NumTeams);
+	TeamTotalsRows.SetNum(NumTeams);
+	TeamTotalTexts.SetNum(NumTeams);
+	TeamTotals.Init(INDEX_NONE, NumTeams);
+
+	for (uint8 TeamNum = 0; TeamNum < NumTeams; TeamNum++)
 	{
-		//Player rows from each team
+		//Player rows from each team, only rows scrolled into view get widgets
 		ScoreboardData->AddSlot() .AutoHeight()
 			[
-				MakePlayerRows(TeamNum)
+				SNew(SBox)
+				.HeightOverride(this, &SShooterScoreboardWidget::GetTeamListHeight, TeamNum)
+				[
+					SAssignNew(TeamLists[TeamNum], SListView<TSharedPtr<FScoreboardEntry> >)
+					.ItemHeight(RowHeight)
+					.ListItemsSource(&PlayerStateMaps[TeamNum])
+					.SelectionMode(ESelectionMode::None)
+					.OnGenerateRow(this, &SShooterScoreboardWidget::MakePlayerRow)
+				]
 			];
 		//If we have more than one team, we are playing team based game mode, add totals
-		if (PlayerStateMaps.Num() > 1 && PlayerStateMaps[TeamNum].Num() > 0)
+		if (NumTeams > 1)
 		{
-			// Horizontal Ruler
-			ScoreboardData->AddSlot() .AutoHeight() .Padding(NORM_PADDING)
+			TSharedRef<SVerticalBox> TotalsRow = SNew(SVerticalBox)
+				// Horizontal Ruler
+				+SVerticalBox::Slot() .AutoHeight() .Padding(NORM_PADDING)
 				[
 					SNew(SBorder)
 					.Padding(1)
 					.BorderImage(&ScoreboardStyle->ItemBorderBrush)
+				]
+				+SVerticalBox::Slot() .AutoHeight()
+				[
+					MakeTotalsRow(TeamNum)
 				];
+			TotalsRow->SetVisibility(PlayerStateMaps[TeamNum].Num() > 0 ? EVisibility::Visible : EVisibility::Collapsed);
+			TeamTotalsRows[TeamNum] = TotalsRow;
+
 			ScoreboardData->AddSlot() .AutoHeight()
 				[
-					MakeTotalsRow(TeamNum)
+					TotalsRow
 				];
 		}
 	}
@@ -258,42 +424,177 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 	}
 }
 
+FOptionalSize SShooterScoreboardWidget::GetTeamListHeight(uint8 TeamNum) const
+{
+	const int32 MaxTeamRows = FMath::Max(1, MaxVisibleRows / FMath::Max(1, PlayerStateMaps.Num()));
+	const int32 NumRows = PlayerStateMaps.IsValidIndex(TeamNum) ? PlayerStateMaps[TeamNum].Num() : 0;
+	return FMath::Min(NumRows, MaxTeamRows) * RowHeight;
+}
+
 void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 {
-	if (PCOwner.IsValid())
+	AShooterGameState* const GameState = PCOwner.IsValid() ? Cast<AShooterGameState>(PCOwner->GetWorld()->GameState) : NULL;
+	if (GameState)
 	{
-		AShooterGameState* const GameState = Cast<AShooterGameState>(PCOwner->GetWorld()->GameState);
-		if (GameState)
+		const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
+
+		// team sections are only rebuilt when teams or match state change, list items are kept up to date below
+		if (PlayerStateMaps.Num() != NumTeams || GridMatchState != MatchState || TeamLists.Num() != NumTeams)
 		{
-			bool bRequiresWidgetUpdate = false;
-			const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
-			LastTeamPlayerCount.Reset();
-			LastTeamPlayerCount.AddZeroed(PlayerStateMaps.Num());
-			for (int32 i = 0; i < PlayerStateMaps.Num(); i++)
+			PlayerStateMaps.SetNum(NumTeams);
+			PlayerStateMapsVersion = INDEX_NONE;
+			UpdateScoreboardGrid();
+		}
+
+		// ranking is maintained by the game state, only reorder when it changed
+		if (GameState->GetRankingVersion() != PlayerStateMapsVersion)
+		{
+			PlayerStateMapsVersion = GameState->GetRankingVersion();
+			UpdateRanking(GameState);
+		}
+	}
+
+	UpdateSelectedPlayer();
+
+	// push changed values to rows in view and team totals
+	for (int32 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
+	{
+		int32 TeamTotal = 0;
+		for (int32 PlayerId = 0; PlayerId < PlayerStateMaps[TeamNum].Num(); PlayerId++)
+		{
+			FScoreboardEntry& Entry = *PlayerStateMaps[TeamNum][PlayerId];
+			if (UpdateEntry(Entry))
 			{
-				LastTeamPlayerCount[i] = PlayerStateMaps[i].Num();
+				TSharedPtr<SShooterScoreboardRow> Row = Entry.RowWidget.Pin();
+				if (Row.IsValid())
+				{
+					Row->Refresh();
+				}
 			}
 
-			PlayerStateMaps.Reset();
-			PlayerStateMaps.AddZeroed(NumTeams);
-		
-			for (int32 i = 0; i < NumTeams; i++)
+			AShooterPlayerState* PlayerState = Entry.PlayerState.Get();
+			if (PlayerState && Columns.Num() > 0)
 			{
-				GameState->GetRankedMap(i, PlayerStateMaps[i]);
+				TeamTotal += Columns.Last().AttributeGetter.Execute(PlayerState);
+			}
+		}
 
-				if (LastTeamPlayerCount.Num() > 0 && PlayerStateMaps[i].Num() != LastTeamPlayerCount[i])
-				{
-					bRequiresWidgetUpdate = true;
-				}
+		TeamTotal = LerpForCountup(TeamTotal);
+		if (TeamTotalTexts.IsValidIndex(TeamNum) && TeamTotalTexts[TeamNum].IsValid() && TeamTotals[TeamNum] != TeamTotal)
+		{
+			TeamTotals[TeamNum] = TeamTotal;
+			TeamTotalTexts[TeamNum]->SetText(FText::AsNumber(TeamTotal));
+		}
+	}
+}
+
+void SShooterScoreboardWidget::UpdateRanking(AShooterGameState* GameState)
+{
+	RankingStamp++;
+
+	for (int32 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
+	{
+		const TArray<AShooterPlayerState*>& RankedPlayers = GameState->GetRankedPlayers(TeamNum);
+		TArray<TSharedPtr<FScoreboardEntry> >& TeamEntries = PlayerStateMaps[TeamNum];
+
+		bool bOrderChanged = TeamEntries.Num() != RankedPlayers.Num();
+		TArray<TSharedPtr<FScoreboardEntry> > RankedEntries;
+		RankedEntries.Reserve(RankedPlayers.Num());
+
+		for (int32 Rank = 0; Rank < RankedPlayers.Num(); Rank++)
+		{
+			TSharedPtr<FScoreboardEntry>& Entry = EntriesByPlayer.FindOrAdd(RankedPlayers[Rank]);
+			if (!Entry.IsValid())
+			{
+				Entry = MakeShareable(new FScoreboardEntry());
+				Entry->PlayerState = RankedPlayers[Rank];
 			}
-			if (bRequiresWidgetUpdate)
+
+			Entry->TeamPlayer = FTeamPlayer(TeamNum, Rank);
+			Entry->RankingStamp = RankingStamp;
+			bOrderChanged = bOrderChanged || TeamEntries[Rank] != Entry;
+			RankedEntries.Add(Entry);
+		}
+
+		// rows of entries that stay in the list keep their widgets, the list only generates rows for new ones
+		if (bOrderChanged)
+		{
+			TeamEntries = RankedEntries;
+			if (TeamLists.IsValidIndex(TeamNum) && TeamLists[TeamNum].IsValid())
 			{
-				UpdateScoreboardGrid();
+				TeamLists[TeamNum]->RequestListRefresh();
 			}
 		}
+
+		if (TeamTotalsRows.IsValidIndex(TeamNum) && TeamTotalsRows[TeamNum].IsValid())
+		{
+			TeamTotalsRows[TeamNum]->SetVisibility(TeamEntries.Num() > 0 ? EVisibility::Visible : EVisibility::Collapsed);
+		}
 	}
 
-	UpdateSelectedPlayer();
+	// forget players that left
+	for (auto It = EntriesByPlayer.CreateIterator(); It; ++It)
+	{
+		if (It.Value()->RankingStamp != RankingStamp)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool SShooterScoreboardWidget::UpdateEntry(FScoreboardEntry& Entry) const
+{
+	AShooterPlayerState* PlayerState = Entry.PlayerState.Get();
+	if (PlayerState == NULL)
+	{
+		return false;
+	}
+
+	bool bChanged = false;
+
+	if (Entry.SourceName != PlayerState->PlayerName || Entry.PlayerName.IsEmpty())
+	{
+		Entry.SourceName = PlayerState->PlayerName;
+		Entry.PlayerName = PlayerState->GetShortPlayerName();
+		bChanged = true;
+	}
+
+	if (Entry.Values.Num() != Columns.Num())
+	{
+		Entry.Values.Init(INDEX_NONE, Columns.Num());
+	}
+
+	for (int32 ColIdx = 0; ColIdx < Columns.Num(); ColIdx++)
+	{
+		const int32 Value = LerpForCountup(Columns[ColIdx].AttributeGetter.Execute(PlayerState));
+		if (Entry.Values[ColIdx] != Value)
+		{
+			Entry.Values[ColIdx] = Value;
+			bChanged = true;
+		}
+	}
+
+	const bool bIsOwner = PCOwner.IsValid() && PCOwner->PlayerState == PlayerState;
+	const bool bIsSelected = IsSelectedPlayer(Entry.TeamPlayer);
+	bool bIsTalking = false;
+	for (int32 i = 0; i < PlayersTalkingThisFrame.Num(); ++i)
+	{
+		if (PlayersTalkingThisFrame[i].Value && Entry.PlayerName == PlayersTalkingThisFrame[i].Key)
+		{
+			bIsTalking = true;
+			break;
+		}
+	}
+
+	if (Entry.bIsOwner != bIsOwner || Entry.bIsSelected != bIsSelected || Entry.bIsTalking != bIsTalking)
+	{
+		Entry.bIsOwner = bIsOwner;
+		Entry.bIsSelected = bIsSelected;
+		Entry.bIsTalking = bIsTalking;
+		bChanged = true;
+	}
+
+	return bChanged;
 }
 
 void SShooterScoreboardWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
@@ -386,17 +687,8 @@ void SShooterScoreboardWidget::OnSelectedPlayerPrev()
 		return;
 	}
 
-	// We don't want to decrease the player Id, we want to find the current one in the list and then select the one before it
-	int32 PrevPlayerId = -1;
-	for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[SelectedPlayer.TeamNum]); PlayerIt; ++PlayerIt)	// This would be easier with a .ReverseIterator call
-	{
-		const int32 PlayerId = PlayerIt.Key();
-		if( PlayerId == SelectedPlayer.PlayerId )
-		{
-			break;
-		}
-		PrevPlayerId = PlayerId;
-	}
+	// player ids are ranks within the team, so the previous player is the one ranked above
+	int32 PrevPlayerId = SelectedPlayer.PlayerId - 1;
 
 	if( PrevPlayerId == -1 )
 	{
@@ -410,16 +702,17 @@ void SShooterScoreboardWidget::OnSelectedPlayerPrev()
 		}
 
 		// We want the last player in the team
-		for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[SelectedPlayer.TeamNum]); PlayerIt; ++PlayerIt)	// This would be easier with a .Last call
-		{
-			const int32 PlayerId = PlayerIt.Key();
-			PrevPlayerId = PlayerId;
-		}
+		PrevPlayerId = PlayerStateMaps[SelectedPlayer.TeamNum].Num() - 1;
 	}
 
 	check( SelectedPlayer.PlayerId != -1 );
 	SelectedPlayer.PlayerId = PrevPlayerId;
 	PlaySound(ScoreboardStyle->PlayerChangeSound);
+
+	if (PlayerStateMaps[SelectedPlayer.TeamNum].IsValidIndex(SelectedPlayer.PlayerId))
+	{
+		TeamLists[SelectedPlayer.TeamNum]->RequestScrollIntoView(PlayerStateMaps[SelectedPlayer.TeamNum][SelectedPlayer.PlayerId]);
+	}
 }
 
 void SShooterScoreboardWidget::OnSelectedPlayerNext()
@@ -430,26 +723,13 @@ void SShooterScoreboardWidget::OnSelectedPlayerNext()
 		return;
 	}
 
-	// We don't want to increase the player Id, we want to find the current one in the list and then select the one after
-	bool bNext = false;
-	for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[SelectedPlayer.TeamNum]); PlayerIt; ++PlayerIt)
+	// player ids are ranks within the team, so the next player is the one ranked below
+	if (PlayerStateMaps[SelectedPlayer.TeamNum].IsValidIndex(SelectedPlayer.PlayerId + 1))
 	{
-		const int32 PlayerId = PlayerIt.Key();
-		if( PlayerId == SelectedPlayer.PlayerId )
-		{
-			bNext = true;
-		}
-		else if( bNext == true )
-		{
-			SelectedPlayer.PlayerId = PlayerId;
-			PlaySound(ScoreboardStyle->PlayerChangeSound);
-
-			bNext = false;
-			break;
-		}
+		SelectedPlayer.PlayerId++;
+		PlaySound(ScoreboardStyle->PlayerChangeSound);
 	}
-
-	if( bNext == true )
+	else
 	{
 		// If next is still true, our current selection was last in their team, try the next team...
 		SelectedPlayer.TeamNum++;
@@ -463,6 +743,11 @@ void SShooterScoreboardWidget::OnSelectedPlayerNext()
 		SelectedPlayer.PlayerId = 0;
 		PlaySound(ScoreboardStyle->PlayerChangeSound);
 	}
+
+	if (PlayerStateMaps[SelectedPlayer.TeamNum].IsValidIndex(SelectedPlayer.PlayerId))
+	{
+		TeamLists[SelectedPlayer.TeamNum]->RequestScrollIntoView(PlayerStateMaps[SelectedPlayer.TeamNum][SelectedPlayer.PlayerId]);
+	}
 }
 
 void SShooterScoreboardWidget::ResetSelectedPlayer()
@@ -493,12 +778,12 @@ bool SShooterScoreboardWidget::SetSelectedPlayerUs()
 	{
 		for (uint8 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
 		{
-			for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[TeamNum]); PlayerIt; ++PlayerIt)
+			for (int32 PlayerId = 0; PlayerId < PlayerStateMaps[TeamNum].Num(); PlayerId++)
 			{
-				const TWeakObjectPtr<AShooterPlayerState> PlayerState = PlayerIt.Value();
+				const TWeakObjectPtr<AShooterPlayerState> PlayerState = PlayerStateMaps[TeamNum][PlayerId]->PlayerState;
 				if( PlayerState.IsValid() && PC->PlayerState && PC->PlayerState == PlayerState.Get() )
 				{
-					SelectedPlayer = FTeamPlayer(TeamNum, PlayerIt.Key());
+					SelectedPlayer = FTeamPlayer(TeamNum, PlayerId);
 					return true;
 				}
 			}
@@ -565,31 +850,8 @@ bool SShooterScoreboardWidget::ProfileUIOpened() const
 	return false;
 }
 
-EVisibility SShooterScoreboardWidget::PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const
-{
-	return GetSortedPlayerState(TeamPlayer) ? EVisibility::Visible : EVisibility::Collapsed;
-}
-
-EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const
-{
-	AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	if (PlayerState)
-	{
-		FString PlayerName = PlayerState->GetShortPlayerName();
-		for (int32 i = 0; i < PlayersTalkingThisFrame.Num(); ++i)
-		{
-			if (PlayerName == PlayersTalkingThisFrame[i].Key && PlayersTalkingThisFrame[i].Value)
-			{
-				return EVisibility::Visible;
-			}
-		}
-	}
-	return EVisibility::Hidden;
-}
-
-FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const
+FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer& TeamPlayer, bool bIsSelected) const
 {
-	const bool bIsSelected = IsSelectedPlayer(TeamPlayer);
 	const int32 RedTeam = 0;
 	const float BaseValue = bIsSelected == true ? 0.15f : 0.0f;
 	const float AlphaValue = bIsSelected == true ? 1.0f : 0.3f;
@@ -598,21 +860,10 @@ FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer
 	return FLinearColor(BaseValue + RedValue, BaseValue, BaseValue + BlueValue, AlphaValue);
 }
 
-FString SShooterScoreboardWidget::GetPlayerName(const FTeamPlayer TeamPlayer) const
-{
-	const AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	if (PlayerState)
-	{
-		return PlayerState->GetShortPlayerName();
-	}
-
-	return TEXT("");
-}
-
-FSlateColor SShooterScoreboardWidget::GetPlayerColor(const FTeamPlayer TeamPlayer) const
+FSlateColor SShooterScoreboardWidget::GetPlayerColor(bool bIsOwner) const
 {
 	// If this is the owner players row, tint the text color to show ourselves more clearly
-	if( IsOwnerPlayer(TeamPlayer) )
+	if( bIsOwner )
 	{
 		return FSlateColor(FLinearColor::Yellow);
 	}
@@ -621,10 +872,10 @@ FSlateColor SShooterScoreboardWidget::GetPlayerColor(const FTeamPlayer TeamPlaye
 	return TextStyle.ColorAndOpacity;
 }
 
-FSlateColor SShooterScoreboardWidget::GetColumnColor(const FTeamPlayer TeamPlayer, uint8 ColIdx) const
+FSlateColor SShooterScoreboardWidget::GetColumnColor(bool bIsOwner, uint8 ColIdx) const
 {
 	// If this is the owner players row, tint the text color to show ourselves more clearly
-	if( IsOwnerPlayer(TeamPlayer) )
+	if( bIsOwner )
 	{
 		return FSlateColor(FLinearColor::Yellow);
 	}
@@ -638,32 +889,6 @@ bool SShooterScoreboardWidget::IsOwnerPlayer(const FTeamPlayer& TeamPlayer) cons
 	return ( PCOwner.IsValid() && PCOwner->PlayerState && PCOwner->PlayerState == GetSortedPlayerState(TeamPlayer) );
 }
 
-FString SShooterScoreboardWidget::GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const
-{
-	int32 StatTotal = 0;
-	if (TeamPlayer.PlayerId != SpecialPlayerIndex::All)
-	{
-		AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-		if (PlayerState)
-		{
-			StatTotal = Getter.Execute(PlayerState);
-		}
-	} 
-	else
-	{
-		for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[TeamPlayer.TeamNum]); PlayerIt; ++PlayerIt)
-		{
-			AShooterPlayerState* PlayerState = PlayerIt.Value().Get();
-			if (PlayerState)
-			{
-				StatTotal += Getter.Execute(PlayerState);
-			}
-		}
-	}
-
-	return FText::AsNumber(LerpForCountup(StatTotal)).ToString();
-}
-
 int32 SShooterScoreboardWidget::LerpForCountup(int32 ScoreValue) const
 {
 	if (MatchState > EShooterMatchState::Playing)
@@ -677,7 +902,7 @@ int32 SShooterScoreboardWidget::LerpForCountup(int32 ScoreValue) const
 	}
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
+TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum)
 {
 	TSharedPtr<SHorizontalBox> TotalsRow;
 
@@ -729,8 +954,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 			.WidthOverride(ScoreBoxWidth)
 			.HAlign(HAlign_Center)
 			[
-				SNew(STextBlock)
-				.Text(this, &SShooterScoreboardWidget::GetStat, Columns.Last().AttributeGetter, FTeamPlayer(TeamNum, SpecialPlayerIndex::All))
+				SAssignNew(TeamTotalTexts[TeamNum], STextBlock)
 				.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.HeaderTextStyle")
 			]
 		]
@@ -739,89 +963,20 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 	return TotalsRow.ToSharedRef();
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRows(uint8 TeamNum) const
-{
-	TSharedRef<SVerticalBox> PlayerRows = SNew(SVerticalBox);
-
-	for (int32 PlayerIndex=0; PlayerIndex < PlayerStateMaps[TeamNum].Num(); PlayerIndex++ )
-	{
-		PlayerRows->AddSlot() .AutoHeight()
-		[
-			MakePlayerRow(FTeamPlayer(TeamNum, PlayerIndex))
-		];
-	}
-
-	return PlayerRows;
-}
-
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& TeamPlayer) const
+TSharedRef<ITableRow> SShooterScoreboardWidget::MakePlayerRow(TSharedPtr<FScoreboardEntry> Entry, const TSharedRef<STableViewBase>& OwnerTable)
 {
-	// Make the padding here slightly smaller than NORM_PADDING, to fit in more players
-	const FMargin Pad = FMargin(5,1);
-
-	TSharedPtr<SHorizontalBox> PlayerRow;
-	//Speaker Icon display
-	SAssignNew(PlayerRow, SHorizontalBox)
-	+ SHorizontalBox::Slot().Padding(Pad+FMargin(2,0,0,0)).AutoWidth()
-	[
-		SNew(SImage)
-		.Image(FShooterStyle::Get().GetBrush("ShooterGame.Speaker"))
-		.Visibility(this, &SShooterScoreboardWidget::SpeakerIconVisibility, TeamPlayer)
-	];
+	UpdateEntry(*Entry);
 
-	//first autosized row with player name
-	PlayerRow->AddSlot() .Padding(Pad)
-	[
-		SNew(SBorder)
-		.Padding(Pad)
-		.HAlign(HAlign_Right)
-		.VAlign(VAlign_Center)
-		.Visibility(this, &SShooterScoreboardWidget::PlayerPresenceToItemVisibility, TeamPlayer)
-		.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
-		.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, TeamPlayer)
-		.BorderImage(&ScoreboardStyle->ItemBorderBrush)
-		[
-			SNew(STextBlock)
-			.Text(this, &SShooterScoreboardWidget::GetPlayerName, TeamPlayer)
-			.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
-			.ColorAndOpacity(this, &SShooterScoreboardWidget::GetPlayerColor, TeamPlayer)
-		]
-	];
-	//attributes rows (kills, deaths, score/captures)
-	for (uint8 ColIdx = 0; ColIdx < Columns.Num(); ColIdx++)
-	{
-		PlayerRow->AddSlot()
-		.Padding(Pad) .AutoWidth() .HAlign(HAlign_Center) .VAlign(VAlign_Center)
-		[
-			SNew(SBorder)
-			.Padding(Pad)
-			.VAlign(VAlign_Center)
-			.HAlign(HAlign_Center)
-			.Visibility(this, &SShooterScoreboardWidget::PlayerPresenceToItemVisibility, TeamPlayer)
-			.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
-			.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, TeamPlayer)
-			.BorderImage(&ScoreboardStyle->ItemBorderBrush)
-			[
-				SNew(SBox)
-				.WidthOverride(ScoreBoxWidth)
-				.HAlign(HAlign_Center)
-				[
-					SNew(STextBlock)
-					.Text(this, &SShooterScoreboardWidget::GetStat, Columns[ColIdx].AttributeGetter, TeamPlayer)
-					.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
-					.ColorAndOpacity(this, &SShooterScoreboardWidget::GetColumnColor, TeamPlayer, ColIdx)
-				]
-			]
-		];
-	}
-	return PlayerRow.ToSharedRef();
+	TSharedRef<SShooterScoreboardRow> Row = SNew(SShooterScoreboardRow, OwnerTable, Entry, SharedThis(this));
+	Entry->RowWidget = Row;
+	return Row;
 }
 
 AShooterPlayerState* SShooterScoreboardWidget::GetSortedPlayerState(const FTeamPlayer& TeamPlayer) const
 {
-	if (PlayerStateMaps.IsValidIndex(TeamPlayer.TeamNum) && PlayerStateMaps[TeamPlayer.TeamNum].Contains(TeamPlayer.PlayerId))
+	if (PlayerStateMaps.IsValidIndex(TeamPlayer.TeamNum) && PlayerStateMaps[TeamPlayer.TeamNum].IsValidIndex(TeamPlayer.PlayerId))
 	{
-		return PlayerStateMaps[TeamPlayer.TeamNum].FindRef(TeamPlayer.PlayerId).Get();
+		return PlayerStateMaps[TeamPlayer.TeamNum][TeamPlayer.PlayerId]->PlayerState.Get();
 	}
 	
 	return NULL;
@@ -71,6 +71,48 @@ struct FTeamPlayer
 	}
 };
 
+/** scoreboard row model, kept for a player across ranking changes so its row widget is reused */
+struct FScoreboardEntry
+{
+	/** player shown in the row */
+	TWeakObjectPtr<AShooterPlayerState> PlayerState;
+
+	/** team and rank within the team */
+	FTeamPlayer TeamPlayer;
+
+	/** PlayerState->PlayerName the displayed name was made from */
+	FString SourceName;
+
+	/** displayed name */
+	FString PlayerName;
+
+	/** displayed column values */
+	TArray<int32> Values;
+
+	/** is it the owner's row */
+	bool bIsOwner;
+
+	/** is the player talking */
+	bool bIsTalking;
+
+	/** is the row selected */
+	bool bIsSelected;
+
+	/** ranking update that last saw the player, stale entries are dropped */
+	int32 RankingStamp;
+
+	/** row widget while the entry is scrolled into view */
+	TWeakPtr<class SShooterScoreboardRow> RowWidget;
+
+	FScoreboardEntry()
+		: bIsOwner(false)
+		, bIsTalking(false)
+		, bIsSelected(false)
+		, RankingStamp(INDEX_NONE)
+	{
+	}
+};
+
 
 //class declare
 class SShooterScoreboardWidget : public SBorder
@@ -88,7 +130,7 @@ class SShooterScoreboardWidget : public SBorder
 	/** needed for every widget */
 	void Construct(const FArguments& InArgs);
 
-	/** update PlayerState maps with every tick when scoreboard is shown */
+	/** update scoreboard entries with every tick when scoreboard is shown */
 	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 
 	/** if we want to receive focus */
@@ -105,51 +147,44 @@ class SShooterScoreboardWidget : public SBorder
 
 protected:
 
-	/** updates widgets when players leave or join */
+	friend class SShooterScoreboardRow;
+
+	/** rebuilds team sections when the number of teams or the match state changes */
 	void UpdateScoreboardGrid();
 
 	/** makes total row widget */
-	TSharedRef<SWidget> MakeTotalsRow(uint8 TeamNum) const;
+	TSharedRef<SWidget> MakeTotalsRow(uint8 TeamNum);
 
-	/** makes player rows */
-	TSharedRef<SWidget> MakePlayerRows(uint8 TeamNum) const;
+	/** makes row widget for entry, called by the team list for rows scrolled into view */
+	TSharedRef<ITableRow> MakePlayerRow(TSharedPtr<FScoreboardEntry> Entry, const TSharedRef<STableViewBase>& OwnerTable);
 
-	/** makes player row */
-	TSharedRef<SWidget> MakePlayerRow(const FTeamPlayer& TeamPlayer) const;
+	/** get height of team list, grows with the team up to its share of MaxVisibleRows */
+	FOptionalSize GetTeamListHeight(uint8 TeamNum) const;
 
-	/** updates PlayerState maps to display accurate scores */
+	/** updates entries from the game state ranking and pushes changed values to visible rows */
 	void UpdatePlayerStateMaps();
 
-	/** gets ranked map for specific team */
-	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;
+	/** reorder team entries after the game state ranking changed, only touches lists whose order changed */
+	void UpdateRanking(class AShooterGameState* GameState);
+
+	/** refresh displayed values of entry, returns true if any of them changed */
+	bool UpdateEntry(FScoreboardEntry& Entry) const;
 
 	/** gets PlayerState for specific team and player */
 	AShooterPlayerState* GetSortedPlayerState(const FTeamPlayer& TeamPlayer) const;
 
-	/** get player visibility */
-	EVisibility PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const;
-
-	/** get speaker icon visibility */
-	EVisibility SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const;
-
 	/** get scoreboard border color */
-	FSlateColor GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const;
-
-	/** get player name */
-	FString GetPlayerName(const FTeamPlayer TeamPlayer) const;
+	FSlateColor GetScoreboardBorderColor(const FTeamPlayer& TeamPlayer, bool bIsSelected) const;
 
 	/** get player color */
-	FSlateColor GetPlayerColor(const FTeamPlayer TeamPlayer) const;
+	FSlateColor GetPlayerColor(bool bIsOwner) const;
 
 	/** get the column color */
-	FSlateColor GetColumnColor(const FTeamPlayer TeamPlayer, uint8 ColIdx) const;
+	FSlateColor GetColumnColor(bool bIsOwner, uint8 ColIdx) const;
 
 	/** checks to see if the specified player is the owner */
 	bool IsOwnerPlayer(const FTeamPlayer& TeamPlayer) const;
 
-	/** get specific stat for team number and optionally player */
-	FString GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const;
-
 	/** linear interpolated score for match outcome animation */
 	int32 LerpForCountup(int32 ScoreValue) const;
 
@@ -216,18 +251,45 @@ protected:
 	/** the player currently selected in the scoreboard */
 	FTeamPlayer SelectedPlayer;
 
-	/** the Ranked PlayerState map...cleared every frame */
-	TArray<RankedPlayerMap> PlayerStateMaps;
+	/** ranked entries of each team, list items of the team lists */
+	TArray<TArray<TSharedPtr<FScoreboardEntry> > > PlayerStateMaps;
+
+	/** entries by player */
+	TMap<TWeakObjectPtr<AShooterPlayerState>, TSharedPtr<FScoreboardEntry> > EntriesByPlayer;
+
+	/** game state ranking version PlayerStateMaps was built from */
+	int32 PlayerStateMapsVersion;
 
-	/** player count in each team in the last tick */
-	TArray<int32> LastTeamPlayerCount;
+	/** incremented on every ranking update, to find entries of players that left */
+	int32 RankingStamp;
+
+	/** match state the grid was built for */
+	EShooterMatchState::Type GridMatchState;
 
 	/** holds talking player data */
 	TArray<TPair<FString, bool>> PlayersTalkingThisFrame;
 
-	/** holds player info rows */
+	/** holds team sections and match outcome */
 	TSharedPtr<SVerticalBox> ScoreboardData;
 
+	/** virtualized player list of each team */
+	TArray<TSharedPtr<SListView<TSharedPtr<FScoreboardEntry> > > > TeamLists;
+
+	/** totals row of each team, only shown in team games */
+	TArray<TSharedPtr<SWidget> > TeamTotalsRows;
+
+	/** total score text of each team */
+	TArray<TSharedPtr<STextBlock> > TeamTotalTexts;
+
+	/** displayed total score of each team */
+	TArray<int32> TeamTotals;
+
+	/** height of a player row */
+	float RowHeight;
+
+	/** max number of player rows shown without scrolling, split between teams */
+	int32 MaxVisibleRows;
+
 	/** stat columns data */
 	TArray<FColumnData> Columns;
 
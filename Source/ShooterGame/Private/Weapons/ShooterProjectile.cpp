@@ -2,6 +2,8 @@
 
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "Online/ShooterNetProfiler.h"
+#include "ShooterStats.h"
 
 AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -108,22 +110,112 @@ void AShooterProjectile::OnBounce(const FHitResult& ImpactResult, const FVector&
 
 void AShooterProjectile::Stick(UPrimitiveComponent * MyComp, UPrimitiveComponent * OtherComp, bool bSelfMoved, FHitResult const & Hit)
 {
-	if (Role == ROLE_Authority)
+	AActor* HitActor = Hit.GetActor();
+	USkeletalMeshComponent* HitMesh = Cast<USkeletalMeshComponent>(OtherComp);
+	const int32 BoneIndex = HitMesh ? HitMesh->GetBoneIndex(Hit.BoneName) : INDEX_NONE;
+
+	// attach to the same component clients will resolve from StuckInfo
+	USceneComponent* Parent = HitActor ? GetStuckParent(HitActor, OtherComp, BoneIndex) : OtherComp;
+	USkeletalMeshComponent* ParentMesh = Cast<USkeletalMeshComponent>(Parent);
+	const FName BoneName = (ParentMesh && BoneIndex != INDEX_NONE) ? ParentMesh->GetBoneName(BoneIndex) : NAME_None;
+
+	AttachStuck(Parent, BoneName, EAttachLocation::KeepWorldPosition);
+	StuckActor = HitActor;
+
+	if (Role == ROLE_Authority && HitActor)
 	{
-		ClientStick(MyComp, OtherComp, bSelfMoved, Hit);
+		StuckInfo.AttachActor = HitActor;
+		// components created at runtime can't be referenced by clients, they fall back to mesh or root
+		StuckInfo.AttachComponent = (Parent && Parent->IsNameStableForNetworking()) ? Parent : NULL;
+		StuckInfo.BoneIndex = (BoneName != NAME_None) ? BoneIndex : INDEX_NONE;
+		StuckInfo.RelativeLocation = CollisionComp->RelativeLocation;
+		StuckInfo.RelativeRotation = CollisionComp->RelativeRotation;
+
+		// attachment is replicated through StuckInfo from now on
+		bReplicateMovement = false;
 	}
+}
 
+void AShooterProjectile::AttachStuck(USceneComponent* Parent, FName BoneName, EAttachLocation::Type AttachType)
+{
 	bStuck = true;
 	StuckTime = GetWorld()->GetTimeSeconds();
 	MovementComp->StopMovementImmediately();
 	MovementComp->bShouldBounce = 0;
 	MovementComp->ProjectileGravityScale = 0;
-	MyComp->AttachTo(OtherComp, Hit.BoneName, EAttachLocation::KeepWorldPosition);
 
-	StuckActor = Hit.GetActor();
+	if (Parent)
+	{
+		CollisionComp->AttachTo(Parent, BoneName, AttachType);
+	}
+}
+
+USceneComponent* AShooterProjectile::GetStuckParent(AActor* Actor, USceneComponent* HitComponent, int32 BoneIndex) const
+{
+	if (HitComponent && HitComponent->GetOwner() == Actor)
+	{
+		return HitComponent;
+	}
+
+	if (BoneIndex != INDEX_NONE)
+	{
+		ACharacter* HitCharacter = Cast<ACharacter>(Actor);
+		USkeletalMeshComponent* Mesh = HitCharacter ? HitCharacter->GetMesh() : Actor->FindComponentByClass<USkeletalMeshComponent>();
+		if (Mesh)
+		{
+			return Mesh;
+		}
+	}
+
+	return Actor->GetRootComponent();
+}
+
+void AShooterProjectile::OnRep_StuckInfo()
+{
+	AActor* AttachActor = StuckInfo.AttachActor;
+	if (AttachActor == NULL)
+	{
+		// not mapped yet, called again once the actor replicates
+		return;
+	}
+
+	USceneComponent* Parent = GetStuckParent(AttachActor, StuckInfo.AttachComponent, StuckInfo.BoneIndex);
+	USkeletalMeshComponent* ParentMesh = Cast<USkeletalMeshComponent>(Parent);
+	const FName BoneName = (ParentMesh && StuckInfo.BoneIndex != INDEX_NONE) ? ParentMesh->GetBoneName(StuckInfo.BoneIndex) : NAME_None;
+
+	// replaces locally predicted attachment, if any
+	AttachStuck(Parent, BoneName, EAttachLocation::SnapToTarget);
+	CollisionComp->SetRelativeLocationAndRotation(StuckInfo.RelativeLocation, StuckInfo.RelativeRotation);
+	StuckActor = AttachActor;
+}
+
+bool FShooterStuckInfo::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	UObject* AttachObject = AttachActor;
+	Ar << AttachObject;
+	if (Ar.IsLoading())
+	{
+		AttachActor = Cast<AActor>(AttachObject);
+	}
+
+	UObject* AttachComponentObject = AttachComponent;
+	Ar << AttachComponentObject;
+	if (Ar.IsLoading())
+	{
+		AttachComponent = Cast<USceneComponent>(AttachComponentObject);
+	}
+
+	// shifted so INDEX_NONE packs to a single byte
+	uint32 PackedBoneIndex = (uint32)(BoneIndex + 1);
+	Ar.SerializeIntPacked(PackedBoneIndex);
+	BoneIndex = (int32)PackedBoneIndex - 1;
+
+	bOutSuccess = SerializePackedVector<10, 24>(RelativeLocation, Ar);
+	RelativeRotation.SerializeCompressedShort(Ar);
+
+	return true;
 }
 
-//Use OnRep_Exploded() code to recreate OnRep_Stuck(). Use the code in that function to attach the projectile to the pawn mesh
 void AShooterProjectile::ReceiveHit(UPrimitiveComponent * MyComp, AActor * Other, UPrimitiveComponent * OtherComp,
 	bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult & Hit)
 {
@@ -153,17 +245,6 @@ void AShooterProjectile::ReceiveHit(UPrimitiveComponent * MyComp, AActor * Other
 }
 
 
-void AShooterProjectile::ClientStick_Implementation(UPrimitiveComponent * MyComp, UPrimitiveComponent * OtherComp, bool bSelfMoved, FHitResult const & Hit)
-{
-	//Replicate sticky grenade effects	
-	bStuck = true;
-	MovementComp->StopMovementImmediately();
-	MovementComp->bShouldBounce = 0;
-	MovementComp->ProjectileGravityScale = 0;
-	MyComp->AttachTo(OtherComp, Hit.BoneName, EAttachLocation::KeepWorldPosition);
-}
-
-
 bool AShooterProjectile::IsStuck()
 {
 	return WeaponConfig.bSticky && bStuck;
@@ -180,6 +261,7 @@ void AShooterProjectile::TriggerOnImpact()
 
 		FHitResult Impact;
 
+		SHOOTER_INC_COUNTER(Traces);
 		if (!GetWorld()->LineTraceSingle(Impact, StartTrace, EndTrace, COLLISION_PROJECTILE, FCollisionQueryParams(TEXT("ProjClient"), true, Instigator)))
 		{
 			// failsafe
@@ -208,6 +290,8 @@ bool AShooterProjectile::ServerTriggerOnImpact_Validate()
 //John
 void AShooterProjectile::Tick(float DeltaSeconds)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(ProjectileTick);
+
 	Super::Tick(DeltaSeconds);
 	float CurrentTime = GetWorld()->GetTimeSeconds();
 
@@ -249,6 +333,8 @@ void AShooterProjectile::OnImpact(const FHitResult& HitResult)
 
 void AShooterProjectile::Explode(const FHitResult& Impact)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(ProjectileExplode);
+
 	if (ParticleComp)
 	{
 		ParticleComp->Deactivate();
@@ -338,6 +424,7 @@ void AShooterProjectile::OnRep_Exploded()
 	const FVector EndTrace = GetActorLocation() + ProjDirection * 150;
 	FHitResult Impact;
 	
+	SHOOTER_INC_COUNTER(Traces);
 	if (!GetWorld()->LineTraceSingle(Impact, StartTrace, EndTrace, COLLISION_PROJECTILE, FCollisionQueryParams(TEXT("ProjClient"), true, Instigator)))
 	{
 		// failsafe
@@ -357,10 +444,25 @@ void AShooterProjectile::PostNetReceiveVelocity(const FVector& NewVelocity)
 	}
 }
 
+void AShooterProjectile::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	FShooterNetProfiler::Get().TrackReplicatedProperties(this);
+}
+
+bool AShooterProjectile::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	SHOOTER_NET_PROFILE_RPC(this, Function);
+	SHOOTER_INC_COUNTER(RPCsSent);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
 void AShooterProjectile::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
 {
 	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
 	
 	DOREPLIFETIME( AShooterProjectile, bExploded );
+	DOREPLIFETIME( AShooterProjectile, StuckInfo );
 
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "Online/ShooterNetProfiler.h"
+#include "ShooterStats.h"
+#include "ShooterPreloadManifest.h"
 
 AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -35,6 +38,7 @@ AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Su
 	bWantsToFire = false;
 	bPendingReload = false;
 	bPendingEquip = false;
+	bServerLean = false;
 	CurrentState = EWeaponState::Idle;
 
 	CurrentAmmo = 0;
@@ -64,27 +68,27 @@ AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Su
 	bNetUseOwnerRelevancy = true;
 }
 
+void AShooterWeapon::PostLoad()
+{
+	Super::PostLoad();
+
+	FShooterPreloadManifest::MigrateClass(WeaponPickup_DEPRECATED, WeaponPickupAsset);
+}
+
 void AShooterWeapon::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	if (WeaponConfig.InitialClips > 0)
+	bServerLean = AShooterCharacter::IsServerLean(this);
+	if (bServerLean)
 	{
-		CurrentAmmoInClip = WeaponConfig.AmmoPerClip;
-
-
-		//John
-		if (WeaponConfig.bNeedsReload)
-		{
-			CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
-		}
-		else
-		{
-			CurrentAmmo = CurrentAmmoInClip;
-			WeaponConfig.MaxAmmo = WeaponConfig.AmmoPerClip;
-		}
+		// only the owning client sees the first person mesh. The 3rd person one keeps its collision
+		Mesh1P->SetComponentTickEnabled(false);
+		Mesh1P->bNoSkeletonUpdate = true;
 	}
 
+	InitAmmo();
+
 	//John
 	//Had to post initialize this attribute
 	//When I set BurstDuration in the object initializer, the program instead 
@@ -111,6 +115,66 @@ void AShooterWeapon::Destroyed()
 	StopSimulatingWeaponFire();
 }
 
+void AShooterWeapon::InitAmmo()
+{
+	if (WeaponConfig.InitialClips > 0)
+	{
+		CurrentAmmoInClip = WeaponConfig.AmmoPerClip;
+
+
+		//John
+		if (WeaponConfig.bNeedsReload)
+		{
+			CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
+		}
+		else
+		{
+			CurrentAmmo = CurrentAmmoInClip;
+			WeaponConfig.MaxAmmo = WeaponConfig.AmmoPerClip;
+		}
+	}
+}
+
+void AShooterWeapon::OnReturnedToPool()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	StopSimulatingWeaponFire();
+
+	bWantsToFire = false;
+	bRefiring = false;
+	bPendingReload = false;
+	bPendingEquip = false;
+	bPendingShot = false;
+	bPlayingFireAnim = false;
+	bQuickFiring = false;
+	bBursting = false;
+	bPendingBurst = false;
+	bPendingPause = false;
+	bBurstPausing = false;
+	BurstCounter = 0;
+	LastFireTime = 0.0f;
+	LastBurstTime = 0.0f;
+	BurstStartTime = 0.0f;
+	bIsEquipped = WeaponConfig.bAlwaysEquipped;
+	CurrentState = EWeaponState::Idle;
+
+	DetachMeshFromPawn();
+
+	// dormant weapons have their actor channels closed once clients have the latest state, so nothing is
+	// sent or compared for them. Clients keep the actor with that state. Waking the weapon reopens a
+	// channel to every relevant client and sends a full initial bunch, like a newly spawned actor.
+	SetActorTickEnabled(false);
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AShooterWeapon::OnTakenFromPool()
+{
+	SetNetDormancy(DORM_Awake);
+	SetActorTickEnabled(true);
+
+	InitAmmo();
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Inventory
 
@@ -1009,6 +1073,8 @@ void AShooterWeapon::HandleShot()
 
 void AShooterWeapon::HandleFiring()
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(WeaponHandleFiring);
+
 	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire())
 	{
 		if (GetNetMode() != NM_DedicatedServer)
@@ -1281,7 +1347,7 @@ void AShooterWeapon::OnBurstFinished()
 UAudioComponent* AShooterWeapon::PlayWeaponSound(USoundCue* Sound)
 {
 	UAudioComponent* AC = NULL;
-	if (Sound && MyPawn)
+	if (Sound && MyPawn && !bServerLean)
 	{
 		AC = UGameplayStatics::PlaySoundAttached(Sound, MyPawn->GetRootComponent());
 	}
@@ -1295,7 +1361,12 @@ float AShooterWeapon::PlayWeaponAnimation(const FWeaponAnim& Animation)
 	if (MyPawn)
 	{
 		UAnimMontage* UseAnim = MyPawn->IsFirstPerson() ? Animation.Pawn1P : Animation.Pawn3P;
-		if (UseAnim)
+		if (UseAnim && bServerLean)
+		{
+			// nobody sees it, but equip and reload are timed by its length
+			Duration = UseAnim->SequenceLength / FMath::Max(UseAnim->RateScale, KINDA_SMALL_NUMBER);
+		}
+		else if (UseAnim)
 		{
 			Duration = MyPawn->PlayAnimMontage(UseAnim);
 		}
@@ -1306,7 +1377,7 @@ float AShooterWeapon::PlayWeaponAnimation(const FWeaponAnim& Animation)
 
 void AShooterWeapon::StopWeaponAnimation(const FWeaponAnim& Animation)
 {
-	if (MyPawn)
+	if (MyPawn && !bServerLean)
 	{
 		UAnimMontage* UseAnim = MyPawn->IsFirstPerson() ? Animation.Pawn1P : Animation.Pawn3P;
 		if (UseAnim)
@@ -1428,6 +1499,7 @@ FHitResult AShooterWeapon::WeaponTrace(const FVector& StartTrace, const FVector&
 	{
 		GetWorld()->LineTraceSingle(Hit, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams);
 	}
+	SHOOTER_INC_COUNTER(Traces);
 
 	return Hit;
 }
@@ -1518,7 +1590,7 @@ void AShooterWeapon::OnRep_Reload()
 
 void AShooterWeapon::SimulateWeaponFire()
 {
-	if (Role == ROLE_Authority && CurrentState != EWeaponState::Firing)
+	if ((Role == ROLE_Authority && CurrentState != EWeaponState::Firing) || bServerLean)
 	{
 		return;
 	}
@@ -1630,6 +1702,20 @@ void AShooterWeapon::StopSimulatingWeaponFire()
 	}
 }
 
+void AShooterWeapon::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	FShooterNetProfiler::Get().TrackReplicatedProperties(this);
+}
+
+bool AShooterWeapon::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	SHOOTER_NET_PROFILE_RPC(this, Function);
+	SHOOTER_INC_COUNTER(RPCsSent);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
 void AShooterWeapon::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -1709,3 +1795,8 @@ float AShooterWeapon::GetEquipDuration() const
 {
 	return EquipDuration;
 }
+
+UClass* AShooterWeapon::GetWeaponPickupClass() const
+{
+	return FShooterPreloadManifest::ResolveClass(WeaponPickupAsset);
+}
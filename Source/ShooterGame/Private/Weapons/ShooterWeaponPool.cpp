@@ -0,0 +1,144 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeaponPool.h"
+
+int32 GShooterWeaponPoolMaxPerClass = 16;
+static FAutoConsoleVariableRef CVarShooterWeaponPoolMaxPerClass(
+	TEXT("shooter.WeaponPoolMaxPerClass"),
+	GShooterWeaponPoolMaxPerClass,
+	TEXT("Maximum number of parked weapons kept for reuse per weapon class, more are destroyed.\n")
+	TEXT("0 disables weapon pooling.\n")
+	TEXT("Default is 16."),
+	ECVF_Default
+	);
+
+static void ShooterWeaponPoolStats(UWorld* World)
+{
+	AShooterGameMode* const GameMode = World ? World->GetAuthGameMode<AShooterGameMode>() : NULL;
+	if (GameMode && GameMode->GetWeaponPool())
+	{
+		GameMode->GetWeaponPool()->DumpStats();
+	}
+	else
+	{
+		UE_LOG(LogShooterWeapon, Log, TEXT("No weapon pool, weapons are pooled on the server only"));
+	}
+}
+
+static FAutoConsoleCommandWithWorld CmdShooterWeaponPoolStats(
+	TEXT("shooter.WeaponPoolStats"),
+	TEXT("Log spawned, reused and parked weapons per weapon class."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(ShooterWeaponPoolStats)
+	);
+
+FShooterWeaponPool::~FShooterWeaponPool()
+{
+	if (Pools.Num() > 0)
+	{
+		DumpStats();
+	}
+}
+
+AShooterWeapon* FShooterWeaponPool::Acquire(UWorld* World, TSubclassOf<AShooterWeapon> WeaponClass)
+{
+	if (WeaponClass == NULL)
+	{
+		return NULL;
+	}
+
+	FClassPool& Pool = Pools.FindOrAdd(*WeaponClass);
+	while (Pool.Parked.Num() > 0)
+	{
+		AShooterWeapon* Weapon = Pool.Parked.Pop().Get();
+		if (Weapon && !Weapon->IsPendingKill())
+		{
+			Weapon->OnTakenFromPool();
+			Pool.NumReused++;
+			return Weapon;
+		}
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.bNoCollisionFail = true;
+	AShooterWeapon* Weapon = World->SpawnActor<AShooterWeapon>(WeaponClass, SpawnInfo);
+	if (Weapon)
+	{
+		Pool.NumSpawned++;
+	}
+	return Weapon;
+}
+
+void FShooterWeaponPool::Release(AShooterWeapon* Weapon)
+{
+	if (Weapon == NULL || Weapon->IsPendingKill())
+	{
+		return;
+	}
+
+	FClassPool& Pool = Pools.FindOrAdd(Weapon->GetClass());
+	if (Pool.Parked.Contains(Weapon))
+	{
+		return;
+	}
+
+	Pool.NumReleased++;
+	if (Pool.Parked.Num() >= GShooterWeaponPoolMaxPerClass)
+	{
+		Pool.NumDestroyed++;
+		Weapon->Destroy();
+		return;
+	}
+
+	Weapon->OnReturnedToPool();
+	Pool.Parked.Add(Weapon);
+}
+
+void FShooterWeaponPool::DumpStats() const
+{
+	int32 TotalSpawned = 0;
+	int32 TotalReused = 0;
+	for (TMap<UClass*, FClassPool>::TConstIterator It(Pools); It; ++It)
+	{
+		const FClassPool& Pool = It.Value();
+		UE_LOG(LogShooterWeapon, Log, TEXT("Weapon pool %s: %d parked, %d spawned, %d reused, %d released, %d destroyed over cap"),
+			*GetNameSafe(It.Key()), Pool.Parked.Num(), Pool.NumSpawned, Pool.NumReused, Pool.NumReleased, Pool.NumDestroyed);
+
+		TotalSpawned += Pool.NumSpawned;
+		TotalReused += Pool.NumReused;
+	}
+
+	UE_LOG(LogShooterWeapon, Log, TEXT("Weapon pool: %d weapons handed out, %d of them reused"), TotalSpawned + TotalReused, TotalReused);
+}
+
+AShooterWeapon* FShooterWeaponPool::SpawnWeapon(UWorld* World, TSubclassOf<AShooterWeapon> WeaponClass)
+{
+	AShooterGameMode* const GameMode = World->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode && GameMode->GetWeaponPool())
+	{
+		return GameMode->GetWeaponPool()->Acquire(World, WeaponClass);
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.bNoCollisionFail = true;
+	return World->SpawnActor<AShooterWeapon>(WeaponClass, SpawnInfo);
+}
+
+void FShooterWeaponPool::ReleaseWeapon(AShooterWeapon* Weapon)
+{
+	if (Weapon == NULL)
+	{
+		return;
+	}
+
+	UWorld* const World = Weapon->GetWorld();
+	AShooterGameMode* const GameMode = World ? World->GetAuthGameMode<AShooterGameMode>() : NULL;
+	if (GameMode && GameMode->GetWeaponPool() && !World->bIsTearingDown)
+	{
+		GameMode->GetWeaponPool()->Release(Weapon);
+	}
+	else
+	{
+		Weapon->Destroy();
+	}
+}
@@ -0,0 +1,56 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * [server] Weapons of one world, keyed by weapon class.
+ * Weapons of dead pawns and discarded pickups are parked here instead of destroyed and handed out
+ * again on respawn, so a match doesn't spawn and garbage collect every weapon a pawn carries.
+ * Parked weapons are dormant and don't tick.
+ */
+class FShooterWeaponPool
+{
+public:
+
+	~FShooterWeaponPool();
+
+	/** get a weapon of class, reused from the pool if one is parked */
+	AShooterWeapon* Acquire(UWorld* World, TSubclassOf<AShooterWeapon> WeaponClass);
+
+	/** park weapon for reuse, weapon must have left inventory. Destroys it if the pool of its class is full */
+	void Release(AShooterWeapon* Weapon);
+
+	/** log pool statistics */
+	void DumpStats() const;
+
+	/** spawn weapon through the pool of World's game mode, or directly if there is none (clients) */
+	static AShooterWeapon* SpawnWeapon(UWorld* World, TSubclassOf<AShooterWeapon> WeaponClass);
+
+	/** return weapon to the pool of its world's game mode, or destroy it if there is none */
+	static void ReleaseWeapon(AShooterWeapon* Weapon);
+
+private:
+
+	struct FClassPool
+	{
+		/** weapons ready for reuse */
+		TArray<TWeakObjectPtr<AShooterWeapon> > Parked;
+
+		int32 NumSpawned;
+		int32 NumReused;
+		int32 NumReleased;
+
+		/** released when the pool was full */
+		int32 NumDestroyed;
+
+		FClassPool()
+			: NumSpawned(0)
+			, NumReused(0)
+			, NumReleased(0)
+			, NumDestroyed(0)
+		{
+		}
+	};
+
+	TMap<UClass*, FClassPool> Pools;
+};
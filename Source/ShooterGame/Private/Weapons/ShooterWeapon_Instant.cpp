@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "ShooterStats.h"
 
 AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -13,6 +14,8 @@ AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectI
 
 void AShooterWeapon_Instant::FireWeapon()
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(WeaponFire);
+
 	const int32 RandomSeed = FMath::Rand();
 	FRandomStream WeaponRandomStream(RandomSeed);
 	const float CurrentSpread = GetCurrentSpread();
@@ -36,6 +39,8 @@ bool AShooterWeapon_Instant::ServerNotifyHit_Validate(const FHitResult Impact, F
 
 void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(WeaponServerNotifyHit);
+
 	const float WeaponAngleDot = FMath::Abs(FMath::Sin(ReticleSpread * PI / 180.f));
 
 	// if we have an instigator, calculate dot between the view and the shot
@@ -229,6 +234,13 @@ void AShooterWeapon_Instant::DealDamage(const FHitResult& Impact, const FVector&
 	PointDmg.ShotDirection = ShootDir;
 	PointDmg.Damage = InstantConfig.HitDamage;
 
+	// headshot bonus, zone multiplier is applied by the character
+	AShooterCharacter* HitPawn = Cast<AShooterCharacter>(Impact.GetActor());
+	if (HitPawn && HitPawn->GetHitZone(Impact) == EShooterHitZone::Head)
+	{
+		PointDmg.Damage += HitPawn->ShieldsDown() ? InstantConfig.LowTargetHealthHeadshotMod : InstantConfig.HeadshotDamageMod;
+	}
+
 	Impact.GetActor()->TakeDamage(PointDmg.Damage, PointDmg, MyPawn->Controller, this);
 }
 
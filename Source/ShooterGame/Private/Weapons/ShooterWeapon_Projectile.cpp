@@ -1,6 +1,7 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterGame.h"
+#include "ShooterStats.h"
 
 AShooterWeapon_Projectile::AShooterWeapon_Projectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -11,6 +12,8 @@ AShooterWeapon_Projectile::AShooterWeapon_Projectile(const FObjectInitializer& O
 
 void AShooterWeapon_Projectile::FireWeapon()
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(WeaponFire);
+
 	FVector Origin = FVector::ZeroVector;
 	FVector ShootDir = GetAdjustedAim();
 	if (ProjectileConfig.bCameraIsOrigin)
@@ -17,6 +17,10 @@ class UBehaviorTreeComponent;
 DECLARE_LOG_CATEGORY_EXTERN(LogShooter, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogShooterWeapon, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("Shooter"), STATGROUP_Shooter, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("ShooterNet"), STATGROUP_ShooterNet, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("ShooterHUD"), STATGROUP_ShooterHUD, STATCAT_Advanced);
+
 /** when you modify this, please note that this information can be saved with instances
  * also DefaultEngine.ini [/Script/Engine.CollisionProfile] should match with this list **/
 #define COLLISION_WEAPON		ECC_GameTraceChannel1
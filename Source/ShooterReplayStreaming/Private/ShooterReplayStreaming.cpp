@@ -0,0 +1,745 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterReplayStreaming.h"
+#include "ModuleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flush Checkpoint"), STAT_ShooterReplayFlushCheckpoint, STATGROUP_ShooterReplay);
+DECLARE_CYCLE_STAT(TEXT("Stream Stall"), STAT_ShooterReplayStreamStall, STATGROUP_ShooterReplay);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Jobs In Flight"), STAT_ShooterReplayJobsInFlight, STATGROUP_ShooterReplay);
+
+DEFINE_LOG_CATEGORY_STATIC(LogShooterReplay, Log, All);
+
+static int32 GShooterDemoChunkSize = 256 * 1024;
+static FAutoConsoleVariableRef CVarShooterDemoChunkSize(
+	TEXT("shooter.DemoChunkSize"),
+	GShooterDemoChunkSize,
+	TEXT("Uncompressed size of demo chunks written by the shooter replay streamer, in bytes.\n")
+	TEXT("Smaller chunks make seeking cheaper, larger ones compress better.\n")
+	TEXT("Default is 262144."),
+	ECVF_Default
+	);
+
+const uint32 FShooterDemoFileHeader::ExpectedMagic = 0x5a4d4453;
+const uint32 FShooterDemoFileHeader::ExpectedVersion = 2;
+
+/** jobs the worker may be behind before the game thread waits: one being written, one queued */
+static const int32 MaxJobsInFlight = 2;
+
+//////////////////////////////////////////////////////////////////////////
+// FShooterDemoFileWriter
+
+FShooterDemoFileWriter::FShooterDemoFileWriter(const FString& InFileName, int32 InChunkSize)
+	: FileName(InFileName)
+	, ChunkSize(InChunkSize)
+	, Thread(NULL)
+	, bFinalizeQueued(false)
+	, File(NULL)
+	, HeaderBytes(0)
+	, StreamBytes(0)
+	, RawBytes(0)
+	, CompressedBytes(0)
+	, WorkerSeconds(0.0)
+{
+	JobEvent = FPlatformProcess::CreateSynchEvent();
+	SlotEvent = FPlatformProcess::CreateSynchEvent();
+	Thread = FRunnableThread::Create(this, TEXT("FShooterDemoFileWriter"), 0, TPri_BelowNormal);
+}
+
+FShooterDemoFileWriter::~FShooterDemoFileWriter()
+{
+	if (!bFinalizeQueued)
+	{
+		Stop();
+	}
+
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = NULL;
+	}
+
+	FJob* Job = NULL;
+	while (Jobs.Dequeue(Job))
+	{
+		delete Job;
+	}
+
+	delete File;
+	File = NULL;
+
+	delete JobEvent;
+	delete SlotEvent;
+}
+
+double FShooterDemoFileWriter::Submit(EShooterDemoChunk::Type Kind, TArray<uint8>& Data, int32 CheckpointIndex, uint32 TimeInMS, int64 StreamOffset)
+{
+	check(!bFinalizeQueued);
+
+	double WaitTime = 0.0;
+	if (NumJobsInFlight.GetValue() >= MaxJobsInFlight)
+	{
+		const double WaitStart = FPlatformTime::Seconds();
+		while (NumJobsInFlight.GetValue() >= MaxJobsInFlight && !IsDone())
+		{
+			SlotEvent->Wait(1);
+		}
+		WaitTime = FPlatformTime::Seconds() - WaitStart;
+	}
+
+	FJob* Job = new FJob();
+	Job->Kind = Kind;
+	Job->Data = MoveTemp(Data);
+	Job->CheckpointIndex = CheckpointIndex;
+	Job->TimeInMS = TimeInMS;
+	Job->StreamOffset = StreamOffset;
+	Job->bFinalize = false;
+
+	Data.Reset();
+
+	NumJobsInFlight.Increment();
+	INC_DWORD_STAT(STAT_ShooterReplayJobsInFlight);
+	Jobs.Enqueue(Job);
+	JobEvent->Trigger();
+
+	return WaitTime;
+}
+
+void FShooterDemoFileWriter::Finalize(uint32 TotalTimeInMS, int32 NumCheckpoints, double MaxCheckpointStall, double TotalStall)
+{
+	if (bFinalizeQueued)
+	{
+		return;
+	}
+
+	FJob* Job = new FJob();
+	Job->Kind = EShooterDemoChunk::Stream;
+	Job->CheckpointIndex = INDEX_NONE;
+	Job->TimeInMS = TotalTimeInMS;
+	Job->StreamOffset = 0;
+	Job->bFinalize = true;
+	Job->NumCheckpoints = NumCheckpoints;
+	Job->MaxCheckpointStall = MaxCheckpointStall;
+	Job->TotalStall = TotalStall;
+
+	bFinalizeQueued = true;
+	NumJobsInFlight.Increment();
+	INC_DWORD_STAT(STAT_ShooterReplayJobsInFlight);
+	Jobs.Enqueue(Job);
+	JobEvent->Trigger();
+}
+
+void FShooterDemoFileWriter::Stop()
+{
+	StopCounter.Increment();
+	JobEvent->Trigger();
+}
+
+uint32 FShooterDemoFileWriter::Run()
+{
+	File = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FileName);
+	if (File == NULL)
+	{
+		UE_LOG(LogShooterReplay, Warning, TEXT("Failed to open demo %s for writing"), *FileName);
+	}
+	else
+	{
+		// placeholder, patched when the table is written
+		FShooterDemoFileHeader Header;
+		TArray<uint8> HeaderData;
+		FMemoryWriter HeaderAr(HeaderData);
+		HeaderAr << Header;
+		File->Write(HeaderData.GetData(), HeaderData.Num());
+	}
+
+	for (;;)
+	{
+		FJob* Job = NULL;
+		if (!Jobs.Dequeue(Job))
+		{
+			if (StopCounter.GetValue() != 0)
+			{
+				break;
+			}
+
+			JobEvent->Wait();
+			continue;
+		}
+
+		const bool bFinalize = Job->bFinalize;
+		if (File)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			if (bFinalize)
+			{
+				WriteTable(Job->TimeInMS);
+			}
+			else
+			{
+				Process(*Job);
+			}
+			WorkerSeconds += FPlatformTime::Seconds() - StartTime;
+
+			if (bFinalize)
+			{
+				LogStats(*Job);
+			}
+		}
+
+		delete Job;
+		NumJobsInFlight.Decrement();
+		DEC_DWORD_STAT(STAT_ShooterReplayJobsInFlight);
+		SlotEvent->Trigger();
+
+		if (bFinalize)
+		{
+			break;
+		}
+	}
+
+	delete File;
+	File = NULL;
+
+	DoneCounter.Increment();
+	SlotEvent->Trigger();
+	return 0;
+}
+
+void FShooterDemoFileWriter::Process(FJob& Job)
+{
+	int64& DataOffset = (Job.Kind == EShooterDemoChunk::Header) ? HeaderBytes : StreamBytes;
+
+	for (int32 Start = 0; Start < Job.Data.Num(); Start += ChunkSize)
+	{
+		const int32 UncompressedSize = FMath::Min(ChunkSize, Job.Data.Num() - Start);
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_ZLIB, UncompressedSize);
+		CompressedBuffer.SetNumUninitialized(CompressedSize);
+		const uint8* ChunkData = CompressedBuffer.GetData();
+		if (!FCompression::CompressMemory(COMPRESS_ZLIB, CompressedBuffer.GetData(), CompressedSize, Job.Data.GetData() + Start, UncompressedSize)
+			|| CompressedSize >= UncompressedSize)
+		{
+			// store as is, dropping the chunk would leave a gap in the stream offsets
+			ChunkData = Job.Data.GetData() + Start;
+			CompressedSize = UncompressedSize;
+		}
+
+		FShooterDemoChunk& Chunk = Table[Table.AddDefaulted()];
+		Chunk.Kind = Job.Kind;
+		Chunk.FileOffset = File->Tell();
+		Chunk.UncompressedSize = UncompressedSize;
+		Chunk.CompressedSize = CompressedSize;
+
+		if (Job.Kind == EShooterDemoChunk::Checkpoint)
+		{
+			Chunk.CheckpointIndex = Job.CheckpointIndex;
+			Chunk.TimeInMS = Job.TimeInMS;
+			Chunk.DataOffset = Job.StreamOffset;
+		}
+		else
+		{
+			Chunk.DataOffset = DataOffset;
+			DataOffset += UncompressedSize;
+		}
+
+		File->Write(ChunkData, CompressedSize);
+
+		RawBytes += UncompressedSize;
+		CompressedBytes += CompressedSize;
+	}
+}
+
+void FShooterDemoFileWriter::WriteTable(uint32 TotalTimeInMS)
+{
+	FShooterDemoFileHeader Header;
+	Header.Magic = FShooterDemoFileHeader::ExpectedMagic;
+	Header.Version = FShooterDemoFileHeader::ExpectedVersion;
+	Header.ChunkSize = ChunkSize;
+	Header.TotalTimeInMS = TotalTimeInMS;
+	Header.TableOffset = File->Tell();
+	Header.NumChunks = Table.Num();
+
+	TArray<uint8> TableData;
+	FMemoryWriter TableAr(TableData);
+	for (int32 i = 0; i < Table.Num(); i++)
+	{
+		TableAr << Table[i];
+	}
+	File->Write(TableData.GetData(), TableData.Num());
+
+	TArray<uint8> HeaderData;
+	FMemoryWriter HeaderAr(HeaderData);
+	HeaderAr << Header;
+	File->Seek(0);
+	File->Write(HeaderData.GetData(), HeaderData.Num());
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FShooterDemoStreamWriter
+
+FShooterDemoStreamWriter::FShooterDemoStreamWriter(FShooterReplayStreamer& InStreamer, int32 InChunkSize)
+	: Streamer(InStreamer)
+	, ChunkSize(InChunkSize)
+	, Position(0)
+{
+	ArIsSaving = true;
+	Buffer.Reserve(ChunkSize);
+}
+
+void FShooterDemoStreamWriter::Serialize(void* Data, int64 Num)
+{
+	const uint8* Src = (const uint8*)Data;
+	while (Num > 0)
+	{
+		const int64 Count = FMath::Min<int64>(Num, ChunkSize - Buffer.Num());
+		Buffer.Append(Src, Count);
+		Src += Count;
+		Num -= Count;
+		Position += Count;
+
+		if (Buffer.Num() >= ChunkSize)
+		{
+			Streamer.SubmitStream(Buffer);
+			Buffer.Reserve(ChunkSize);
+		}
+	}
+}
+
+void FShooterDemoStreamWriter::Flush()
+{
+	if (Buffer.Num() > 0)
+	{
+		Streamer.SubmitStream(Buffer);
+		Buffer.Reserve(ChunkSize);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FShooterDemoStreamReader
+
+FShooterDemoStreamReader::FShooterDemoStreamReader(IFileHandle* InFile, const TArray<FShooterDemoChunk>& InChunks, int64 InTotalSize)
+	: File(InFile)
+	, Chunks(InChunks)
+	, StreamSize(InTotalSize)
+	, Position(0)
+	, CurrentChunk(INDEX_NONE)
+{
+	ArIsLoading = true;
+}
+
+bool FShooterDemoStreamReader::ReadChunk(IFileHandle* File, const FShooterDemoChunk& Chunk, TArray<uint8>& OutData)
+{
+	if (Chunk.IsStored())
+	{
+		OutData.SetNumUninitialized(Chunk.UncompressedSize);
+		return File->Seek(Chunk.FileOffset) && File->Read(OutData.GetData(), Chunk.UncompressedSize);
+	}
+
+	TArray<uint8> CompressedData;
+	CompressedData.SetNumUninitialized(Chunk.CompressedSize);
+	OutData.SetNumUninitialized(Chunk.UncompressedSize);
+
+	return File->Seek(Chunk.FileOffset)
+		&& File->Read(CompressedData.GetData(), Chunk.CompressedSize)
+		&& FCompression::UncompressMemory(COMPRESS_ZLIB, OutData.GetData(), Chunk.UncompressedSize, CompressedData.GetData(), Chunk.CompressedSize);
+}
+
+bool FShooterDemoStreamReader::LoadChunkAt(int64 Pos)
+{
+	if (Chunks.IsValidIndex(CurrentChunk) && Pos >= Chunks[CurrentChunk].DataOffset && Pos < Chunks[CurrentChunk].DataOffset + Chunks[CurrentChunk].UncompressedSize)
+	{
+		return true;
+	}
+
+	// last chunk starting at or before Pos
+	int32 Min = 0;
+	int32 Max = Chunks.Num();
+	while (Min < Max)
+	{
+		const int32 Mid = (Min + Max) / 2;
+		if (Chunks[Mid].DataOffset <= Pos)
+		{
+			Min = Mid + 1;
+		}
+		else
+		{
+			Max = Mid;
+		}
+	}
+
+	CurrentChunk = Min - 1;
+	if (!Chunks.IsValidIndex(CurrentChunk) || !ReadChunk(File, Chunks[CurrentChunk], ChunkData))
+	{
+		CurrentChunk = INDEX_NONE;
+		return false;
+	}
+
+	return true;
+}
+
+void FShooterDemoStreamReader::Serialize(void* Data, int64 Num)
+{
+	uint8* Dest = (uint8*)Data;
+	while (Num > 0)
+	{
+		if (Position >= StreamSize || !LoadChunkAt(Position))
+		{
+			ArIsError = true;
+			return;
+		}
+
+		const FShooterDemoChunk& Chunk = Chunks[CurrentChunk];
+		const int64 ChunkPos = Position - Chunk.DataOffset;
+		const int64 Count = FMath::Min<int64>(Num, Chunk.UncompressedSize - ChunkPos);
+		if (Count <= 0)
+		{
+			// Position falls between chunks, the file is damaged
+			ArIsError = true;
+			return;
+		}
+
+		FMemory::Memcpy(Dest, ChunkData.GetData() + ChunkPos, Count);
+		Dest += Count;
+		Num -= Count;
+		Position += Count;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FShooterReplayStreamer
+
+FShooterReplayStreamer::FShooterReplayStreamer()
+	: bHeaderSubmitted(false)
+	, NumCheckpoints(0)
+	, MaxCheckpointStall(0.0)
+	, TotalStall(0.0)
+	, ReadFile(NULL)
+	, TotalTimeInMS(0)
+	, bRecording(false)
+{
+}
+
+FShooterReplayStreamer::~FShooterReplayStreamer()
+{
+	StopStreaming();
+
+	// waits for the worker to finish writing
+	Writer.Reset();
+}
+
+FString FShooterReplayStreamer::GetDemoFileName(const FString& StreamName)
+{
+	return FPaths::GameSavedDir() + TEXT("Demos/") + StreamName + TEXT(".demo");
+}
+
+void FShooterReplayStreamer::StartStreaming(const FString& InStreamName, bool bRecord, const FString& VersionString, const FOnStreamReadyDelegate& Delegate)
+{
+	StopStreaming();
+	Writer.Reset();
+
+	StreamName = InStreamName;
+	bRecording = bRecord;
+	TotalTimeInMS = 0;
+
+	const FString FileName = GetDemoFileName(StreamName);
+	bool bSuccess = true;
+
+	if (bRecord)
+	{
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(FileName), true);
+
+		const int32 ChunkSize = FMath::Max(GShooterDemoChunkSize, 4096);
+		Writer = MakeShareable(new FShooterDemoFileWriter(FileName, ChunkSize));
+		StreamWriter = MakeShareable(new FShooterDemoStreamWriter(*this, ChunkSize));
+
+		HeaderWriter.Empty();
+		HeaderWriter.Seek(0);
+		CheckpointWriter.Empty();
+		CheckpointWriter.Seek(0);
+		bHeaderSubmitted = false;
+		NumCheckpoints = 0;
+		MaxCheckpointStall = 0.0;
+		TotalStall = 0.0;
+	}
+	else
+	{
+		bSuccess = OpenForPlayback(FileName);
+	}
+
+	Delegate.ExecuteIfBound(bSuccess);
+}
+
+bool FShooterReplayStreamer::OpenForPlayback(const FString& FileName)
+{
+	// only kept in ReadFile once the demo is known to be readable
+	IFileHandle* File = FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FileName);
+	if (File == NULL)
+	{
+		return false;
+	}
+
+	TArray<uint8> HeaderData;
+	HeaderData.SetNumUninitialized(FShooterDemoFileHeader::SerializedSize);
+	FShooterDemoFileHeader Header;
+	if (File->Read(HeaderData.GetData(), HeaderData.Num()))
+	{
+		FMemoryReader HeaderAr(HeaderData);
+		HeaderAr << Header;
+	}
+
+	const int64 FileSize = File->Size();
+	if (Header.Magic != FShooterDemoFileHeader::ExpectedMagic || Header.Version != FShooterDemoFileHeader::ExpectedVersion ||
+		Header.TableOffset <= 0 || Header.TableOffset > FileSize || Header.NumChunks < 0)
+	{
+		UE_LOG(LogShooterReplay, Warning, TEXT("%s is not a finished shooter demo"), *FileName);
+		delete File;
+		return false;
+	}
+
+	TArray<uint8> TableData;
+	TableData.SetNumUninitialized(FileSize - Header.TableOffset);
+	if (!File->Seek(Header.TableOffset) || !File->Read(TableData.GetData(), TableData.Num()))
+	{
+		UE_LOG(LogShooterReplay, Warning, TEXT("Failed to read chunk table of %s"), *FileName);
+		delete File;
+		return false;
+	}
+
+	FMemoryReader TableAr(TableData);
+	TArray<FShooterDemoChunk> StreamChunks;
+	int64 StreamSize = 0;
+
+	HeaderReader.Empty();
+	CheckpointChunks.Reset();
+
+	for (int32 i = 0; i < Header.NumChunks && !TableAr.IsError(); i++)
+	{
+		FShooterDemoChunk Chunk;
+		TableAr << Chunk;
+
+		if (Chunk.Kind == EShooterDemoChunk::Header)
+		{
+			TArray<uint8> ChunkData;
+			if (FShooterDemoStreamReader::ReadChunk(File, Chunk, ChunkData))
+			{
+				HeaderReader.Append(ChunkData);
+			}
+		}
+		else if (Chunk.Kind == EShooterDemoChunk::Checkpoint)
+		{
+			CheckpointChunks.Add(Chunk);
+		}
+		else
+		{
+			StreamChunks.Add(Chunk);
+			StreamSize = FMath::Max(StreamSize, Chunk.DataOffset + Chunk.UncompressedSize);
+		}
+	}
+
+	if (TableAr.IsError())
+	{
+		UE_LOG(LogShooterReplay, Warning, TEXT("Chunk table of %s is truncated"), *FileName);
+		HeaderReader.Empty();
+		CheckpointChunks.Reset();
+		delete File;
+		return false;
+	}
+
+	HeaderReader.Seek(0);
+
+	// chunks are in the order the worker wrote them, which is the order they were submitted in
+	ReadFile = File;
+	StreamReader = MakeShareable(new FShooterDemoStreamReader(ReadFile, StreamChunks, StreamSize));
+	TotalTimeInMS = Header.TotalTimeInMS;
+	return true;
+}
+
+void FShooterReplayStreamer::StopStreaming()
+{
+	if (bRecording && Writer.IsValid())
+	{
+		StreamWriter->Flush();
+		if (!bHeaderSubmitted && HeaderWriter.Num() > 0)
+		{
+			bHeaderSubmitted = true;
+			Writer->Submit(EShooterDemoChunk::Header, HeaderWriter);
+		}
+
+		// table is written in the background, Writer is kept around until it's done
+		Writer->Finalize(TotalTimeInMS, NumCheckpoints, MaxCheckpointStall, TotalStall);
+	}
+
+	StreamWriter.Reset();
+	StreamReader.Reset();
+	HeaderReader.Empty();
+	CheckpointReader.Empty();
+	CheckpointChunks.Reset();
+
+	delete ReadFile;
+	ReadFile = NULL;
+
+	bRecording = false;
+}
+
+FArchive* FShooterReplayStreamer::GetHeaderArchive()
+{
+	return bRecording ? (FArchive*)&HeaderWriter : (FArchive*)&HeaderReader;
+}
+
+FArchive* FShooterReplayStreamer::GetStreamingArchive()
+{
+	return bRecording ? (FArchive*)StreamWriter.Get() : (FArchive*)StreamReader.Get();
+}
+
+FArchive* FShooterReplayStreamer::GetCheckpointArchive()
+{
+	return bRecording ? (FArchive*)&CheckpointWriter : (FArchive*)&CheckpointReader;
+}
+
+void FShooterReplayStreamer::SubmitStream(TArray<uint8>& Data)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterReplayStreamStall);
+
+	// playback needs the header before any stream data
+	if (!bHeaderSubmitted)
+	{
+		bHeaderSubmitted = true;
+		TotalStall += Writer->Submit(EShooterDemoChunk::Header, HeaderWriter);
+	}
+
+	TotalStall += Writer->Submit(EShooterDemoChunk::Stream, Data);
+}
+
+void FShooterReplayStreamer::FlushCheckpoint(const uint32 TimeInMS)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterReplayFlushCheckpoint);
+
+	if (!bRecording || !Writer.IsValid())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// stream up to the checkpoint has to be readable before the checkpoint itself
+	StreamWriter->Flush();
+
+	Writer->Submit(EShooterDemoChunk::Checkpoint, CheckpointWriter, NumCheckpoints++, TimeInMS, StreamWriter->Tell());
+	CheckpointWriter.Seek(0);
+
+	const double Stall = FPlatformTime::Seconds() - StartTime;
+	MaxCheckpointStall = FMath::Max(MaxCheckpointStall, Stall);
+	TotalStall += Stall;
+}
+
+void FShooterReplayStreamer::GotoCheckpointIndex(const int32 CheckpointIndex, const FOnCheckpointReadyDelegate& Delegate)
+{
+	if (bRecording || !StreamReader.IsValid())
+	{
+		Delegate.ExecuteIfBound(false);
+		return;
+	}
+
+	CheckpointReader.Empty();
+	CheckpointReader.Seek(0);
+
+	if (CheckpointIndex == INDEX_NONE)
+	{
+		// empty checkpoint, playback starts over
+		StreamReader->Seek(0);
+		Delegate.ExecuteIfBound(true);
+		return;
+	}
+
+	int64 StreamOffset = -1;
+	for (int32 i = 0; i < CheckpointChunks.Num(); i++)
+	{
+		const FShooterDemoChunk& Chunk = CheckpointChunks[i];
+		if (Chunk.CheckpointIndex == CheckpointIndex)
+		{
+			TArray<uint8> ChunkData;
+			if (!FShooterDemoStreamReader::ReadChunk(ReadFile, Chunk, ChunkData))
+			{
+				Delegate.ExecuteIfBound(false);
+				return;
+			}
+
+			CheckpointReader.Append(ChunkData);
+			StreamOffset = Chunk.DataOffset;
+		}
+	}
+
+	if (StreamOffset < 0)
+	{
+		Delegate.ExecuteIfBound(false);
+		return;
+	}
+
+	StreamReader->Seek(StreamOffset);
+	Delegate.ExecuteIfBound(true);
+}
+
+void FShooterReplayStreamer::GotoTimeInMS(const uint32 TimeInMS, const FOnCheckpointReadyDelegate& Delegate)
+{
+	// last checkpoint at or before requested time
+	int32 CheckpointIndex = INDEX_NONE;
+	for (int32 i = 0; i < CheckpointChunks.Num() && CheckpointChunks[i].TimeInMS <= TimeInMS; i++)
+	{
+		CheckpointIndex = CheckpointChunks[i].CheckpointIndex;
+	}
+
+	GotoCheckpointIndex(CheckpointIndex, Delegate);
+}
+
+void FShooterReplayStreamer::UpdateTotalDemoTime(uint32 TimeInMS)
+{
+	TotalTimeInMS = TimeInMS;
+}
+
+bool FShooterReplayStreamer::IsDataAvailable() const
+{
+	return bRecording || (StreamReader.IsValid() && StreamReader->Tell() < StreamReader->TotalSize());
+}
+
+void FShooterReplayStreamer::DeleteFinishedStream(const FString& InStreamName, const FOnDeleteFinishedStreamComplete& Delegate) const
+{
+	Delegate.ExecuteIfBound(IFileManager::Get().Delete(*GetDemoFileName(InStreamName)));
+}
+
+void FShooterReplayStreamer::EnumerateStreams(const FString& VersionString, const FString& UserString, const FString& MetaString, const FOnEnumerateStreamsComplete& Delegate)
+{
+	const FString DemoDir = FPaths::GameSavedDir() + TEXT("Demos/");
+
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *(DemoDir + TEXT("*.demo")), true, false);
+
+	TArray<FNetworkReplayStreamInfo> Streams;
+	for (int32 i = 0; i < FileNames.Num(); i++)
+	{
+		FNetworkReplayStreamInfo& Info = Streams[Streams.AddDefaulted()];
+		Info.Name = FPaths::GetBaseFilename(FileNames[i]);
+		Info.Timestamp = IFileManager::Get().GetTimeStamp(*(DemoDir + FileNames[i]));
+		Info.SizeInBytes = IFileManager::Get().FileSize(*(DemoDir + FileNames[i]));
+	}
+
+	Delegate.ExecuteIfBound(Streams);
+}
+
+void FShooterDemoFileWriter::LogStats(const FJob& FinalizeJob) const
+{
+	const double CompressionRatio = CompressedBytes > 0 ? (double)RawBytes / CompressedBytes : 0.0;
+
+	UE_LOG(LogShooterReplay, Log, TEXT("Demo %s: %lld bytes compressed to %lld (%.2f:1), worker %.1f ms, %d checkpoints, max checkpoint stall %.2f ms, total stall %.2f ms"),
+		*FPaths::GetBaseFilename(FileName), RawBytes, CompressedBytes, CompressionRatio, WorkerSeconds * 1000.0,
+		FinalizeJob.NumCheckpoints, FinalizeJob.MaxCheckpointStall * 1000.0, FinalizeJob.TotalStall * 1000.0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FShooterReplayStreamingFactory
+
+TSharedPtr<INetworkReplayStreamer> FShooterReplayStreamingFactory::CreateReplayStreamer()
+{
+	return TSharedPtr<INetworkReplayStreamer>(new FShooterReplayStreamer());
+}
+
+IMPLEMENT_MODULE(FShooterReplayStreamingFactory, ShooterReplayStreaming);
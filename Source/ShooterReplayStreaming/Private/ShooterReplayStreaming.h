@@ -0,0 +1,330 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#ifndef __SHOOTERREPLAYSTREAMING_H__
+#define __SHOOTERREPLAYSTREAMING_H__
+
+#include "Core.h"
+#include "NetworkReplayStreaming.h"
+
+DECLARE_STATS_GROUP(TEXT("ShooterReplay"), STATGROUP_ShooterReplay, STATCAT_Advanced);
+
+/**
+ * Demo file layout:
+ *
+ *   FShooterDemoFileHeader
+ *   compressed chunks, in the order the worker finished them
+ *   chunk table (FShooterDemoChunk array), pointed to by the file header
+ *
+ * Header, stream and checkpoint data are split into chunks of at most ChunkSize uncompressed bytes,
+ * compressed independently, so any position of the stream can be read by decompressing a single chunk.
+ * Chunks that don't compress are stored as is, so the chunk offsets of a kind never have gaps.
+ */
+namespace EShooterDemoChunk
+{
+	enum Type
+	{
+		Header,
+		Stream,
+		Checkpoint,
+	};
+}
+
+struct FShooterDemoFileHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	int32 ChunkSize;
+	uint32 TotalTimeInMS;
+	int64 TableOffset;
+	int32 NumChunks;
+
+	FShooterDemoFileHeader()
+		: Magic(0)
+		, Version(0)
+		, ChunkSize(0)
+		, TotalTimeInMS(0)
+		, TableOffset(0)
+		, NumChunks(0)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FShooterDemoFileHeader& Header)
+	{
+		return Ar << Header.Magic << Header.Version << Header.ChunkSize << Header.TotalTimeInMS << Header.TableOffset << Header.NumChunks;
+	}
+
+	static const uint32 ExpectedMagic;
+	static const uint32 ExpectedVersion;
+
+	/** serialized size, the header is patched in place when recording finishes */
+	static const int64 SerializedSize = 28;
+};
+
+struct FShooterDemoChunk
+{
+	/** EShooterDemoChunk */
+	uint8 Kind;
+
+	/** checkpoint the chunk belongs to */
+	int32 CheckpointIndex;
+
+	/** demo time of the checkpoint */
+	uint32 TimeInMS;
+
+	/** for checkpoints, stream position playback resumes from. Otherwise uncompressed offset of the chunk in its data */
+	int64 DataOffset;
+
+	/** offset of compressed data in file */
+	int64 FileOffset;
+
+	int32 UncompressedSize;
+
+	/** equal to UncompressedSize for chunks stored without compression, compressed chunks are always smaller */
+	int32 CompressedSize;
+
+	/** was the chunk written without compression? */
+	bool IsStored() const { return CompressedSize == UncompressedSize; }
+
+	FShooterDemoChunk()
+		: Kind(EShooterDemoChunk::Stream)
+		, CheckpointIndex(INDEX_NONE)
+		, TimeInMS(0)
+		, DataOffset(0)
+		, FileOffset(0)
+		, UncompressedSize(0)
+		, CompressedSize(0)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FShooterDemoChunk& Chunk)
+	{
+		return Ar << Chunk.Kind << Chunk.CheckpointIndex << Chunk.TimeInMS << Chunk.DataOffset << Chunk.FileOffset << Chunk.UncompressedSize << Chunk.CompressedSize;
+	}
+};
+
+/**
+ * Compresses and writes demo data on a worker thread.
+ *
+ * The game thread fills one buffer while the worker compresses and writes the previous one. It only
+ * waits when it submits data faster than the worker can keep up, that wait is reported as stall time.
+ */
+class FShooterDemoFileWriter : public FRunnable
+{
+public:
+
+	FShooterDemoFileWriter(const FString& InFileName, int32 InChunkSize);
+	virtual ~FShooterDemoFileWriter();
+
+	/**
+	 * [game thread] Hand data to the worker, waits if the worker is still busy with the previous buffers.
+	 *
+	 * @returns seconds spent waiting
+	 */
+	double Submit(EShooterDemoChunk::Type Kind, TArray<uint8>& Data, int32 CheckpointIndex = INDEX_NONE, uint32 TimeInMS = 0, int64 StreamOffset = 0);
+
+	/**
+	 * [game thread] Write chunk table and close file once all data is written, doesn't wait.
+	 * Stats are logged when the file is closed, together with game thread stats passed in.
+	 *
+	 * @param TotalTimeInMS			Length of the demo.
+	 * @param NumCheckpoints		Checkpoints recorded.
+	 * @param MaxCheckpointStall	Longest time the game thread spent flushing a checkpoint (seconds).
+	 * @param TotalStall			Time the game thread spent handing data to the writer (seconds).
+	 */
+	void Finalize(uint32 TotalTimeInMS, int32 NumCheckpoints, double MaxCheckpointStall, double TotalStall);
+
+	/** has the file been closed? */
+	bool IsDone() const { return DoneCounter.GetValue() != 0; }
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+
+	struct FJob
+	{
+		EShooterDemoChunk::Type Kind;
+		TArray<uint8> Data;
+		int32 CheckpointIndex;
+		uint32 TimeInMS;
+		int64 StreamOffset;
+		bool bFinalize;
+
+		/** game thread stats, for the finalize job */
+		int32 NumCheckpoints;
+		double MaxCheckpointStall;
+		double TotalStall;
+	};
+
+	/** compress job data and append chunks to file */
+	void Process(FJob& Job);
+
+	/** write chunk table and patch file header */
+	void WriteTable(uint32 TotalTimeInMS);
+
+	/** log compression and stall stats of the recording */
+	void LogStats(const FJob& FinalizeJob) const;
+
+	FString FileName;
+	int32 ChunkSize;
+
+	FRunnableThread* Thread;
+
+	/** jobs, produced by game thread and consumed by worker */
+	TQueue<FJob*, EQueueMode::Spsc> Jobs;
+
+	/** signaled when a job is queued */
+	FEvent* JobEvent;
+
+	/** signaled when the worker finished a job */
+	FEvent* SlotEvent;
+
+	/** jobs queued and not finished */
+	FThreadSafeCounter NumJobsInFlight;
+
+	FThreadSafeCounter StopCounter;
+	FThreadSafeCounter DoneCounter;
+
+	/** set once Finalize has been called */
+	bool bFinalizeQueued;
+
+	/** [worker] */
+	IFileHandle* File;
+	TArray<FShooterDemoChunk> Table;
+	TArray<uint8> CompressedBuffer;
+	int64 HeaderBytes;
+	int64 StreamBytes;
+	int64 RawBytes;
+	int64 CompressedBytes;
+	double WorkerSeconds;
+};
+
+/** stream archive used while recording, hands full chunks to the writer */
+class FShooterDemoStreamWriter : public FArchive
+{
+public:
+
+	FShooterDemoStreamWriter(class FShooterReplayStreamer& InStreamer, int32 InChunkSize);
+
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual int64 Tell() override { return Position; }
+	virtual int64 TotalSize() override { return Position; }
+
+	/** submit data collected so far */
+	virtual void Flush() override;
+
+private:
+
+	class FShooterReplayStreamer& Streamer;
+	int32 ChunkSize;
+	TArray<uint8> Buffer;
+	int64 Position;
+};
+
+/** stream archive used for playback, decompresses the chunk containing the current position */
+class FShooterDemoStreamReader : public FArchive
+{
+public:
+
+	FShooterDemoStreamReader(IFileHandle* InFile, const TArray<FShooterDemoChunk>& InChunks, int64 InTotalSize);
+
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual void Seek(int64 InPos) override { Position = FMath::Clamp<int64>(InPos, 0, StreamSize); }
+	virtual int64 Tell() override { return Position; }
+	virtual int64 TotalSize() override { return StreamSize; }
+
+	/** decompress chunk into buffer, returns false on read error */
+	static bool ReadChunk(IFileHandle* File, const FShooterDemoChunk& Chunk, TArray<uint8>& OutData);
+
+private:
+
+	/** make the chunk containing Position current */
+	bool LoadChunkAt(int64 Pos);
+
+	IFileHandle* File;
+
+	/** stream chunks, ordered by offset */
+	TArray<FShooterDemoChunk> Chunks;
+
+	int64 StreamSize;
+	int64 Position;
+
+	/** decompressed data of current chunk */
+	TArray<uint8> ChunkData;
+	int32 CurrentChunk;
+};
+
+/** Replay streamer writing chunk compressed demos to Saved/Demos. */
+class FShooterReplayStreamer : public INetworkReplayStreamer
+{
+public:
+
+	FShooterReplayStreamer();
+	virtual ~FShooterReplayStreamer();
+
+	// Begin INetworkReplayStreamer interface
+	virtual void StartStreaming(const FString& StreamName, bool bRecord, const FString& VersionString, const FOnStreamReadyDelegate& Delegate) override;
+	virtual void StopStreaming() override;
+	virtual FArchive* GetHeaderArchive() override;
+	virtual FArchive* GetStreamingArchive() override;
+	virtual FArchive* GetCheckpointArchive() override;
+	virtual void FlushCheckpoint(const uint32 TimeInMS) override;
+	virtual void GotoCheckpointIndex(const int32 CheckpointIndex, const FOnCheckpointReadyDelegate& Delegate) override;
+	virtual void GotoTimeInMS(const uint32 TimeInMS, const FOnCheckpointReadyDelegate& Delegate) override;
+	virtual void UpdateTotalDemoTime(uint32 TimeInMS) override;
+	virtual uint32 GetTotalDemoTime() const override { return TotalTimeInMS; }
+	virtual bool IsDataAvailable() const override;
+	virtual void SetHighPriorityTimeRange(const uint32 StartTimeInMS, const uint32 EndTimeInMS) override {}
+	virtual bool IsDataAvailableForTimeRange(const uint32 StartTimeInMS, const uint32 EndTimeInMS) override { return true; }
+	virtual bool IsLoadingCheckpoint() const override { return false; }
+	virtual bool IsLive(const FString& StreamName) const override { return false; }
+	virtual void DeleteFinishedStream(const FString& StreamName, const FOnDeleteFinishedStreamComplete& Delegate) const override;
+	virtual void EnumerateStreams(const FString& VersionString, const FString& UserString, const FString& MetaString, const FOnEnumerateStreamsComplete& Delegate) override;
+	virtual ENetworkReplayError::Type GetLastError() const override { return ENetworkReplayError::None; }
+	// End INetworkReplayStreamer interface
+
+	/** [recording] hand stream data to the writer */
+	void SubmitStream(TArray<uint8>& Data);
+
+	/** file name of demo */
+	static FString GetDemoFileName(const FString& StreamName);
+
+private:
+
+	/** read file header and chunk table for playback */
+	bool OpenForPlayback(const FString& FileName);
+
+	FString StreamName;
+
+	/** [recording] */
+	TSharedPtr<FShooterDemoFileWriter> Writer;
+	TSharedPtr<FShooterDemoStreamWriter> StreamWriter;
+	FArrayWriter HeaderWriter;
+	FArrayWriter CheckpointWriter;
+	bool bHeaderSubmitted;
+	int32 NumCheckpoints;
+	double MaxCheckpointStall;
+	double TotalStall;
+
+	/** [playback] */
+	IFileHandle* ReadFile;
+	TSharedPtr<FShooterDemoStreamReader> StreamReader;
+	FArrayReader HeaderReader;
+	FArrayReader CheckpointReader;
+
+	/** [playback] checkpoint chunks, ordered by checkpoint index */
+	TArray<FShooterDemoChunk> CheckpointChunks;
+
+	uint32 TotalTimeInMS;
+	bool bRecording;
+};
+
+class FShooterReplayStreamingFactory : public INetworkReplayStreamingFactory
+{
+public:
+	virtual TSharedPtr<INetworkReplayStreamer> CreateReplayStreamer() override;
+};
+
+#endif // __SHOOTERREPLAYSTREAMING_H__
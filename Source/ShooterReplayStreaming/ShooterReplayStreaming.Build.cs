@@ -0,0 +1,20 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Selected as replay streamer with DefaultFactoryName=ShooterReplayStreaming in the [NetworkReplayStreaming] section of DefaultEngine.ini
+
+public class ShooterReplayStreaming : ModuleRules
+{
+    public ShooterReplayStreaming(TargetInfo Target)
+	{
+		PrivateIncludePaths.Add("../../ShooterGame/Source/ShooterReplayStreaming/Private");
+
+        PrivateDependencyModuleNames.AddRange(
+			new string[] {
+				"Core",
+				"NetworkReplayStreaming"
+			}
+		);
+	}
+}